@@ -0,0 +1,586 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "goc_error.h"
+#include "goc_lexer.h"
+#include "goc_lexer_dump.h"
+#include "goc_lexer_inline.h"
+#include "goc_parser.h"
+#include "goc_parser_flat.h"
+
+// Lexer and parser throughput benchmark: make all DEBUG=-O2 && make bench
+// make bench_checks builds goc_bench_{off,cheap,paranoid}, one per GOC_CHECK_LEVEL, to time what the checks cost
+// usage: goc_bench [-n iterations] [-i MB] [-p MB] [file.go...]
+// -i lexes a generated, identifier-heavy source of the given size (keyword classification and interning)
+// -p lexes once and then parses a generated `package main` source of the given size, made of functions, unions
+// and enums in the grammar of test/func.go, the parse row counting source lines per second, followed by the
+// AST arena statistics of one parse. The flatten row times building the flat AST from the parsed one, the walk row
+// counts the binary expressions of the tree by recursion and the scan row those of the flat AST from its pool.
+// The par-N parse rows time goc_parser_parallel on N threads, after checking it dumps the same AST as goc_parser
+// The lazy row times goc_parser_lazy, which skips the function bodies, and the expand row parsing them all afterwards
+// Each input is also lexed by the SIMD engine for every instruction set, after checking it emits the same tokens
+// The dump rows time writing the tokens of one lexing to /dev/null, to_str being the per token formatting baseline
+// The get / inline / cursor rows time reading every token's type, length and symbol through the out-of-line
+// getters, the goc_lexer_inline.h accessors and a TokenCursor
+
+#define BENCH_ITERATIONS_INIT 10
+#define BENCH_MB              (1024.0 * 1024.0)
+#define BENCH_IDENT_WORDS     64
+
+static double bench_now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static char *bench_read_file(const char *file_name, size_t *s_data) {
+  FILE *file = fopen(file_name, "rb");
+  if (file == NULL)
+    return NULL;
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  char *data = size > 0 ? (char *)malloc((size_t)size) : NULL;
+  if (data == NULL || fread(data, 1, (size_t)size, file) != (size_t)size) {
+    free(data);
+    fclose(file);
+    return NULL;
+  }
+  fclose(file);
+  *s_data = (size_t)size;
+  return data;
+}
+
+// Mostly plain identifiers, some of them keyword prefixes or of keyword length, with a keyword every 8 words
+static char *bench_ident_source(size_t s_data) {
+  static const char *words[] = {
+    "x", "idx", "count", "inter", "int", "value", "for", "buffer", "int3", "structure", "format", "returned",
+    "i", "uintx", "func", "node", "elsewhere", "case", "n_tokens", "stringify", "doubled", "var", "ifx", "range"
+  };
+  const size_t s_words = sizeof(words) / sizeof(*words);
+
+  char *data = (char *)malloc(s_data + 1);
+  goc_error_assert(goc_error_mem_error, data != NULL);
+  size_t cursor = 0;
+  uint64_t seed = 0x9E3779B97F4A7C15ull;
+  for (size_t word = 0; ; word++) {
+    seed ^= seed << 13, seed ^= seed >> 7, seed ^= seed << 17;
+    const char *text = words[seed % s_words];
+    size_t s_text = strlen(text);
+    if (cursor + s_text + 1 > s_data)
+      break;
+    memcpy(data + cursor, text, s_text);
+    cursor += s_text;
+    data[cursor++] = (word + 1) % BENCH_IDENT_WORDS ? ' ' : '\n';
+  }
+  memset(data + cursor, ' ', s_data - cursor);
+  return data;
+}
+
+// One union, one enum and BENCH_PARSE_FUNCS functions per block, every name suffixed by the block number
+static char *bench_go_source(size_t s_data, size_t *s_source) {
+  static const char *header = "package main\n\n";
+  static const char *block =
+    "union value%zu {\n  var i: int64,\n  var f: double,\n  var p: *int32\n}\n\n"
+    "enum state%zu { idle = iota, running, done = 1 << 4 }\n\n"
+    "func sum%zu(a: int, b: int) -> int {\n  return a + b * 2 - (a & b)\n}\n\n"
+    "func scan%zu(items: []int32, count: uint32) -> (int, bool) {\n"
+    "  var total: int = 0\n"
+    "  found := false\n"
+    "  for i := 0; i < count; i++ {\n"
+    "    x := items[i] ^ total\n"
+    "    if x > 10 && !found {\n"
+    "      total += sum%zu(x, i) << 1\n"
+    "    } else if x == 0 || found {\n"
+    "      found = true\n"
+    "    } else {\n"
+    "      total -= x % 7\n"
+    "    }\n"
+    "  }\n"
+    "  for _, item := range items {\n"
+    "    println(\"item\", item, .5 * total)\n"
+    "  }\n"
+    "  return total, found\n"
+    "}\n\n";
+
+  char *data = (char *)malloc(s_data + 1);
+  goc_error_assert(goc_error_mem_error, data != NULL);
+  size_t cursor = (size_t)snprintf(data, s_data + 1, "%s", header);
+  for (size_t n = 0; ; n++) {
+    int s_block = snprintf(data + cursor, s_data + 1 - cursor, block, n, n, n, n, n);
+    if (s_block < 0 || cursor + (size_t)s_block > s_data)
+      break;
+    cursor += (size_t)s_block;
+  }
+  *s_source = cursor;
+  return data;
+}
+
+static void bench_report(const char *label, size_t s_data, size_t s_tokens, uint32_t iterations, double elapsed) {
+  double mb = (double)s_data * iterations / BENCH_MB;
+  fprintf(
+    stdout, "  %-8s %10zu tokens  %8.3f ms/iter  %8.2f MB/s\n",
+    label, s_tokens, elapsed * 1e3 / iterations, mb / elapsed
+  );
+}
+
+// Index of the first token where the two arrays differ, the common size if they are identical
+static size_t bench_compare(TokenArray expected, TokenArray actual) {
+  size_t s_tokens = goc_lexer_token_array_get_size(expected),
+         index = 0;
+  for (; index < s_tokens && index < goc_lexer_token_array_get_size(actual); index++) {
+    Token a = goc_lexer_token_array_at(expected, index),
+          b = goc_lexer_token_array_at(actual, index);
+    if (
+      goc_lexer_token_get_token_type(a) != goc_lexer_token_get_token_type(b) ||
+      goc_lexer_token_get_pos_abs(a) != goc_lexer_token_get_pos_abs(b) ||
+      goc_lexer_token_get_pos_s_word(a) != goc_lexer_token_get_pos_s_word(b) ||
+      goc_lexer_token_get_symbol(a) != goc_lexer_token_get_symbol(b) ||
+      goc_lexer_token_get_value_number_literal(a) != goc_lexer_token_get_value_number_literal(b) ||
+      goc_lexer_token_get_value_real_literal(a) != goc_lexer_token_get_value_real_literal(b)
+    )
+      break;
+  }
+  return index;
+}
+
+static void bench_buffer(const char *label, const char *data, size_t s_data, uint32_t iterations) {
+  size_t s_tokens = 0;
+  double start = bench_now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    TokenArray tokens = goc_lexer_from_buffer(data, s_data);
+    s_tokens = goc_lexer_token_array_get_size(tokens);
+    goc_lexer_token_array_free(tokens);
+  }
+  bench_report(label, s_data, s_tokens, iterations, bench_now() - start);
+}
+
+// Times the SIMD engine for every instruction set, checking its tokens against goc_lexer_from_buffer
+static void bench_simd(const char *data, size_t s_data, uint32_t iterations) {
+  static const struct { const char *label; LexerSimdIsa isa; } engines[] = {
+    { "scalar", LEXER_SIMD_SCALAR }, { "sse2", LEXER_SIMD_SSE2 }, { "avx2", LEXER_SIMD_AVX2 }
+  };
+
+  TokenArray expected = goc_lexer_from_buffer(data, s_data);
+  for (size_t engine = 0; engine < sizeof(engines) / sizeof(*engines); engine++) {
+    TokenArray actual = goc_lexer_simd_from_buffer(data, s_data, engines[engine].isa);
+    size_t s_tokens = goc_lexer_token_array_get_size(actual),
+           index = bench_compare(expected, actual);
+    goc_lexer_token_array_free(actual);
+    if (index != goc_lexer_token_array_get_size(expected) || index != s_tokens) {
+      fprintf(stdout, "  %-8s tokens differ from goc_lexer at token %zu\n", engines[engine].label, index);
+      continue;
+    }
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+      TokenArray tokens = goc_lexer_simd_from_buffer(data, s_data, engines[engine].isa);
+      goc_lexer_token_array_free(tokens);
+    }
+    bench_report(engines[engine].label, s_data, s_tokens, iterations, bench_now() - start);
+  }
+  goc_lexer_token_array_free(expected);
+}
+
+static void bench_parallel(const char *data, size_t s_data, uint32_t iterations) {
+  static const uint32_t threads[] = { 1, 2, 4, 8 };
+
+  TokenArray expected = goc_lexer_from_buffer(data, s_data);
+  for (size_t thread = 0; thread < sizeof(threads) / sizeof(*threads); thread++) {
+    char label[16];
+    snprintf(label, sizeof(label), "par-%u", threads[thread]);
+
+    TokenArray actual = goc_lexer_parallel_from_buffer(data, s_data, threads[thread]);
+    size_t s_tokens = goc_lexer_token_array_get_size(actual),
+           index = bench_compare(expected, actual);
+    goc_lexer_token_array_free(actual);
+    if (index != goc_lexer_token_array_get_size(expected) || index != s_tokens) {
+      fprintf(stdout, "  %-8s tokens differ from goc_lexer at token %zu\n", label, index);
+      continue;
+    }
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+      TokenArray tokens = goc_lexer_parallel_from_buffer(data, s_data, threads[thread]);
+      goc_lexer_token_array_free(tokens);
+    }
+    bench_report(label, s_data, s_tokens, iterations, bench_now() - start);
+  }
+  goc_lexer_token_array_free(expected);
+}
+
+static void bench_dump(const char *data, size_t s_data, uint32_t iterations) {
+  static const struct { const char *label; LexerDumpFormat format; } formats[] = {
+    { "text", LEXER_DUMP_TEXT }, { "ndjson", LEXER_DUMP_NDJSON }, { "binary", LEXER_DUMP_BINARY }
+  };
+
+  int fd = open("/dev/null", O_WRONLY);
+  FILE *file = fdopen(fd, "w");
+  goc_error_assert(goc_error_ioerror, fd != -1 && file != NULL);
+  TokenArray tokens = goc_lexer_from_buffer(data, s_data);
+  size_t s_tokens = goc_lexer_token_array_get_size(tokens);
+
+  double start = bench_now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (size_t index = 0; index < s_tokens; index++) {
+      char *token_str = (char *)goc_lexer_token_to_str(goc_lexer_token_array_at(tokens, index));
+      fprintf(file, "%s\n", token_str);
+      free(token_str);
+    }
+    fflush(file);
+  }
+  bench_report("to_str", s_data, s_tokens, iterations, bench_now() - start);
+
+  for (size_t format = 0; format < sizeof(formats) / sizeof(*formats); format++) {
+    start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+      LexerDump dump = goc_lexer_dump_create(fd, formats[format].format);
+      goc_lexer_dump_tokens(dump, tokens);
+      goc_lexer_dump_free(dump);
+    }
+    bench_report(formats[format].label, s_data, s_tokens, iterations, bench_now() - start);
+  }
+
+  goc_lexer_token_array_free(tokens);
+  fclose(file);
+}
+
+// Binary expressions of the tree, by recursion over its pointers
+static size_t bench_walk_expr(AST_NodeExpr expr) {
+  if (expr == NULL)
+    return 0;
+  switch (expr->type_expr) {
+    case ast_node_expr_member:
+      return bench_walk_expr(expr->expr.expr_member.object);
+    case ast_node_expr_index:
+      return bench_walk_expr(expr->expr.expr_index.object) + bench_walk_expr(expr->expr.expr_index.index);
+    case ast_node_expr_call: {
+      size_t s_bin = bench_walk_expr(expr->expr.expr_call.callee);
+      for (uint32_t arg = 0; arg < expr->expr.expr_call.s_args; arg++)
+        s_bin += bench_walk_expr(expr->expr.expr_call.args[arg]);
+      return s_bin;
+    }
+    case ast_node_expr_unary:
+      return bench_walk_expr(expr->expr.expr_unary.operand);
+    case ast_node_expr_bin:
+      return 1 + bench_walk_expr(expr->expr.expr_bin.expr_left) + bench_walk_expr(expr->expr.expr_bin.expr_right);
+    default:
+      return 0;
+  }
+}
+
+static size_t bench_walk_block(AST_NodeStmtBlock block);
+
+static size_t bench_walk_stmt(AST_NodeStmt stmt) {
+  if (stmt == NULL)
+    return 0;
+  size_t s_bin = 0;
+  switch (stmt->type_stmt) {
+    case ast_node_stmt_expr:
+      return bench_walk_expr(stmt->stmt.expr);
+    case ast_node_var:
+      return bench_walk_expr(stmt->stmt.var.value);
+    case ast_node_stmt_assign:
+      return bench_walk_expr(stmt->stmt.stmt_assign.target) + bench_walk_expr(stmt->stmt.stmt_assign.expr);
+    case ast_node_stmt_return:
+      for (uint32_t expr = 0; expr < stmt->stmt.stmt_return.s_exprs; expr++)
+        s_bin += bench_walk_expr(stmt->stmt.stmt_return.exprs[expr]);
+      return s_bin;
+    case ast_node_stmt_if:
+      for (AST_NodeStmtIf stmt_if = stmt->stmt.stmt_if; stmt_if != NULL; stmt_if = stmt_if->elseif)
+        s_bin += bench_walk_stmt(stmt_if->init) + bench_walk_expr(stmt_if->condition)
+               + bench_walk_block(stmt_if->if_block) + bench_walk_block(stmt_if->else_block);
+      return s_bin;
+    case ast_node_stmt_while:
+      return bench_walk_expr(stmt->stmt.stmt_while.condition) + bench_walk_block(stmt->stmt.stmt_while.block);
+    case ast_node_stmt_for:
+      return bench_walk_stmt(stmt->stmt.stmt_for.init) + bench_walk_expr(stmt->stmt.stmt_for.condition)
+           + bench_walk_stmt(stmt->stmt.stmt_for.update) + bench_walk_expr(stmt->stmt.stmt_for.range)
+           + bench_walk_block(stmt->stmt.stmt_for.block);
+    case ast_node_stmt_block:
+      return bench_walk_block(stmt->stmt.stmt_block);
+    default:
+      return 0;
+  }
+}
+
+static size_t bench_walk_block(AST_NodeStmtBlock block) {
+  size_t s_bin = 0;
+  for (uint32_t stmt = 0; block != NULL && stmt < block->s_stmts; stmt++)
+    s_bin += bench_walk_stmt(&(block->stmts[stmt]));
+  return s_bin;
+}
+
+static size_t bench_walk_tree(AST_NodeProgram program) {
+  AST_NodeFile file = program->packages->files;
+  size_t s_bin = 0;
+  for (uint32_t block = 0; block < file->s_file_blocks; block++) {
+    union ast_node_file_block node = file->file_blocks[block];
+    switch (file->type_file_blocks[block]) {
+      case ast_node_func:
+        s_bin += bench_walk_block(goc_parser_func_block(program, node.func));
+        break;
+      case ast_node_method:
+        s_bin += bench_walk_block(goc_parser_func_block(program, node.method->func));
+        break;
+      case ast_node_var:
+        s_bin += bench_walk_expr(node.var->value);
+        break;
+      case ast_node_enum:
+        for (uint32_t value = 0; value < node.node_enum->s_values; value++)
+          s_bin += bench_walk_expr(node.node_enum->assign[value]);
+        break;
+      default:
+        break;
+    }
+  }
+  return s_bin;
+}
+
+// Binary expressions of the flat AST, by a scan of its expression pool
+static size_t bench_walk_flat(AST_Flat flat) {
+  size_t s_bin = 0;
+  for (uint32_t expr = 0; expr < flat->s_pools[AST_FLAT_EXPR]; expr++)
+    s_bin += flat->pools[AST_FLAT_EXPR][expr].kind == ast_node_expr_bin;
+  return s_bin;
+}
+
+static void bench_parse(const char *data, size_t s_data, uint32_t iterations) {
+  TokenArray tokens = goc_lexer_from_buffer(data, s_data);
+  size_t s_tokens = goc_lexer_token_array_get_size(tokens),
+         s_lines = 0;
+  for (size_t pos = 0; pos < s_data; pos++)
+    s_lines += data[pos] == '\n';
+
+  double start = bench_now();
+  for (uint32_t i = 0; i < iterations; i++)
+    goc_parser_free(goc_parser(tokens));
+  double elapsed = bench_now() - start;
+  bench_report("parse", s_data, s_tokens, iterations, elapsed);
+  fprintf(stdout, "  %-8s %10zu lines   %8.2f Mlines/s\n", "", s_lines, (double)s_lines * iterations / elapsed / 1e6);
+
+  AST_NodeProgram program = goc_parser(tokens);
+  goc_parser_print_stats(stdout, program);
+
+  start = bench_now();
+  for (uint32_t i = 0; i < iterations; i++)
+    goc_parser_flat_free(goc_parser_flatten(program));
+  bench_report("flatten", s_data, s_tokens, iterations, bench_now() - start);
+  AST_Flat flat = goc_parser_flatten(program);
+  fprintf(
+    stdout, "  %-8s %10zu bytes   %8zu tree bytes\n", "", goc_parser_flat_get_size(flat), goc_arena_get_size(program->arena)
+  );
+
+  size_t s_tree = 0,
+         s_flat = 0;
+  start = bench_now();
+  for (uint32_t i = 0; i < iterations; i++)
+    s_tree += bench_walk_tree(program);
+  bench_report("walk", s_data, s_tokens, iterations, bench_now() - start);
+  start = bench_now();
+  for (uint32_t i = 0; i < iterations; i++)
+    s_flat += bench_walk_flat(flat);
+  bench_report("scan", s_data, s_tokens, iterations, bench_now() - start);
+  goc_error_assert(goc_error_inval_arg, s_tree == s_flat);
+
+  goc_parser_flat_free(flat);
+  goc_parser_free(program);
+  goc_lexer_token_array_free(tokens);
+}
+
+// Text of goc_parser_dump, to free
+static char *bench_parse_dump(AST_NodeProgram program, size_t *s_dump) {
+  char *dump = NULL;
+  FILE *out = open_memstream(&dump, s_dump);
+  goc_error_assert(goc_error_mem_error, out != NULL);
+  goc_parser_dump(out, program);
+  fclose(out);
+  return dump;
+}
+
+static void bench_parse_parallel(const char *data, size_t s_data, uint32_t iterations) {
+  static const uint32_t threads[] = { 1, 2, 4, 8 };
+
+  TokenArray tokens = goc_lexer_from_buffer(data, s_data);
+  size_t s_tokens = goc_lexer_token_array_get_size(tokens),
+         s_expected;
+  AST_NodeProgram program = goc_parser(tokens);
+  char *expected = bench_parse_dump(program, &s_expected);
+  goc_parser_free(program);
+
+  for (size_t thread = 0; thread < sizeof(threads) / sizeof(*threads); thread++) {
+    char label[16];
+    snprintf(label, sizeof(label), "par-%u", threads[thread]);
+
+    size_t s_actual;
+    program = goc_parser_parallel(tokens, threads[thread]);
+    char *actual = bench_parse_dump(program, &s_actual);
+    goc_parser_free(program);
+    bool same = s_actual == s_expected && memcmp(actual, expected, s_expected) == 0;
+    free(actual);
+    if (!same) {
+      fprintf(stdout, "  %-8s AST differs from goc_parser\n", label);
+      continue;
+    }
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++)
+      goc_parser_free(goc_parser_parallel(tokens, threads[thread]));
+    bench_report(label, s_data, s_tokens, iterations, bench_now() - start);
+  }
+  free(expected);
+  goc_lexer_token_array_free(tokens);
+}
+
+static void bench_parse_lazy(const char *data, size_t s_data, uint32_t iterations) {
+  TokenArray tokens = goc_lexer_from_buffer(data, s_data);
+  size_t s_tokens = goc_lexer_token_array_get_size(tokens),
+         s_expected,
+         s_actual;
+  AST_NodeProgram program = goc_parser(tokens);
+  char *expected = bench_parse_dump(program, &s_expected);
+  goc_parser_free(program);
+  program = goc_parser_lazy(tokens);
+  char *actual = bench_parse_dump(program, &s_actual);
+  goc_parser_free(program);
+  bool same = s_actual == s_expected && memcmp(actual, expected, s_expected) == 0;
+  free(actual);
+  free(expected);
+  if (!same) {
+    fprintf(stdout, "  %-8s AST differs from goc_parser\n", "lazy");
+    goc_lexer_token_array_free(tokens);
+    return;
+  }
+
+  double lazy = 0,
+         expand = 0;
+  for (uint32_t i = 0; i < iterations; i++) {
+    double start = bench_now();
+    program = goc_parser_lazy(tokens);
+    double parsed = bench_now();
+    goc_parser_expand(program);
+    expand += bench_now() - parsed;
+    lazy += parsed - start;
+    goc_parser_free(program);
+  }
+  bench_report("lazy", s_data, s_tokens, iterations, lazy);
+  bench_report("expand", s_data, s_tokens, iterations, expand);
+  goc_lexer_token_array_free(tokens);
+}
+
+static void bench_access(const char *data, size_t s_data, uint32_t iterations) {
+  TokenArray tokens = goc_lexer_from_buffer(data, s_data);
+  size_t s_tokens = goc_lexer_token_array_get_size(tokens);
+  volatile size_t sink = 0;
+
+  double start = bench_now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    size_t sum = 0;
+    for (size_t index = 0; index < s_tokens; index++) {
+      Token token = goc_lexer_token_array_at(tokens, index);
+      sum += goc_lexer_token_get_token_type(token) + goc_lexer_token_get_pos_s_word(token) + goc_lexer_token_get_symbol(token);
+    }
+    sink += sum;
+  }
+  bench_report("get", s_data, s_tokens, iterations, bench_now() - start);
+
+  start = bench_now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    size_t sum = 0;
+    for (size_t index = 0; index < s_tokens; index++) {
+      Token token = goc_lexer_inline_at(tokens, index);
+      sum += goc_lexer_inline_type(token) + goc_lexer_inline_s_word(token) + goc_lexer_inline_symbol(token);
+    }
+    sink += sum;
+  }
+  bench_report("inline", s_data, s_tokens, iterations, bench_now() - start);
+
+  start = bench_now();
+  for (uint32_t i = 0; i < iterations; i++) {
+    size_t sum = 0;
+    TokenCursor cursor = goc_lexer_cursor_create(tokens);
+    for (size_t index = 0; index < s_tokens; index++) {
+      Token token = goc_lexer_cursor_advance(&cursor);
+      sum += goc_lexer_inline_type(token) + goc_lexer_inline_s_word(token) + goc_lexer_inline_symbol(token);
+    }
+    sink += sum;
+  }
+  bench_report("cursor", s_data, s_tokens, iterations, bench_now() - start);
+
+  (void)sink;
+  goc_lexer_token_array_free(tokens);
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t iterations = BENCH_ITERATIONS_INIT;
+  size_t   s_ident = 0,
+           s_parse = 0;
+  int arg = 1;
+  for (; arg + 1 < argc && argv[arg][0] == '-'; arg += 2) {
+    if (strcmp(argv[arg], "-n") == 0)
+      iterations = (uint32_t)strtoul(argv[arg + 1], NULL, 10);
+    else if (strcmp(argv[arg], "-i") == 0)
+      s_ident = (size_t)(strtod(argv[arg + 1], NULL) * BENCH_MB);
+    else if (strcmp(argv[arg], "-p") == 0)
+      s_parse = (size_t)(strtod(argv[arg + 1], NULL) * BENCH_MB);
+    else
+      break;
+  }
+  goc_error_assert(goc_error_inval_arg, iterations > 0 && (arg < argc || s_ident > 0 || s_parse > 0));
+  static const char *check_levels[] = { "off", "cheap", "paranoid" };
+  fprintf(stdout, "GOC_CHECK_LEVEL %s\n", check_levels[GOC_CHECK_LEVEL]);
+
+  if (s_ident > 0) {
+    char *data = bench_ident_source(s_ident);
+    fprintf(stdout, "<identifiers> (%.2f MB, %u iterations)\n", s_ident / BENCH_MB, iterations);
+    bench_buffer("idents", data, s_ident, iterations);
+    bench_simd(data, s_ident, iterations);
+    bench_parallel(data, s_ident, iterations);
+    free(data);
+  }
+
+  if (s_parse > 0) {
+    size_t s_data = 0;
+    char *data = bench_go_source(s_parse, &s_data);
+    fprintf(stdout, "<program> (%.2f MB, %u iterations)\n", s_data / BENCH_MB, iterations);
+    bench_buffer("buffer", data, s_data, iterations);
+    bench_parse(data, s_data, iterations);
+    bench_parse_parallel(data, s_data, iterations);
+    bench_parse_lazy(data, s_data, iterations);
+    free(data);
+  }
+
+  for (; arg < argc; arg++) {
+    const char *file_name = argv[arg];
+    size_t s_data = 0;
+    char *data = bench_read_file(file_name, &s_data);
+    if (data == NULL) {
+      fprintf(stderr, "goc_bench: could not read %s\n", file_name);
+      continue;
+    }
+    fprintf(stdout, "%s (%.2f MB, %u iterations)\n", file_name, s_data / BENCH_MB, iterations);
+
+    size_t s_tokens = 0;
+    double start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+      TokenArray tokens = goc_lexer(file_name);
+      s_tokens = goc_lexer_token_array_get_size(tokens);
+      goc_lexer_token_array_free(tokens);
+    }
+    bench_report("file", s_data, s_tokens, iterations, bench_now() - start);
+
+    bench_buffer("buffer", data, s_data, iterations);
+    bench_simd(data, s_data, iterations);
+    bench_parallel(data, s_data, iterations);
+    bench_dump(data, s_data, iterations);
+    bench_access(data, s_data, iterations);
+
+    free(data);
+  }
+
+  return 0;
+}
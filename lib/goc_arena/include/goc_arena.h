@@ -0,0 +1,31 @@
+#ifndef GOC_ARENA_H
+#define GOC_ARENA_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Bump-pointer region allocator. Allocations live until the whole arena is reset or freed, chunks
+// are never moved so returned pointers stay valid.
+
+typedef struct arena *Arena;
+
+#define GOC_ARENA_ALIGN_DEFAULT (sizeof(max_align_t))
+
+Arena   goc_arena_create(size_t s_chunk);
+void   *goc_arena_alloc(Arena arena, size_t size, size_t align);
+char   *goc_arena_strndup(Arena arena, const char *text, size_t s_text);
+void    goc_arena_reset(Arena arena);
+void    goc_arena_free(Arena arena);
+// Takes over the chunks of other, which is freed: its allocations stay valid and now live as long as arena
+void    goc_arena_absorb(Arena arena, Arena other);
+
+size_t  goc_arena_get_size(Arena arena);
+size_t  goc_arena_get_reserved(Arena arena);
+
+#define goc_arena_new(arena, type)        ((type *)goc_arena_alloc((arena), sizeof(type), _Alignof(type)))
+#define goc_arena_new_n(arena, type, n)   ((type *)goc_arena_alloc((arena), (n) * sizeof(type), _Alignof(type)))
+
+#endif // !GOC_ARENA_H
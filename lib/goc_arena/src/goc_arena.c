@@ -0,0 +1,135 @@
+#include <string.h>
+
+#include "goc_arena.h"
+
+struct arena_chunk {
+  struct arena_chunk *next;
+  size_t              s_data,
+                      s_used;
+  max_align_t         data[];
+};
+
+struct arena {
+  struct arena_chunk *chunks;
+  size_t              s_chunk,
+                      s_used,
+                      s_reserved;
+};
+
+static const size_t arena_chunk_size_init = 64 * 1024;
+static const size_t arena_chunk_size_max  = 64 * 1024 * 1024;
+
+// =========================================================# PRIVATE #================================================================
+
+static struct arena_chunk *_goc_arena_chunk_create(size_t s_data) {
+  struct arena_chunk *chunk = (struct arena_chunk *)malloc(sizeof(struct arena_chunk) + s_data);
+  if (chunk == NULL)
+    return NULL;
+  chunk->next = NULL;
+  chunk->s_data = s_data;
+  chunk->s_used = 0;
+  return chunk;
+}
+
+// ==========================================================# PUBLIC #================================================================
+
+Arena goc_arena_create(size_t s_chunk) {
+  Arena arena = (Arena)calloc(1, sizeof(struct arena));
+  if (arena == NULL)
+    return NULL;
+  arena->s_chunk = s_chunk ? s_chunk : arena_chunk_size_init;
+  return arena;
+}
+
+void *goc_arena_alloc(Arena arena, size_t size, size_t align) {
+  if (arena == NULL || align == 0 || (align & (align - 1)) != 0)
+    return NULL;
+
+  struct arena_chunk *chunk = arena->chunks;
+  if (chunk != NULL) {
+    uintptr_t base = (uintptr_t)chunk->data,
+              ptr  = (base + chunk->s_used + (align - 1)) & ~(uintptr_t)(align - 1);
+    if (ptr + size <= base + chunk->s_data) {
+      arena->s_used += (ptr + size) - (base + chunk->s_used);
+      chunk->s_used = (ptr + size) - base;
+      return (void *)ptr;
+    }
+  }
+
+  // Chunks grow geometrically up to a cap, oversized requests get a chunk of their own
+  size_t s_data = arena->s_chunk;
+  if (s_data < size + align)
+    s_data = size + align;
+  struct arena_chunk *next = _goc_arena_chunk_create(s_data);
+  if (next == NULL)
+    return NULL;
+  next->next = chunk;
+  arena->chunks = next;
+  arena->s_reserved += s_data;
+  if (arena->s_chunk < arena_chunk_size_max)
+    arena->s_chunk *= 2;
+
+  uintptr_t base = (uintptr_t)next->data,
+            ptr  = (base + (align - 1)) & ~(uintptr_t)(align - 1);
+  next->s_used = (ptr + size) - base;
+  arena->s_used += next->s_used;
+  return (void *)ptr;
+}
+
+char *goc_arena_strndup(Arena arena, const char *text, size_t s_text) {
+  char *copy = (char *)goc_arena_alloc(arena, s_text + 1, 1);
+  if (copy == NULL)
+    return NULL;
+  memcpy(copy, text, s_text);
+  copy[s_text] = '\0';
+  return copy;
+}
+
+void goc_arena_reset(Arena arena) {
+  if (arena == NULL || arena->chunks == NULL)
+    return;
+  // Keep the most recent (largest) chunk around for reuse
+  struct arena_chunk *keep = arena->chunks;
+  for (struct arena_chunk *chunk = keep->next, *next; chunk != NULL; chunk = next) {
+    next = chunk->next;
+    free(chunk);
+  }
+  keep->next = NULL;
+  keep->s_used = 0;
+  arena->s_used = 0;
+  arena->s_reserved = keep->s_data;
+}
+
+void goc_arena_free(Arena arena) {
+  if (arena == NULL)
+    return;
+  for (struct arena_chunk *chunk = arena->chunks, *next; chunk != NULL; chunk = next) {
+    next = chunk->next;
+    free(chunk);
+  }
+  free(arena);
+}
+
+void goc_arena_absorb(Arena arena, Arena other) {
+  if (arena == NULL || other == NULL)
+    return;
+  // Behind the current chunk, which keeps serving allocations
+  struct arena_chunk *last = other->chunks;
+  for (; last != NULL && last->next != NULL; last = last->next);
+  if (last != NULL && arena->chunks != NULL) {
+    last->next = arena->chunks->next;
+    arena->chunks->next = other->chunks;
+  } else if (last != NULL)
+    arena->chunks = other->chunks;
+  arena->s_used += other->s_used;
+  arena->s_reserved += other->s_reserved;
+  free(other);
+}
+
+size_t goc_arena_get_size(Arena arena) {
+  return arena ? arena->s_used : 0;
+}
+
+size_t goc_arena_get_reserved(Arena arena) {
+  return arena ? arena->s_reserved : 0;
+}
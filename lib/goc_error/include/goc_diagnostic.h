@@ -0,0 +1,41 @@
+#ifndef GOC_DIAGNOSTIC_H
+#define GOC_DIAGNOSTIC_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "goc_error.h"
+
+// Errors collected by a compiler pass that recovers from them instead of exiting, so one run reports them all.
+// Positions are resolved when an error is recorded and its source line is copied, so a Diagnostics outlives
+// the source it was collected from (a stream window, an unloaded file).
+
+typedef struct diagnostic {
+  GOC_Error   error;
+  const char *message,
+             *file,   // name of the source
+             *line;   // text of the source line, NUL-terminated, without its newline
+  uint32_t    pos_abs,
+              pos_line,
+              pos_rel,
+              s_word;
+} Diagnostic;
+
+typedef struct diagnostics *Diagnostics;
+
+Diagnostics       goc_diagnostics_create(void);
+void              goc_diagnostics_free(Diagnostics diagnostics);
+void              goc_diagnostics_add(
+  Diagnostics diagnostics, GOC_Error error, const char *message, const char *file, const char *line, size_t s_line,
+  uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word
+);
+void              goc_diagnostics_append(Diagnostics diagnostics, Diagnostics from);
+
+size_t            goc_diagnostics_get_count(Diagnostics diagnostics);
+const Diagnostic *goc_diagnostics_at(Diagnostics diagnostics, size_t index);
+
+void              goc_diagnostics_print(Diagnostics diagnostics, FILE *file);
+
+#endif // !GOC_DIAGNOSTIC_H
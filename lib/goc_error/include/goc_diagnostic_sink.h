@@ -0,0 +1,39 @@
+#ifndef GOC_DIAGNOSTIC_SINK_H
+#define GOC_DIAGNOSTIC_SINK_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "goc_error.h"
+#include "goc_diagnostic.h"
+
+// Diagnostic writer. Each format is a backend (begin, emit, end) formatting straight into one output buffer, which
+// is written to the fd when it fills up and on goc_diagnostic_sink_flush / goc_diagnostic_sink_free, so a batch of
+// diagnostics costs one write. The fd is not closed. Columns and lengths count bytes.
+//
+// TEXT   what goc_diagnostics_print writes, colored only when the fd is a terminal
+// JSONL  one JSON object per line: {"code", "error", "file", "line", "column", "offset", "length", "message"}
+// SARIF  one SARIF 2.1.0 log with a single run, a result per diagnostic (ruleId "GOC" and the zero-padded code,
+//        region with startLine, startColumn, byteOffset and byteLength), completed by goc_diagnostic_sink_free
+
+typedef struct diagnostic_sink *DiagnosticSink;
+
+typedef enum diagnostic_format {
+  DIAGNOSTIC_TEXT = 0,
+  DIAGNOSTIC_JSONL,
+  DIAGNOSTIC_SARIF
+} DiagnosticFormat;
+
+#define DIAGNOSTIC_SARIF_VERSION "2.1.0"
+#define DIAGNOSTIC_SARIF_SCHEMA  "https://json.schemastore.org/sarif-2.1.0.json"
+#define DIAGNOSTIC_TOOL_NAME     "goc"
+
+DiagnosticSink goc_diagnostic_sink_create(int fd, DiagnosticFormat format);
+void           goc_diagnostic_sink_emit(DiagnosticSink sink, const Diagnostic *diagnostic);
+void           goc_diagnostic_sink_emit_all(DiagnosticSink sink, Diagnostics diagnostics);
+void           goc_diagnostic_sink_flush(DiagnosticSink sink);
+void           goc_diagnostic_sink_free(DiagnosticSink sink);
+
+#endif // !GOC_DIAGNOSTIC_SINK_H
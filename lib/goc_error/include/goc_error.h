@@ -7,6 +7,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "goc_source.h"
+
 typedef enum goc_error {
   goc_error_nil = 0,
   goc_error_nullptr,
@@ -46,8 +48,11 @@ typedef enum goc_error {
 #define GOC_ERROR_LEXER_BUFFER_OVERRUN          "Buffer overrun (identifier is too large)"
 #define GOC_ERROR_LEXER_INVALID_IDENT           "Invalid Syntax Identifier"
 #define GOC_ERROR_LEXER_INVALID_NUMBER          "Invalid Syntax Number"
+#define GOC_ERROR_LEXER_NUMBER_OVERFLOW         "Number literal overflow (out of the int64 or double range)"
 #define GOC_ERROR_LEXER_INVALID_STRING_LIT      "Invalid Syntax String Literal"
+#define GOC_ERROR_LEXER_INVALID_ESCAPE          "Invalid escape sequence in string or char literal"
 #define GOC_ERROR_LEXER_INVALID_CHAR_LIT        "Invalid Syntax Char Literal"
+#define GOC_ERROR_LEXER_INVALID_UTF8            "Invalid UTF-8 encoding"
 
 // GOC ERROR PARSER MESSAGES
 #define GOC_ERROR_PARSER_SYNTAX_ERROR                        "GOC Parser Error: Syntax Error"
@@ -67,31 +72,72 @@ typedef enum goc_error {
 
 #define GOC_ERROR_PARSER_PACKAGE_MAIN_NOT_FOUND              "Package main not found"
 #define GOC_ERROR_PARSER_AST_UNDEFINED                       "Undefined AST node"
+#define GOC_ERROR_PARSER_UNEXPECTED_TOKEN                    "Unexpected token"
+#define GOC_ERROR_PARSER_END_OF_INPUT                        "Unexpected end of input"
+#define GOC_ERROR_PARSER_INVALID_ASSIGN_TARGET               "Cannot assign to this expression"
+#define GOC_ERROR_PARSER_EXPECTED                            "Expected %s"
+#define GOC_ERROR_PARSER_TOO_MANY_ERRORS                     "Too many errors, parsing stopped"
+#define GOC_ERROR_PARSER_TOO_DEEP                            "Nesting too deep"
 
 #define GOC_ERROR_UNKNOWN                                    "GOC Error: Unknown"
 
-#define MAX_LINE_SIZE 512
-
 // =========================================================# PRIVATE #================================================================
 
 void _goc_error_assert(GOC_Error error, const char *msg, const char *file, const char *func, uint32_t line);
 
 // ==========================================================# PUBLIC #================================================================
 
+// goc_error_assert guards API boundaries and resource failures, it is always compiled. Internal invariants use
+// goc_error_check, compiled from GOC_CHECK_CHEAP on, and the costly ones goc_error_check_paranoid, compiled at
+// GOC_CHECK_PARANOID only. The level is set per build (CHECK=off|cheap|paranoid in the makefiles).
+#define GOC_CHECK_OFF      0
+#define GOC_CHECK_CHEAP    1
+#define GOC_CHECK_PARANOID 2
+
+#ifndef GOC_CHECK_LEVEL
+#define GOC_CHECK_LEVEL GOC_CHECK_CHEAP
+#endif
+
 #define goc_error_assert(error, condidition) condidition ? (void)0 : _goc_error_assert(error, #condidition, __FILE__, __func__, __LINE__);
-void goc_error_print_panic(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word);
+
+// A compiled out check still type-checks its condition, without evaluating it
+#if GOC_CHECK_LEVEL >= GOC_CHECK_CHEAP
+#define goc_error_check(error, condition) ((condition) ? (void)0 : _goc_error_assert(error, #condition, __FILE__, __func__, __LINE__))
+#else
+#define goc_error_check(error, condition) ((void)sizeof((condition) ? 1 : 0))
+#endif
+
+#if GOC_CHECK_LEVEL >= GOC_CHECK_PARANOID
+#define goc_error_check_paranoid(error, condition) goc_error_check(error, condition)
+#else
+#define goc_error_check_paranoid(error, condition) ((void)sizeof((condition) ? 1 : 0))
+#endif
+
+const char *goc_error_to_str(GOC_Error error);
+
+// The printers below resolve loc through goc_source and exit, the source line is taken from its line table
+void goc_error_print_panic(SourceLoc loc, uint32_t s_word);
+void goc_error_print_line(
+  FILE *out, GOC_Error error, const char *msg, const char *line, size_t s_line, uint32_t pos_line, uint32_t pos_rel
+);
 
 // GOC LEXER
 void goc_error_lexer_print_input_file(const char *file_name);
-void goc_error_lexer_print_buffer_overrun(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word);
-void goc_error_lexer_print_invalid_ident(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word);
-void goc_error_lexer_print_invalid_number(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word);
-void goc_error_lexer_print_invalid_string_lit(FILE *file, uint32_t pos_line, uint32_t pos_rel, uint32_t pos_abs, uint32_t s_word);
-void goc_error_lexer_print_invalid_char_lit(FILE *file, uint32_t pos_line, uint32_t pos_rel, uint32_t pos_abs, uint32_t s_word);
+void goc_error_lexer_print_buffer_overrun(SourceLoc loc, uint32_t s_word);
+void goc_error_lexer_print_invalid_ident(SourceLoc loc, uint32_t s_word);
+void goc_error_lexer_print_invalid_number(SourceLoc loc, uint32_t s_word);
+void goc_error_lexer_print_number_overflow(SourceLoc loc, uint32_t s_word);
+void goc_error_lexer_print_invalid_string_lit(SourceLoc loc, uint32_t s_word);
+void goc_error_lexer_print_invalid_escape(SourceLoc loc, uint32_t s_word);
+void goc_error_lexer_print_invalid_char_lit(SourceLoc loc, uint32_t s_word);
 
 // GOC PARSER
-void goc_error_parser_print_package_main_not_found(FILE *file, uint32_t pos_line, uint32_t pos_rel, uint32_t pos_abs, uint32_t s_word);
-void goc_error_parser_print_ast_undefined(FILE *file, uint32_t pos_line, uint32_t pos_rel, uint32_t pos_abs, uint32_t s_word);
+void goc_error_parser_print_package_main_not_found(SourceLoc loc, uint32_t s_word);
+void goc_error_parser_print_ast_undefined(SourceLoc loc, uint32_t s_word);
+void goc_error_parser_print_unexpected_token(SourceLoc loc, uint32_t s_word);
+void goc_error_parser_print_end_of_input(SourceLoc loc, uint32_t s_word);
+void goc_error_parser_print_invalid_assign_target(SourceLoc loc, uint32_t s_word);
+void goc_error_parser_print_expected(SourceLoc loc, uint32_t s_word, const char *expected);
 
 typedef enum {
     ANSI_COLOR_RESET,
@@ -0,0 +1,39 @@
+#ifndef GOC_SOURCE_H
+#define GOC_SOURCE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Every registered source gets a disjoint range [base, base + size] of one 32-bit location space, so a
+// SourceLoc packs (source id, byte offset) in 4 bytes. Line and column are computed on demand from a
+// per-source line start table, built once on the first query.
+// goc_source_load reads a file once and owns its buffer: loading a path that is still registered hands back the
+// same id, each load or register being matched by one goc_source_unregister.
+
+typedef uint32_t SourceLoc;
+typedef uint32_t SourceId;
+
+#define GOC_SOURCE_LOC_INVALID ((SourceLoc)0)
+#define GOC_SOURCE_ID_INVALID  ((SourceId)UINT32_MAX)
+
+SourceId    goc_source_register(const char *name, const char *data, size_t s_data);
+SourceId    goc_source_load(const char *path);  // GOC_SOURCE_ID_INVALID if it can not be read
+void        goc_source_unregister(SourceId id);
+
+SourceLoc   goc_source_loc(SourceId id, size_t offset);
+SourceId    goc_source_loc_id(SourceLoc loc);
+size_t      goc_source_loc_offset(SourceLoc loc);
+size_t      goc_source_loc_line(SourceLoc loc);
+size_t      goc_source_loc_rel(SourceLoc loc);
+
+const char *goc_source_get_name(SourceId id);
+const char *goc_source_get_data(SourceId id);
+size_t      goc_source_get_size(SourceId id);
+size_t      goc_source_get_line_count(SourceId id);
+
+// Text of line (1-based) without its newline, in O(1) once the line table is built. NULL past the last line.
+const char *goc_source_line_text(SourceId id, size_t line, size_t *s_text);
+
+#endif // !GOC_SOURCE_H
@@ -0,0 +1,68 @@
+#ifndef GOC_WRITER_H
+#define GOC_WRITER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "goc_error.h"
+
+// Buffered output to an fd, under the diagnostic sink and the token dump. Text is gathered in one buffer, written
+// when it fills up and on goc_writer_flush / goc_writer_free, so a batch of records costs one write. The fd is not
+// closed. The appends are inline (the dump makes several per token), the struct is part of the API for them.
+
+typedef struct writer *Writer;
+
+struct writer {
+  int     fd;
+  char   *data;
+  size_t  s_data,
+          s_buffer;
+};
+
+// Bytes a formatted number takes at most
+#define GOC_WRITER_NUMBER_MAX 32
+
+#define goc_writer_literal(writer, text) goc_writer_append((writer), (text), sizeof(text) - 1)
+
+Writer goc_writer_create(int fd, size_t s_buffer); // s_buffer at least GOC_WRITER_NUMBER_MAX
+void   goc_writer_flush(Writer writer);
+void   goc_writer_free(Writer writer);
+
+void   goc_writer_write(int fd, const char *data, size_t s_data); // unbuffered, all of data, retried on EINTR
+void   goc_writer_fill(Writer writer, char ch, size_t s_fill);
+void   goc_writer_json_string(Writer writer, const char *text, size_t s_text); // quoted and escaped
+
+// Room for size more bytes at writer->data + writer->s_data, size at most s_buffer
+static inline void goc_writer_reserve(Writer writer, size_t size) {
+  goc_error_check(goc_error_inval_arg, size <= writer->s_buffer);
+  if (writer->s_data + size > writer->s_buffer)
+    goc_writer_flush(writer);
+}
+
+static inline void goc_writer_append(Writer writer, const char *text, size_t s_text) {
+  if (s_text >= writer->s_buffer) {
+    goc_writer_flush(writer);
+    goc_writer_write(writer->fd, text, s_text);
+    return;
+  }
+  goc_writer_reserve(writer, s_text);
+  memcpy(writer->data + writer->s_data, text, s_text);
+  writer->s_data += s_text;
+}
+
+// Digits are produced backwards into a scratch buffer, at least s_min of them
+static inline void goc_writer_uint(Writer writer, uint64_t value, size_t s_min) {
+  char digits[20];
+  size_t s_digits = 0;
+  do {
+    digits[sizeof(digits) - ++s_digits] = (char)('0' + value % 10);
+    value /= 10;
+  } while (value > 0 || (s_digits < s_min && s_digits < sizeof(digits)));
+  goc_writer_reserve(writer, GOC_WRITER_NUMBER_MAX);
+  memcpy(writer->data + writer->s_data, digits + sizeof(digits) - s_digits, s_digits);
+  writer->s_data += s_digits;
+}
+
+#endif // !GOC_WRITER_H
@@ -0,0 +1,92 @@
+#include <string.h>
+
+#include "goc_diagnostic.h"
+
+struct diagnostics {
+  Diagnostic *entries;
+  size_t      s_entries,
+              s_entries_alloc;
+};
+
+static const size_t diagnostics_size_init = 16;
+
+// =========================================================# PRIVATE #================================================================
+
+static void _goc_diagnostics_reserve(Diagnostics diagnostics, size_t s_entries) {
+  if (s_entries <= diagnostics->s_entries_alloc)
+    return;
+  size_t s_alloc = diagnostics->s_entries_alloc ? diagnostics->s_entries_alloc : diagnostics_size_init;
+  for (; s_alloc < s_entries; s_alloc *= 2);
+  Diagnostic *entries = (Diagnostic *)realloc(diagnostics->entries, s_alloc * sizeof(Diagnostic));
+  goc_error_assert(goc_error_mem_error, entries != NULL);
+  diagnostics->entries = entries;
+  diagnostics->s_entries_alloc = s_alloc;
+}
+
+// ==========================================================# PUBLIC #================================================================
+
+Diagnostics goc_diagnostics_create(void) {
+  return (Diagnostics)calloc(1, sizeof(struct diagnostics));
+}
+
+void goc_diagnostics_free(Diagnostics diagnostics) {
+  if (diagnostics == NULL)
+    return;
+  for (size_t index = 0; index < diagnostics->s_entries; index++)
+    free((void *)diagnostics->entries[index].line);
+  free(diagnostics->entries);
+  free(diagnostics);
+}
+
+void goc_diagnostics_add(
+  Diagnostics diagnostics, GOC_Error error, const char *message, const char *file, const char *line, size_t s_line,
+  uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word
+) {
+  goc_error_assert(goc_error_nullptr, diagnostics != NULL);
+  goc_error_assert(goc_error_nullptr, message != NULL);
+  goc_error_assert(goc_error_nullptr, line != NULL || s_line == 0);
+
+  // The line and the file name share one allocation, freed through line
+  file = file ? file : "";
+  size_t s_file = strlen(file);
+  char *copy = (char *)malloc(s_line + s_file + 2);
+  goc_error_assert(goc_error_mem_error, copy != NULL);
+  memcpy(copy, line, s_line);
+  copy[s_line] = '\0';
+  memcpy(copy + s_line + 1, file, s_file + 1);
+
+  _goc_diagnostics_reserve(diagnostics, diagnostics->s_entries + 1);
+  diagnostics->entries[diagnostics->s_entries++] = (Diagnostic){
+    error, message, copy + s_line + 1, copy, pos_abs, pos_line, pos_rel, s_word
+  };
+}
+
+// Moves every diagnostic of from to the end of diagnostics, from is left empty
+void goc_diagnostics_append(Diagnostics diagnostics, Diagnostics from) {
+  goc_error_assert(goc_error_nullptr, diagnostics != NULL);
+  if (from == NULL || from->s_entries == 0)
+    return;
+  _goc_diagnostics_reserve(diagnostics, diagnostics->s_entries + from->s_entries);
+  memcpy(diagnostics->entries + diagnostics->s_entries, from->entries, from->s_entries * sizeof(Diagnostic));
+  diagnostics->s_entries += from->s_entries;
+  from->s_entries = 0;
+}
+
+size_t goc_diagnostics_get_count(Diagnostics diagnostics) {
+  return diagnostics ? diagnostics->s_entries : 0;
+}
+
+const Diagnostic *goc_diagnostics_at(Diagnostics diagnostics, size_t index) {
+  return (diagnostics && index < diagnostics->s_entries) ? &(diagnostics->entries[index]) : NULL;
+}
+
+void goc_diagnostics_print(Diagnostics diagnostics, FILE *file) {
+  goc_error_assert(goc_error_nullptr, file != NULL);
+  for (size_t index = 0; index < goc_diagnostics_get_count(diagnostics); index++) {
+    const Diagnostic *diagnostic = &(diagnostics->entries[index]);
+    goc_error_print_line(
+      file, diagnostic->error, diagnostic->message, diagnostic->line, strlen(diagnostic->line),
+      diagnostic->pos_line, diagnostic->pos_rel
+    );
+  }
+}
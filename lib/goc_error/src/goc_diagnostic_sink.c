@@ -0,0 +1,177 @@
+#include <string.h>
+#include <unistd.h>
+
+#include "goc_diagnostic_sink.h"
+#include "goc_writer.h"
+
+// One backend per DiagnosticFormat, begin and end write what surrounds the diagnostics (NULL for nothing)
+struct diagnostic_sink_backend {
+  void (*begin)(DiagnosticSink sink);
+  void (*emit)(DiagnosticSink sink, const Diagnostic *diagnostic);
+  void (*end)(DiagnosticSink sink);
+};
+
+struct diagnostic_sink {
+  Writer                                writer;
+  const struct diagnostic_sink_backend *backend;
+  bool                                  colors;
+  size_t                                s_emitted;
+};
+
+static const size_t diagnostic_sink_size = 64 * 1024;
+
+#define _goc_diagnostic_sink_literal(sink, text) goc_writer_literal((sink)->writer, (text))
+
+// =========================================================# PRIVATE #================================================================
+
+static void _goc_diagnostic_sink_append(DiagnosticSink sink, const char *text) {
+  goc_writer_append(sink->writer, text, strlen(text));
+}
+
+static void _goc_diagnostic_sink_color(DiagnosticSink sink, ANSI_Color color) {
+  if (sink->colors)
+    _goc_diagnostic_sink_append(sink, ANSI_COLORS[color]);
+}
+
+static void _goc_diagnostic_sink_json_string(DiagnosticSink sink, const char *text) {
+  goc_writer_json_string(sink->writer, text, strlen(text));
+}
+
+// Same layout as goc_error_print_line, colored only on a terminal
+static void _goc_diagnostic_sink_text(DiagnosticSink sink, const Diagnostic *diagnostic) {
+  const char *error = goc_error_to_str(diagnostic->error);
+  _goc_diagnostic_sink_color(sink, ANSI_COLOR_RED);
+  _goc_diagnostic_sink_literal(sink, "[");
+  _goc_diagnostic_sink_append(sink, error);
+  _goc_diagnostic_sink_literal(sink, "] ");
+  _goc_diagnostic_sink_append(sink, diagnostic->message);
+  _goc_diagnostic_sink_color(sink, ANSI_COLOR_RESET);
+
+  size_t s_number = 0;
+  for (uint32_t value = diagnostic->pos_line; value > 0; value /= 10, s_number++);
+  _goc_diagnostic_sink_literal(sink, "\n ");
+  goc_writer_uint(sink->writer, diagnostic->pos_line, 0);
+  _goc_diagnostic_sink_literal(sink, " | ");
+  _goc_diagnostic_sink_append(sink, diagnostic->line);
+  _goc_diagnostic_sink_literal(sink, "\n ");
+  goc_writer_fill(sink->writer, ' ', s_number);
+  _goc_diagnostic_sink_literal(sink, " | ");
+
+  uint32_t column = diagnostic->pos_rel;
+  for (uint32_t byte = 0; byte + 1 < diagnostic->pos_rel && diagnostic->line[byte] != '\0'; byte++)
+    column -= ((unsigned char)diagnostic->line[byte] & 0xc0) == 0x80;
+  _goc_diagnostic_sink_color(sink, ANSI_COLOR_RED);
+  goc_writer_fill(sink->writer, ' ', column > 0 ? column - 1 : 0);
+  goc_writer_append(sink->writer, (char[]){ GOC_CHAR_ERROR_POINTER }, 1);
+  _goc_diagnostic_sink_color(sink, ANSI_COLOR_RESET);
+  _goc_diagnostic_sink_literal(sink, "\n");
+}
+
+static void _goc_diagnostic_sink_jsonl(DiagnosticSink sink, const Diagnostic *diagnostic) {
+  _goc_diagnostic_sink_literal(sink, "{\"code\":");
+  goc_writer_uint(sink->writer, (uint64_t)diagnostic->error, 0);
+  _goc_diagnostic_sink_literal(sink, ",\"error\":");
+  _goc_diagnostic_sink_json_string(sink, goc_error_to_str(diagnostic->error));
+  _goc_diagnostic_sink_literal(sink, ",\"file\":");
+  _goc_diagnostic_sink_json_string(sink, diagnostic->file);
+  _goc_diagnostic_sink_literal(sink, ",\"line\":");
+  goc_writer_uint(sink->writer, diagnostic->pos_line, 0);
+  _goc_diagnostic_sink_literal(sink, ",\"column\":");
+  goc_writer_uint(sink->writer, diagnostic->pos_rel, 0);
+  _goc_diagnostic_sink_literal(sink, ",\"offset\":");
+  goc_writer_uint(sink->writer, diagnostic->pos_abs > 0 ? diagnostic->pos_abs - 1 : 0, 0);
+  _goc_diagnostic_sink_literal(sink, ",\"length\":");
+  goc_writer_uint(sink->writer, diagnostic->s_word, 0);
+  _goc_diagnostic_sink_literal(sink, ",\"message\":");
+  _goc_diagnostic_sink_json_string(sink, diagnostic->message);
+  _goc_diagnostic_sink_literal(sink, "}\n");
+}
+
+static void _goc_diagnostic_sink_sarif_begin(DiagnosticSink sink) {
+  _goc_diagnostic_sink_literal(
+    sink,
+    "{\"version\":\"" DIAGNOSTIC_SARIF_VERSION "\",\"$schema\":\"" DIAGNOSTIC_SARIF_SCHEMA "\","
+    "\"runs\":[{\"tool\":{\"driver\":{\"name\":\"" DIAGNOSTIC_TOOL_NAME "\"}},\"results\":["
+  );
+}
+
+static void _goc_diagnostic_sink_sarif(DiagnosticSink sink, const Diagnostic *diagnostic) {
+  if (sink->s_emitted > 0)
+    _goc_diagnostic_sink_literal(sink, ",");
+  _goc_diagnostic_sink_literal(sink, "\n{\"ruleId\":\"GOC");
+  goc_writer_uint(sink->writer, (uint64_t)diagnostic->error, 3);
+  _goc_diagnostic_sink_literal(sink, "\",\"level\":\"error\",\"message\":{\"text\":");
+  _goc_diagnostic_sink_json_string(sink, diagnostic->message);
+  _goc_diagnostic_sink_literal(sink, "},\"locations\":[{\"physicalLocation\":{\"artifactLocation\":{\"uri\":");
+  _goc_diagnostic_sink_json_string(sink, diagnostic->file);
+  _goc_diagnostic_sink_literal(sink, "},\"region\":{\"startLine\":");
+  goc_writer_uint(sink->writer, diagnostic->pos_line, 0);
+  _goc_diagnostic_sink_literal(sink, ",\"startColumn\":");
+  goc_writer_uint(sink->writer, diagnostic->pos_rel, 0);
+  _goc_diagnostic_sink_literal(sink, ",\"byteOffset\":");
+  goc_writer_uint(sink->writer, diagnostic->pos_abs > 0 ? diagnostic->pos_abs - 1 : 0, 0);
+  _goc_diagnostic_sink_literal(sink, ",\"byteLength\":");
+  goc_writer_uint(sink->writer, diagnostic->s_word, 0);
+  _goc_diagnostic_sink_literal(sink, "}}}]}");
+}
+
+static void _goc_diagnostic_sink_sarif_end(DiagnosticSink sink) {
+  _goc_diagnostic_sink_literal(sink, "\n]}]}\n");
+}
+
+static const struct diagnostic_sink_backend diagnostic_sink_backends[] = {
+  [DIAGNOSTIC_TEXT]  = { NULL,                             _goc_diagnostic_sink_text,  NULL                           },
+  [DIAGNOSTIC_JSONL] = { NULL,                             _goc_diagnostic_sink_jsonl, NULL                           },
+  [DIAGNOSTIC_SARIF] = { _goc_diagnostic_sink_sarif_begin, _goc_diagnostic_sink_sarif, _goc_diagnostic_sink_sarif_end }
+};
+
+// ==========================================================# PUBLIC #================================================================
+
+DiagnosticSink goc_diagnostic_sink_create(int fd, DiagnosticFormat format) {
+  goc_error_assert(goc_error_inval_arg, fd >= 0);
+  goc_error_assert(goc_error_inval_arg, format <= DIAGNOSTIC_SARIF);
+
+  DiagnosticSink sink = (DiagnosticSink)malloc(sizeof(struct diagnostic_sink));
+  if (sink == NULL)
+    return NULL;
+  sink->writer = goc_writer_create(fd, diagnostic_sink_size);
+  if (sink->writer == NULL) {
+    free(sink);
+    return NULL;
+  }
+  sink->backend = &(diagnostic_sink_backends[format]);
+  sink->colors = format == DIAGNOSTIC_TEXT && isatty(fd);
+  sink->s_emitted = 0;
+
+  if (sink->backend->begin != NULL)
+    sink->backend->begin(sink);
+  return sink;
+}
+
+void goc_diagnostic_sink_emit(DiagnosticSink sink, const Diagnostic *diagnostic) {
+  goc_error_assert(goc_error_nullptr, sink != NULL);
+  goc_error_assert(goc_error_nullptr, diagnostic != NULL);
+  sink->backend->emit(sink, diagnostic);
+  sink->s_emitted++;
+}
+
+void goc_diagnostic_sink_emit_all(DiagnosticSink sink, Diagnostics diagnostics) {
+  goc_error_assert(goc_error_nullptr, sink != NULL);
+  size_t s_diagnostics = goc_diagnostics_get_count(diagnostics);
+  for (size_t index = 0; index < s_diagnostics; index++)
+    goc_diagnostic_sink_emit(sink, goc_diagnostics_at(diagnostics, index));
+}
+
+void goc_diagnostic_sink_flush(DiagnosticSink sink) {
+  goc_error_assert(goc_error_nullptr, sink != NULL);
+  goc_writer_flush(sink->writer);
+}
+
+void goc_diagnostic_sink_free(DiagnosticSink sink) {
+  if (sink == NULL)
+    return;
+  if (sink->backend->end != NULL)
+    sink->backend->end(sink);
+  goc_writer_free(sink->writer);
+  free(sink);
+}
@@ -32,46 +32,21 @@ static uint32_t intlen(int32_t value) {
   return len;
 }
 
-static void _goc_error_print(
-  GOC_Error error, const char *msg, FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word
-) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-
-  char line_buffer[MAX_LINE_SIZE];
-  fseek(file, 0, SEEK_SET);
-  uint32_t current_line = 1;
-  for (; fgets(line_buffer, sizeof(line_buffer), file); current_line++)
-    if (current_line == pos_line)
-      break;
-
-  size_t len = strlen(line_buffer);
-  if (line_buffer[len - 1] == '\n')
-    line_buffer[len - 1] = '\0';
-
-  const char *error_msg = _goc_error_match_error_type(error);
-  fprintf(
-    stderr,
-    "%s[%s] %s%s\n %u | %s\n %*s | %s%*c%s\n",
-    ANSI_COLORS[ANSI_COLOR_RED],
-    error_msg ? error_msg : "",
-    msg,
-    ANSI_COLORS[ANSI_COLOR_RESET],
-    current_line,
-    line_buffer,
-    intlen(current_line), "",
-    ANSI_COLORS[ANSI_COLOR_RED],
-    /*0, GOC_CHAR_ERROR_UNDERLINE,*/
-    pos_rel, GOC_CHAR_ERROR_POINTER,
-    /*s_word - 1, GOC_CHAR_ERROR_UNDERLINE,*/
-    ANSI_COLORS[ANSI_COLOR_RESET]
-  );
+static void _goc_error_print(GOC_Error error, const char *msg, SourceLoc loc, uint32_t s_word) {
+  SourceId source = goc_source_loc_id(loc);
+  goc_error_assert(goc_error_inval_arg, source != GOC_SOURCE_ID_INVALID);
+
+  size_t pos_line = goc_source_loc_line(loc),
+         s_line   = 0;
+  const char *line = goc_source_line_text(source, pos_line, &s_line);
+  goc_error_print_line(stderr, error, msg, line, s_line, (uint32_t)pos_line, (uint32_t)goc_source_loc_rel(loc));
   exit(error);
 }
 
 // GOC LEXER ERROR
 
-void goc_error_lexer_print_buffer_overrun(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word) {
-  _goc_error_print(goc_error_lexer_crash, GOC_ERROR_LEXER_BUFFER_OVERRUN, file, pos_abs, pos_line, pos_rel, s_word);
+void goc_error_lexer_print_buffer_overrun(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_lexer_crash, GOC_ERROR_LEXER_BUFFER_OVERRUN, loc, s_word);
 }
 
 void goc_error_lexer_print_input_file(const char *file_name) {
@@ -87,30 +62,57 @@ void goc_error_lexer_print_input_file(const char *file_name) {
   exit(goc_error_lexer_ioerror);
 }
 
-void goc_error_lexer_print_invalid_ident(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word) {
-  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_INVALID_IDENT, file, pos_abs, pos_line, pos_rel, s_word);
+void goc_error_lexer_print_invalid_ident(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_INVALID_IDENT, loc, s_word);
+}
+
+void goc_error_lexer_print_invalid_number(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_INVALID_NUMBER, loc, s_word);
 }
 
-void goc_error_lexer_print_invalid_number(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word) {
-  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_INVALID_NUMBER, file, pos_abs, pos_line, pos_rel, s_word);
+void goc_error_lexer_print_number_overflow(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_NUMBER_OVERFLOW, loc, s_word);
 }
 
-void goc_error_lexer_print_invalid_string_lit(FILE *file, uint32_t pos_line, uint32_t pos_rel, uint32_t pos_abs, uint32_t s_word) {
-  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_INVALID_STRING_LIT, file, pos_abs, pos_line, pos_rel, s_word);
+void goc_error_lexer_print_invalid_string_lit(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_INVALID_STRING_LIT, loc, s_word);
 }
 
-void goc_error_lexer_print_invalid_char_lit(FILE *file, uint32_t pos_line, uint32_t pos_rel, uint32_t pos_abs, uint32_t s_word) {
-  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_INVALID_CHAR_LIT, file, pos_abs, pos_line, pos_rel, s_word);
+void goc_error_lexer_print_invalid_escape(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_INVALID_ESCAPE, loc, s_word);
+}
+
+void goc_error_lexer_print_invalid_char_lit(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_lexer_invalid_syntax, GOC_ERROR_LEXER_INVALID_CHAR_LIT, loc, s_word);
 }
 
 // GOC PARSER ERROR
 
-void goc_error_parser_print_package_main_not_found(FILE *file, uint32_t pos_line, uint32_t pos_rel, uint32_t pos_abs, uint32_t s_word) {
-  _goc_error_print(goc_error_parser_missing_token, GOC_ERROR_PARSER_PACKAGE_MAIN_NOT_FOUND, file, pos_abs, pos_line, pos_rel, s_word);
+void goc_error_parser_print_package_main_not_found(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_parser_missing_token, GOC_ERROR_PARSER_PACKAGE_MAIN_NOT_FOUND, loc, s_word);
 }
 
-void goc_error_parser_print_ast_undefined(FILE *file, uint32_t pos_line, uint32_t pos_rel, uint32_t pos_abs, uint32_t s_word) {
-  _goc_error_print(goc_error_parser_ast_undefined, GOC_ERROR_PARSER_AST_UNDEFINED, file, pos_abs, pos_line, pos_rel, s_word);
+void goc_error_parser_print_ast_undefined(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_parser_ast_undefined, GOC_ERROR_PARSER_AST_UNDEFINED, loc, s_word);
+}
+
+void goc_error_parser_print_unexpected_token(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_parser_syntax_error, GOC_ERROR_PARSER_UNEXPECTED_TOKEN, loc, s_word);
+}
+
+void goc_error_parser_print_end_of_input(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_parser_unexpected_end_of_input, GOC_ERROR_PARSER_END_OF_INPUT, loc, s_word);
+}
+
+void goc_error_parser_print_invalid_assign_target(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_parser_invalid_assignment, GOC_ERROR_PARSER_INVALID_ASSIGN_TARGET, loc, s_word);
+}
+
+void goc_error_parser_print_expected(SourceLoc loc, uint32_t s_word, const char *expected) {
+  goc_error_assert(goc_error_nullptr, expected != NULL);
+  char msg[128];
+  snprintf(msg, sizeof(msg), GOC_ERROR_PARSER_EXPECTED, expected);
+  _goc_error_print(goc_error_parser_missing_token, msg, loc, s_word);
 }
 
 // GOC COMPILER ERROR NOT STATIC
@@ -120,8 +122,40 @@ void _goc_error_assert(GOC_Error error, const char *msg, const char *file, const
   exit(error);
 }
 
-void goc_error_print_panic(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word) {
-  _goc_error_print(goc_error_lexer_invalid_syntax, "", file, pos_abs, pos_line, pos_rel, s_word);
+const char *goc_error_to_str(GOC_Error error) {
+  return _goc_error_match_error_type(error);
+}
+
+void goc_error_print_panic(SourceLoc loc, uint32_t s_word) {
+  _goc_error_print(goc_error_lexer_invalid_syntax, "", loc, s_word);
+}
+
+void goc_error_print_line(
+  FILE *out, GOC_Error error, const char *msg, const char *line, size_t s_line, uint32_t pos_line, uint32_t pos_rel
+) {
+  goc_error_assert(goc_error_nullptr, out != NULL);
+  const char *error_msg = _goc_error_match_error_type(error);
+
+  // pos_rel counts bytes, the pointer goes under the character: UTF-8 continuation bytes take no column
+  uint32_t column = pos_rel;
+  for (uint32_t byte = 0; line != NULL && byte + 1 < pos_rel && byte < s_line; byte++)
+    column -= ((unsigned char)line[byte] & 0xc0) == 0x80;
+  fprintf(
+    out,
+    "%s[%s] %s%s\n %u | %.*s\n %*s | %s%*c%s\n",
+    ANSI_COLORS[ANSI_COLOR_RED],
+    error_msg ? error_msg : "",
+    msg,
+    ANSI_COLORS[ANSI_COLOR_RESET],
+    pos_line,
+    line ? (int)s_line : 0, line ? line : "",
+    intlen(pos_line), "",
+    ANSI_COLORS[ANSI_COLOR_RED],
+    /*0, GOC_CHAR_ERROR_UNDERLINE,*/
+    column, GOC_CHAR_ERROR_POINTER,
+    /*s_word - 1, GOC_CHAR_ERROR_UNDERLINE,*/
+    ANSI_COLORS[ANSI_COLOR_RESET]
+  );
 }
 
 const char *ANSI_COLORS[ANSI_COLOR_COUNT] = {
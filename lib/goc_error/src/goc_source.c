@@ -0,0 +1,277 @@
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "goc_error.h"
+#include "goc_source.h"
+
+#define GOC_SOURCE_NAME_BUFFER "<buffer>"
+
+struct goc_source_file {
+  const char *name,
+             *data;
+  size_t      s_data;
+  SourceLoc   base;
+  uint32_t   *line_starts;
+  size_t      s_lines;
+  uint32_t    refs;
+  bool        live,
+              mapped,
+              owned;
+};
+
+static struct goc_source_file *goc_sources = NULL;
+static size_t                  s_goc_sources = 0,
+                               s_goc_sources_alloc = 0;
+static SourceLoc               goc_source_next_base = 1;
+static pthread_mutex_t         goc_source_lines_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static const size_t goc_source_size_init = 16;
+static const size_t goc_source_lines_init = 1024;
+static const size_t goc_source_read_size_init = 4096;
+
+// =========================================================# PRIVATE #================================================================
+
+static struct goc_source_file *_goc_source_get(SourceId id) {
+  return (id < s_goc_sources && goc_sources[id].live) ? &(goc_sources[id]) : NULL;
+}
+
+static void _goc_source_build_lines(struct goc_source_file *source) {
+  size_t s_alloc = goc_source_lines_init;
+  uint32_t *line_starts = (uint32_t *)malloc(s_alloc * sizeof(uint32_t));
+  goc_error_assert(goc_error_mem_error, line_starts != NULL);
+
+  size_t s_lines = 0;
+  line_starts[s_lines++] = 0;
+  const char *data = source->data,
+             *end  = source->data + source->s_data;
+  for (const char *nl; data < end && (nl = memchr(data, '\n', (size_t)(end - data))) != NULL; data = nl + 1) {
+    if (s_lines >= s_alloc) {
+      uint32_t *temp = (uint32_t *)realloc(line_starts, 2 * s_alloc * sizeof(uint32_t));
+      goc_error_assert(goc_error_mem_error, temp != NULL);
+      s_alloc *= 2;
+      line_starts = temp;
+    }
+    line_starts[s_lines++] = (uint32_t)(nl + 1 - source->data);
+  }
+
+  source->s_lines = s_lines;
+  __atomic_store_n(&(source->line_starts), line_starts, __ATOMIC_RELEASE);
+}
+
+// The line start table is built on first use, under a lock since threads lexing chunks of the same source may
+// resolve locations at the same time.
+static const uint32_t *_goc_source_lines(struct goc_source_file *source) {
+  if (__atomic_load_n(&(source->line_starts), __ATOMIC_ACQUIRE) == NULL) {
+    pthread_mutex_lock(&goc_source_lines_lock);
+    if (source->line_starts == NULL)
+      _goc_source_build_lines(source);
+    pthread_mutex_unlock(&goc_source_lines_lock);
+  }
+  return source->line_starts;
+}
+
+// Index of the line (0-based) holding offset
+static size_t _goc_source_line_index(struct goc_source_file *source, size_t offset) {
+  const uint32_t *line_starts = _goc_source_lines(source);
+  size_t lo = 0,
+         hi = source->s_lines;
+  while (hi - lo > 1) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (line_starts[mid] <= offset)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+// Maps a regular file, reads anything else (empty file, pipe, ...) whole
+static const char *_goc_source_read(int fd, size_t *s_data, bool *mapped) {
+  struct stat st;
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      (void)madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+      *s_data = (size_t)st.st_size;
+      *mapped = true;
+      return (const char *)data;
+    }
+  }
+
+  size_t s_alloc = goc_source_read_size_init;
+  char *data = (char *)malloc(s_alloc);
+  goc_error_assert(goc_error_mem_error, data != NULL);
+  *s_data = 0;
+  for (ssize_t s_read; (s_read = read(fd, data + *s_data, s_alloc - *s_data)) != 0; ) {
+    if (s_read == -1) {
+      free(data);
+      return NULL;
+    }
+    *s_data += (size_t)s_read;
+    if (*s_data < s_alloc)
+      continue;
+    char *temp = (char *)realloc(data, 2 * s_alloc);
+    goc_error_assert(goc_error_mem_error, temp != NULL);
+    s_alloc *= 2;
+    data = temp;
+  }
+  *mapped = false;
+  return data;
+}
+
+// ==========================================================# PUBLIC #================================================================
+
+SourceId goc_source_register(const char *name, const char *data, size_t s_data) {
+  goc_error_assert(goc_error_nullptr, data != NULL || s_data == 0);
+  goc_error_assert(goc_error_inval_arg, s_data < (size_t)(UINT32_MAX - goc_source_next_base));
+
+  if (s_goc_sources >= s_goc_sources_alloc) {
+    size_t s_alloc = s_goc_sources_alloc ? 2 * s_goc_sources_alloc : goc_source_size_init;
+    struct goc_source_file *temp = (struct goc_source_file *)realloc(goc_sources, s_alloc * sizeof(struct goc_source_file));
+    goc_error_assert(goc_error_mem_error, temp != NULL);
+    goc_sources = temp;
+    s_goc_sources_alloc = s_alloc;
+  }
+
+  char *source_name = strdup(name ? name : GOC_SOURCE_NAME_BUFFER);
+  goc_error_assert(goc_error_mem_error, source_name != NULL);
+
+  // One extra location past the end so the EOF position of every source is addressable
+  SourceId id = (SourceId)s_goc_sources++;
+  goc_sources[id] = (struct goc_source_file){ source_name, data, s_data, goc_source_next_base, NULL, 0, 1, true, false, false };
+  goc_source_next_base += (SourceLoc)s_data + 1;
+  return id;
+}
+
+SourceId goc_source_load(const char *path) {
+  goc_error_assert(goc_error_nullptr, path != NULL);
+
+  for (size_t id = 0; id < s_goc_sources; id++) {
+    struct goc_source_file *source = &(goc_sources[id]);
+    if (source->live && source->owned && strcmp(source->name, path) == 0) {
+      source->refs++;
+      return (SourceId)id;
+    }
+  }
+
+  int fd = open(path, O_RDONLY);
+  if (fd == -1)
+    return GOC_SOURCE_ID_INVALID;
+  size_t s_data = 0;
+  bool mapped = false;
+  const char *data = _goc_source_read(fd, &s_data, &mapped);
+  close(fd);
+  if (data == NULL)
+    return GOC_SOURCE_ID_INVALID;
+
+  SourceId id = goc_source_register(path, data, s_data);
+  goc_sources[id].mapped = mapped;
+  goc_sources[id].owned = true;
+  return id;
+}
+
+void goc_source_unregister(SourceId id) {
+  struct goc_source_file *source = _goc_source_get(id);
+  if (source == NULL || --source->refs > 0)
+    return;
+  if (source->owned && source->mapped)
+    munmap((void *)source->data, source->s_data);
+  else if (source->owned)
+    free((void *)source->data);
+  free((char *)source->name);
+  free(source->line_starts);
+  source->name = source->data = NULL;
+  source->line_starts = NULL;
+  source->live = false;
+
+  // Give the location space back when releasing the most recent sources
+  for (; s_goc_sources > 0 && !goc_sources[s_goc_sources - 1].live; s_goc_sources--)
+    goc_source_next_base = goc_sources[s_goc_sources - 1].base;
+}
+
+SourceLoc goc_source_loc(SourceId id, size_t offset) {
+  struct goc_source_file *source = _goc_source_get(id);
+  if (source == NULL || offset > source->s_data)
+    return GOC_SOURCE_LOC_INVALID;
+  return source->base + (SourceLoc)offset;
+}
+
+SourceId goc_source_loc_id(SourceLoc loc) {
+  if (loc == GOC_SOURCE_LOC_INVALID || s_goc_sources == 0)
+    return GOC_SOURCE_ID_INVALID;
+  size_t lo = 0,
+         hi = s_goc_sources;
+  while (hi - lo > 1) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (goc_sources[mid].base <= loc)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  struct goc_source_file *source = &(goc_sources[lo]);
+  if (!source->live || loc < source->base || loc > source->base + source->s_data)
+    return GOC_SOURCE_ID_INVALID;
+  return (SourceId)lo;
+}
+
+size_t goc_source_loc_offset(SourceLoc loc) {
+  struct goc_source_file *source = _goc_source_get(goc_source_loc_id(loc));
+  return source ? (size_t)(loc - source->base) : 0;
+}
+
+size_t goc_source_loc_line(SourceLoc loc) {
+  struct goc_source_file *source = _goc_source_get(goc_source_loc_id(loc));
+  if (source == NULL)
+    return 0;
+  return _goc_source_line_index(source, loc - source->base) + 1;
+}
+
+size_t goc_source_loc_rel(SourceLoc loc) {
+  struct goc_source_file *source = _goc_source_get(goc_source_loc_id(loc));
+  if (source == NULL)
+    return 0;
+  size_t offset = loc - source->base,
+         line   = _goc_source_line_index(source, offset);
+  return offset - _goc_source_lines(source)[line] + 1;
+}
+
+const char *goc_source_get_name(SourceId id) {
+  struct goc_source_file *source = _goc_source_get(id);
+  return source ? source->name : NULL;
+}
+
+const char *goc_source_get_data(SourceId id) {
+  struct goc_source_file *source = _goc_source_get(id);
+  return source ? source->data : NULL;
+}
+
+size_t goc_source_get_size(SourceId id) {
+  struct goc_source_file *source = _goc_source_get(id);
+  return source ? source->s_data : 0;
+}
+
+size_t goc_source_get_line_count(SourceId id) {
+  struct goc_source_file *source = _goc_source_get(id);
+  if (source == NULL)
+    return 0;
+  (void)_goc_source_lines(source);
+  return source->s_lines;
+}
+
+const char *goc_source_line_text(SourceId id, size_t line, size_t *s_text) {
+  goc_error_assert(goc_error_nullptr, s_text != NULL);
+  *s_text = 0;
+  struct goc_source_file *source = _goc_source_get(id);
+  if (source == NULL || line == 0)
+    return NULL;
+  const uint32_t *line_starts = _goc_source_lines(source);
+  if (line > source->s_lines)
+    return NULL;
+  size_t start = line_starts[line - 1],
+         end   = line < source->s_lines ? line_starts[line] - 1 : source->s_data;
+  *s_text = end - start;
+  return source->data + start;
+}
@@ -0,0 +1,87 @@
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "goc_writer.h"
+
+// ==========================================================# PUBLIC #================================================================
+
+Writer goc_writer_create(int fd, size_t s_buffer) {
+  goc_error_assert(goc_error_inval_arg, fd >= 0);
+  goc_error_assert(goc_error_inval_arg, s_buffer >= GOC_WRITER_NUMBER_MAX);
+
+  Writer writer = (Writer)malloc(sizeof(struct writer));
+  if (writer == NULL)
+    return NULL;
+  writer->data = (char *)malloc(s_buffer);
+  if (writer->data == NULL) {
+    free(writer);
+    return NULL;
+  }
+  writer->fd = fd;
+  writer->s_data = 0;
+  writer->s_buffer = s_buffer;
+  return writer;
+}
+
+void goc_writer_flush(Writer writer) {
+  goc_error_assert(goc_error_nullptr, writer != NULL);
+  goc_writer_write(writer->fd, writer->data, writer->s_data);
+  writer->s_data = 0;
+}
+
+void goc_writer_free(Writer writer) {
+  if (writer == NULL)
+    return;
+  goc_writer_flush(writer);
+  free(writer->data);
+  free(writer);
+}
+
+void goc_writer_write(int fd, const char *data, size_t s_data) {
+  goc_error_assert(goc_error_nullptr, data != NULL || s_data == 0);
+  while (s_data > 0) {
+    ssize_t s_written = write(fd, data, s_data);
+    if (s_written == -1 && errno == EINTR)
+      continue;
+    goc_error_assert(goc_error_ioerror, s_written > 0);
+    data += s_written;
+    s_data -= (size_t)s_written;
+  }
+}
+
+void goc_writer_fill(Writer writer, char ch, size_t s_fill) {
+  goc_error_assert(goc_error_nullptr, writer != NULL);
+  for (size_t s_chunk; s_fill > 0; s_fill -= s_chunk) {
+    s_chunk = s_fill < writer->s_buffer ? s_fill : writer->s_buffer;
+    goc_writer_reserve(writer, s_chunk);
+    memset(writer->data + writer->s_data, ch, s_chunk);
+    writer->s_data += s_chunk;
+  }
+}
+
+// Runs of characters that need no escaping are copied whole
+void goc_writer_json_string(Writer writer, const char *text, size_t s_text) {
+  static const char hex[] = "0123456789abcdef";
+  goc_error_assert(goc_error_nullptr, writer != NULL);
+  goc_error_assert(goc_error_nullptr, text != NULL || s_text == 0);
+
+  goc_writer_literal(writer, "\"");
+  size_t start = 0;
+  for (size_t pos = 0; pos < s_text; pos++) {
+    unsigned char ch = (unsigned char)text[pos];
+    if (ch >= 0x20 && ch != '"' && ch != '\\')
+      continue;
+    goc_writer_append(writer, text + start, pos - start);
+    char escape[6] = { '\\', 'u', '0', '0', hex[ch >> 4], hex[ch & 0xf] };
+    switch (ch) {
+      case '"': case '\\': escape[1] = (char)ch; goc_writer_append(writer, escape, 2); break;
+      case '\n':           goc_writer_append(writer, "\\n", 2);                       break;
+      case '\t':           goc_writer_append(writer, "\\t", 2);                       break;
+      default:             goc_writer_append(writer, escape, sizeof(escape));          break;
+    }
+    start = pos + 1;
+  }
+  goc_writer_append(writer, text + start, s_text - start);
+  goc_writer_literal(writer, "\"");
+}
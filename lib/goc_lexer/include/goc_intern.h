@@ -0,0 +1,33 @@
+#ifndef GOC_INTERN_H
+#define GOC_INTERN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Global string interner: every distinct string is stored once and named by a stable 32-bit symbol id,
+// so comparing names is an integer compare. Id 0 is never handed out.
+// The global table is not thread-safe. Private InternTables (same ids scheme, ids local to the table) let
+// threads intern on their own and be merged into the global table afterwards.
+
+typedef uint32_t SymbolId;
+typedef struct intern_table *InternTable;
+
+#define GOC_SYMBOL_INVALID ((SymbolId)0)
+
+SymbolId    goc_intern(const char *text, size_t s_text);
+SymbolId    goc_intern_lookup(const char *text, size_t s_text);
+const char *goc_intern_get_text(SymbolId id);
+size_t      goc_intern_get_size(SymbolId id);
+size_t      goc_intern_get_count(void);
+
+InternTable goc_intern_table_create(void);
+void        goc_intern_table_free(InternTable table);
+SymbolId    goc_intern_table_add(InternTable table, const char *text, size_t s_text);
+SymbolId    goc_intern_table_lookup(InternTable table, const char *text, size_t s_text);
+const char *goc_intern_table_get_text(InternTable table, SymbolId id);
+size_t      goc_intern_table_get_size(InternTable table, SymbolId id);
+size_t      goc_intern_table_get_count(InternTable table);
+
+#endif // !GOC_INTERN_H
@@ -3,6 +3,11 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+#include "goc_source.h"
+#include "goc_intern.h"
+#include "goc_diagnostic.h"
 
 typedef enum token_type {
   TT_BEGIN = 0,
@@ -69,23 +74,63 @@ typedef enum token_type {
   TT_EOF
 } TokenType;
 
-typedef struct token       *Token;
 typedef struct token_array *TokenArray;
+typedef struct lexer_stream *LexerStream;
+
+// Instruction set of the SIMD lexer's classification stage, AUTO picks the best one the CPU supports
+typedef enum lexer_simd_isa {
+  LEXER_SIMD_AUTO = 0,
+  LEXER_SIMD_SCALAR,
+  LEXER_SIMD_SSE2,
+  LEXER_SIMD_AVX2
+} LexerSimdIsa;
+
+// Tokens are stored column-wise in their TokenArray, a Token is a handle (array, index) into it
+typedef struct token {
+  TokenArray array;
+  size_t     index;
+} Token;
+
+// Zero-copy view into the lexed source, valid while its TokenArray is alive (not NUL-terminated)
+typedef struct token_text {
+  const char *text;
+  size_t      s_text;
+} TokenText;
 
 TokenArray      goc_lexer(const char *file);
+TokenArray      goc_lexer_from_buffer(const char *buffer, size_t s_buffer); // buffer must outlive the TokenArray
+TokenArray      goc_lexer_simd(const char *file, LexerSimdIsa isa);
+TokenArray      goc_lexer_simd_from_buffer(const char *buffer, size_t s_buffer, LexerSimdIsa isa);
+TokenArray      goc_lexer_parallel(const char *file, uint32_t s_threads); // 0 threads: one per online core
+TokenArray      goc_lexer_parallel_from_buffer(const char *buffer, size_t s_buffer, uint32_t s_threads);
+
+// Pull-based lexing of any readable fd (file, pipe, stdin) through a fixed-size input buffer. The Token from
+// goc_lexer_next, its text included, is only valid until the next call, and has no SourceLoc: its position
+// is tracked by the stream. The fd is not closed by goc_lexer_close.
+LexerStream     goc_lexer_open(int fd, const char *name);
+Token           goc_lexer_next(LexerStream stream);
+void            goc_lexer_close(LexerStream stream);
+Diagnostics     goc_lexer_stream_get_diagnostics(LexerStream stream);
+
+// Lexing errors do not stop the lexer: the offending text becomes a TT_UNKNOWN token, the error is recorded in
+// the diagnostics of the TokenArray (or stream) and lexing resumes right after it, so one pass reports them all.
 Token           goc_lexer_token_array_at(TokenArray token_array, size_t index);
 size_t          goc_lexer_token_array_get_size(TokenArray token_array);
+Diagnostics     goc_lexer_token_array_get_diagnostics(TokenArray token_array);
 void            goc_lexer_token_array_free(TokenArray token_array);
 
 const TokenType goc_lexer_token_get_token_type(Token token);
+const SourceLoc goc_lexer_token_get_loc(Token token);
 const size_t    goc_lexer_token_get_pos_abs(Token token); 
 const size_t    goc_lexer_token_get_pos_line(Token token); 
 const size_t    goc_lexer_token_get_pos_rel(Token token); 
 const size_t    goc_lexer_token_get_pos_s_word(Token token); 
 int64_t         goc_lexer_token_get_value_number_literal(Token token);
 double          goc_lexer_token_get_value_real_literal(Token token);
-char           *goc_lexer_token_get_value_text(Token token);
+TokenText       goc_lexer_token_get_value_text(Token token);
+SymbolId        goc_lexer_token_get_symbol(Token token);
 
-const char     *goc_lexer_token_to_str(Token token);
+const char     *goc_lexer_token_type_to_str(TokenType type);
+const char     *goc_lexer_token_to_str(Token token); // debug view, to be freed by the caller, see goc_lexer_dump.h
 
 #endif // !GOC_LEXER_H
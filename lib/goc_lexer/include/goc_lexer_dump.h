@@ -0,0 +1,40 @@
+#ifndef GOC_LEXER_DUMP_H
+#define GOC_LEXER_DUMP_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "goc_lexer.h"
+
+// Token dump writer. Tokens are formatted straight into one reusable output buffer, which is written to the fd
+// whenever it fills up and on goc_lexer_dump_flush / goc_lexer_dump_free. The fd is not closed.
+//
+// TEXT    one line per token, "line:rel TYPE value", colored only when the fd is a terminal
+// NDJSON  one JSON object per line: {"type", "abs", "line", "rel", "s_word"} plus "text" for identifiers, string
+//         and char literals, "value" for number and real literals (null when not finite)
+// BINARY  the LEXER_DUMP_MAGIC header and LEXER_DUMP_VERSION (u32), then a LEXER_DUMP_RECORD_SIZE byte record per
+//         token: u8 type, 3 zero bytes, u32 abs, u32 line, u32 rel, u32 s_word, u64 value (the number literal,
+//         the bits of the real literal, 0 otherwise). Identifiers, string and char literals are followed by the
+//         s_word bytes of their text. Integers are little-endian.
+
+typedef struct lexer_dump *LexerDump;
+
+typedef enum lexer_dump_format {
+  LEXER_DUMP_TEXT = 0,
+  LEXER_DUMP_NDJSON,
+  LEXER_DUMP_BINARY
+} LexerDumpFormat;
+
+#define LEXER_DUMP_MAGIC       "GOCT"
+#define LEXER_DUMP_VERSION     1
+#define LEXER_DUMP_RECORD_SIZE 28
+
+LexerDump goc_lexer_dump_create(int fd, LexerDumpFormat format);
+void      goc_lexer_dump_token(LexerDump dump, Token token);
+void      goc_lexer_dump_tokens(LexerDump dump, TokenArray tokens);
+void      goc_lexer_dump_flush(LexerDump dump);
+void      goc_lexer_dump_free(LexerDump dump);
+
+#endif // !GOC_LEXER_DUMP_H
@@ -0,0 +1,194 @@
+#ifndef GOC_LEXER_INLINE_H
+#define GOC_LEXER_INLINE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "goc_error.h"
+#include "goc_lexer.h"
+
+// Optional inline access to the tokens of a TokenArray, for hot loops such as the parser's. The column layout below
+// is part of the API: a TokenArray starts with its struct token_columns. The accessors read the same fields as the
+// goc_lexer_token_get_* functions but compile to a few loads, checked as internal invariants (not at all in
+// GOC_CHECK_OFF builds). Positions and text need goc_source or the stream, they stay with the out-of-line functions.
+
+#define goc_lexer_inline_check(condition) goc_error_check(goc_error_inval_arg, condition)
+
+#define TOKEN_SEGMENTS_MAX 32
+
+union token_value {
+  int64_t  num_lit;
+  double   real_lit;
+  SymbolId symbol;
+};
+
+// Columns of one segment of a TokenArray
+struct token_segment {
+  uint8_t   *types;
+  SourceLoc *locs;
+  uint32_t  *lengths,
+            *values;
+};
+
+// Struct of arrays, one column per token field. Identifiers and literals are (loc, length) spans into the source.
+// values[i] holds the interned symbol of identifiers and string literals, and for numeric literals the index of
+// their value in the literals side table. Segment k holds 2^(segment_shift + k) tokens and starts at token
+// (2^k - 1) << segment_shift, so a full segment is never moved and a token index maps to its segment in O(1).
+// tail_start / tail_end are the bounds of the last segment, the literals side table is split the same way.
+struct token_columns {
+  struct token_segment  segments[TOKEN_SEGMENTS_MAX];
+  size_t                s_tokens,
+                        s_segments,
+                        tail_start,
+                        tail_end;
+  uint8_t               segment_shift;
+
+  union token_value    *literals[TOKEN_SEGMENTS_MAX];
+  size_t                s_literals,
+                        s_literal_segments,
+                        literal_tail_start,
+                        literal_tail_end;
+  uint8_t               literal_shift;
+};
+
+// Forward cursor over a TokenArray (not the one of a LexerStream). The segment of the current token is cached, so
+// peeking and advancing within it is a compare and a load. The last token, TT_EOF, is never stepped past.
+typedef struct token_cursor {
+  TokenArray                  array;
+  const struct token_segment *segment;
+  size_t                      index,
+                              s_tokens,
+                              segment_start,
+                              segment_end;
+} TokenCursor;
+
+static inline const struct token_columns *goc_lexer_inline_columns(TokenArray token_array) {
+  return (const struct token_columns *)token_array;
+}
+
+// Segment k starts at (2^k - 1) << shift, so index >> shift, plus one, has its highest bit at position k
+static inline size_t goc_lexer_inline_locate(size_t index, uint8_t shift, size_t *offset) {
+  size_t segment = (size_t)(63 - __builtin_clzll((index >> shift) + 1));
+  *offset = index - ((((size_t)1 << segment) - 1) << shift);
+  return segment;
+}
+
+static inline const struct token_segment *goc_lexer_inline_segment(Token token, size_t *offset) {
+  goc_lexer_inline_check(token.array != NULL);
+  const struct token_columns *columns = goc_lexer_inline_columns(token.array);
+  goc_lexer_inline_check(token.index < columns->s_tokens);
+  return &(columns->segments[goc_lexer_inline_locate(token.index, columns->segment_shift, offset)]);
+}
+
+static inline const union token_value *goc_lexer_inline_literal(TokenArray token_array, uint32_t literal) {
+  const struct token_columns *columns = goc_lexer_inline_columns(token_array);
+  size_t offset;
+  size_t segment = goc_lexer_inline_locate(literal, columns->literal_shift, &offset);
+  return &(columns->literals[segment][offset]);
+}
+
+static inline size_t goc_lexer_inline_size(TokenArray token_array) {
+  goc_lexer_inline_check(token_array != NULL);
+  return goc_lexer_inline_columns(token_array)->s_tokens;
+}
+
+static inline Token goc_lexer_inline_at(TokenArray token_array, size_t index) {
+  goc_lexer_inline_check(index < goc_lexer_inline_size(token_array));
+  return (Token){ token_array, index };
+}
+
+static inline TokenType goc_lexer_inline_type(Token token) {
+  size_t offset;
+  return (TokenType)goc_lexer_inline_segment(token, &offset)->types[offset];
+}
+
+static inline SourceLoc goc_lexer_inline_loc(Token token) {
+  size_t offset;
+  return goc_lexer_inline_segment(token, &offset)->locs[offset];
+}
+
+static inline size_t goc_lexer_inline_s_word(Token token) {
+  size_t offset;
+  return goc_lexer_inline_segment(token, &offset)->lengths[offset];
+}
+
+static inline SymbolId goc_lexer_inline_symbol(Token token) {
+  size_t offset;
+  const struct token_segment *segment = goc_lexer_inline_segment(token, &offset);
+  TokenType type = (TokenType)segment->types[offset];
+  return (type == TT_IDENT || type == TT_STRING_LIT) ? segment->values[offset] : GOC_SYMBOL_INVALID;
+}
+
+static inline int64_t goc_lexer_inline_number_literal(Token token) {
+  size_t offset;
+  const struct token_segment *segment = goc_lexer_inline_segment(token, &offset);
+  if (segment->types[offset] != TT_NUM_LIT)
+    return 0;
+  return goc_lexer_inline_literal(token.array, segment->values[offset])->num_lit;
+}
+
+static inline double goc_lexer_inline_real_literal(Token token) {
+  size_t offset;
+  const struct token_segment *segment = goc_lexer_inline_segment(token, &offset);
+  if (segment->types[offset] != TT_REAL_LIT)
+    return 0;
+  return goc_lexer_inline_literal(token.array, segment->values[offset])->real_lit;
+}
+
+static inline void goc_lexer_cursor_seek(TokenCursor *cursor, size_t index) {
+  goc_lexer_inline_check(cursor != NULL && index < cursor->s_tokens);
+  uint8_t shift = goc_lexer_inline_columns(cursor->array)->segment_shift;
+  size_t offset;
+  size_t segment = goc_lexer_inline_locate(index, shift, &offset);
+  cursor->segment = &(goc_lexer_inline_columns(cursor->array)->segments[segment]);
+  cursor->index = index;
+  cursor->segment_start = index - offset;
+  cursor->segment_end = cursor->segment_start + ((size_t)1 << (shift + segment));
+}
+
+static inline TokenCursor goc_lexer_cursor_create(TokenArray token_array) {
+  TokenCursor cursor = { token_array, NULL, 0, goc_lexer_inline_size(token_array), 0, 0 };
+  goc_lexer_inline_check(cursor.s_tokens > 0);
+  goc_lexer_cursor_seek(&cursor, 0);
+  return cursor;
+}
+
+static inline Token goc_lexer_cursor_token(const TokenCursor *cursor) {
+  return (Token){ cursor->array, cursor->index };
+}
+
+static inline TokenType goc_lexer_cursor_type(const TokenCursor *cursor) {
+  return (TokenType)cursor->segment->types[cursor->index - cursor->segment_start];
+}
+
+// Type of the token k places ahead, TT_EOF past the end
+static inline TokenType goc_lexer_cursor_peek(const TokenCursor *cursor, size_t k) {
+  size_t index = cursor->index + k;
+  if (index < cursor->segment_end && index < cursor->s_tokens)
+    return (TokenType)cursor->segment->types[index - cursor->segment_start];
+  if (index >= cursor->s_tokens)
+    return TT_EOF;
+  return goc_lexer_inline_type((Token){ cursor->array, index });
+}
+
+// Returns the current token and moves to the next one
+static inline Token goc_lexer_cursor_advance(TokenCursor *cursor) {
+  Token token = goc_lexer_cursor_token(cursor);
+  if (cursor->index + 1 < cursor->s_tokens && ++cursor->index >= cursor->segment_end)
+    goc_lexer_cursor_seek(cursor, cursor->index);
+  return token;
+}
+
+// Consumes the current token, into token if not NULL, when it is of the given type. Reporting is left to the caller.
+static inline bool goc_lexer_cursor_expect(TokenCursor *cursor, TokenType type, Token *token) {
+  if (goc_lexer_cursor_type(cursor) != type)
+    return false;
+  Token current = goc_lexer_cursor_advance(cursor);
+  if (token != NULL)
+    *token = current;
+  return true;
+}
+
+#endif // !GOC_LEXER_INLINE_H
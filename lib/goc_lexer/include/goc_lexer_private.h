@@ -7,10 +7,20 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdint.h>
-#include <ctype.h>
 #include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 #include "goc_error.h"
+#include "goc_arena.h"
+#include "goc_source.h"
+#include "goc_intern.h"
+#include "goc_number.h"
+#include "goc_utf8.h"
+#include "goc_lexer_simd.h"
+#include "goc_lexer_inline.h"
 
 // ====# FILE MODE #====
 
@@ -37,6 +47,8 @@
 #define CHAR_COLON      ':'
 #define CHAR_QUOTE      '"'
 #define CHAR_APOST      39
+#define CHAR_BACKTICK   '`'
+#define CHAR_BACKSLASH  '\\'
 #define CHAR_AMPER      '&'
 #define CHAR_BAR        '|'
 #define CHAR_QUESTMARK  '?'
@@ -56,7 +68,6 @@
 #define CHAR_LTHAN      '<'
 
 #define CHAR_ZERO       '0'
-#define CHAR_HEXA       'x'
 
 // ====# KEYWORDS #====
 
@@ -109,120 +120,413 @@
 #define KEYWORD_FOR     "for"
 #define KEYWORD_RANGE   "range"
 
-// =======# BASE #========
-
-#define BASE_02         2
-#define BASE_10         10
-#define BASE_16         16
+#define KEYWORD_MIN_SIZE 2
+#define KEYWORD_MAX_SIZE 9
+#define KEYWORD_SLOTS    128
+
+// Perfect hash over (first char, last char, length) of every keyword, collision free for the set above
+#define goc_lexer_keyword_hash(first, last, s_word) \
+  (((size_t)(unsigned char)(first) + 4 * (size_t)(unsigned char)(last) + 33 * (size_t)(s_word)) & (KEYWORD_SLOTS - 1))
+
+// ====# CHARACTER CLASSES #====
+
+// Class of every byte, read from goc_lexer_char_classes instead of the locale dependent <ctype.h>. Each
+// operator character has its own class, the classes are the columns of goc_lexer_operator_dfa.
+typedef enum lexer_char_class {
+  LEXER_CLASS_OTHER = 0,
+  LEXER_CLASS_WSPACE,
+  LEXER_CLASS_ALPHA,     // letters but the hex digits
+  LEXER_CLASS_HEX_ALPHA, // a-f, A-F
+  LEXER_CLASS_UNDER,
+  LEXER_CLASS_DIGIT,
+  LEXER_CLASS_QUOTE,     // '"' and '`', the string delimiters
+  LEXER_CLASS_APOST,
+  LEXER_CLASS_PERIOD,
+
+  LEXER_CLASS_LBRACE, LEXER_CLASS_RBRACE,
+  LEXER_CLASS_LPAREN, LEXER_CLASS_RPAREN,
+  LEXER_CLASS_LSQPAREN, LEXER_CLASS_RSQPAREN,
+  LEXER_CLASS_SEMICOLON, LEXER_CLASS_COMMA, LEXER_CLASS_QUESTMARK, LEXER_CLASS_COLON,
+  LEXER_CLASS_TIL, LEXER_CLASS_BANG, LEXER_CLASS_HAT, LEXER_CLASS_AMPER, LEXER_CLASS_BAR,
+  LEXER_CLASS_STAR, LEXER_CLASS_SLASH, LEXER_CLASS_PERCENT, LEXER_CLASS_PLUS, LEXER_CLASS_MINUS,
+  LEXER_CLASS_EQUAL, LEXER_CLASS_LTHAN, LEXER_CLASS_GTHAN,
+
+  LEXER_CLASS_COUNT
+} LexerCharClass;
+
+// Sets of classes as bitmasks, LEXER_CLASS_COUNT fits in 32 bits
+#define LEXER_CLASS_BIT(class)     (1u << (class))
+#define LEXER_CLASSES_IDENT        (LEXER_CLASS_BIT(LEXER_CLASS_ALPHA) | LEXER_CLASS_BIT(LEXER_CLASS_HEX_ALPHA) | LEXER_CLASS_BIT(LEXER_CLASS_UNDER))
+#define LEXER_CLASSES_IDENT_MIDDLE (LEXER_CLASSES_IDENT | LEXER_CLASS_BIT(LEXER_CLASS_DIGIT))
+
+#define goc_lexer_char_class(ch)       ((LexerCharClass)goc_lexer_char_classes[(unsigned char)(ch)])
+#define goc_lexer_char_in(ch, classes) ((LEXER_CLASS_BIT(goc_lexer_char_class(ch)) & (classes)) != 0)
 
 // =====# CONSTANTS #=====
 
 #define TOKEN_TEXT_MAX_SIZE 255
-#define TOKEN_MAX_PEEK      8
 #define TOKEN_VALUE_NIL     "nil"
 
-static const size_t token_size_init = 1024;
-static const size_t token_text_max_size = 255;
-static const size_t token_str_max_size = 255;
-
-struct token_pos {
-  size_t line, rel, abs, s_word;
+#define GOC_LEXER_STREAM_NAME "<stream>"
+
+static const size_t token_bytes_estimate = 4;
+static const size_t token_literals_ratio = 16;
+static const size_t token_str_max_size = 512;
+static const size_t lexer_chunk_size_min = 256 * 1024;
+static const size_t lexer_chunks_per_thread = 4;
+static const size_t lexer_stream_size = 64 * 1024;
+static const size_t lexer_stream_lookahead = 1024;
+
+// Whole source held in memory, scanned by cursor. start is the offset of the token being scanned, source its
+// id in the goc_source registry, which owns the data of loaded files. symbols is where identifiers and string
+// literals are interned, NULL for the global table. stream is set when data is the window of a LexerStream.
+// scratch is where string literals with escapes are decoded before being interned, grown to the longest one.
+struct lexer_buffer {
+  const char          *data;
+  size_t               s_data,
+                       cursor,
+                       start;
+  SourceId             source;
+  InternTable          symbols;
+  struct lexer_stream *stream;
+  char                *scratch;
+  size_t               s_scratch;
+  Diagnostics          diagnostics;
 };
 
-union token_value {
-  int64_t num_lit;
-  double  real_lit;
-  char    text[TOKEN_TEXT_MAX_SIZE];
+// Token columns first (their layout is public, see goc_lexer_inline.h), then what only the lexer uses.
+// Line and column are not stored, goc_source computes them from the loc when asked. Segments are allocated
+// from arena, which also holds the struct itself.
+struct token_array {
+  struct token_columns  columns;
+  Arena                 arena;
+  struct lexer_buffer   source;
+  struct lexer_stream  *stream;
+  Diagnostics           diagnostics;
 };
 
-struct token {
-  enum token_type   type;
-  struct token_pos  pos;
-  union token_value value;
+// Pull lexer over an fd. ring holds a window of the input, compacted and refilled as the cursor moves, so
+// memory stays bounded whatever the input size. offset is the input offset of ring[0]. Lines are counted
+// up to ring[scan] only, line_start being the input offset where that line starts. tokens holds the one
+// token goc_lexer_next hands out, which starts at input offset token_pos.
+struct lexer_stream {
+  struct lexer_buffer buffer;
+  char               *ring,
+                     *name;
+  int                 fd;
+  bool                eof;
+  size_t              s_ring,
+                      offset,
+                      scan,
+                      line,
+                      line_start,
+                      token_pos;
+  TokenArray          tokens;
 };
 
-struct token_array {
-  Token tokens;
-  size_t s_tokens;
+// One entry per TokenType: its name, and for keyword types their spelling (plus an alias, int for int32)
+struct token_type_info {
+  const char *name,
+             *keyword,
+             *alias;
+  uint8_t     s_keyword,
+              s_alias;
 };
 
-static TokenArray  goc_lexer_token_array_create(size_t s_tokens);
-
-static TokenType   goc_lexer_get_token(FILE *file, struct token_pos *global, struct token_pos *pos, union token_value *value);
-static const char *goc_lexer_token_type_match_str(TokenType type);
-
-static void        goc_lexer_update_token_pos(struct token_pos *global, struct token_pos *pos, const char ch);
-static char        goc_lexer_peek(FILE *file);
-static char        goc_lexer_peek_n(FILE *file, uint32_t n);
-static char        goc_lexer_consume( FILE *file, struct token_pos *global, struct token_pos *pos);
-static void        goc_lexer_unconsume_char(FILE *file, struct token_pos *global, struct token_pos *pos, const char ch);
-static char        goc_lexer_consume_wspace(FILE *file, struct token_pos *global, struct token_pos *pos);
-static bool        goc_lexer_consume_char(FILE *file, struct token_pos *global, struct token_pos *pos, const char ch);
-static char        goc_lexer_consume_comment(FILE *file, struct token_pos *global, struct token_pos *pos, char ch);
-static TokenType   goc_lexer_consume_number(FILE *file, struct token_pos *global, struct token_pos *pos, union token_value *value);
-static TokenType   goc_lexer_consume_string_lit(
-  FILE *file, struct token_pos *global, struct token_pos *pos, union token_value *value, char ch
-);
-static TokenType   goc_lexer_consume_char_lit(
-  FILE *file, struct token_pos *global, struct token_pos *pos, union token_value *value, char ch
-);
-
-static uint32_t    goc_lexer_base_convert(FILE *file, struct token_pos *pos, char ch, uint32_t base);
-static bool        goc_lexer_base_alpha(char ch);
-
-static bool        goc_lexer_comment_block_end(char ch, char next);
-
-static bool        goc_lexer_ident(char ch);
-static bool        goc_lexer_ident_middle(char ch);
-static bool        goc_lexer_skip(char ch);
-
-static bool        goc_lexer_package(char *word);
-static bool        goc_lexer_import(char *word);
-static bool        goc_lexer_typedef(char *word);
+#define TOKEN_TYPE(type)                       [type] = { #type, NULL, NULL, 0, 0 }
+#define TOKEN_KEYWORD(type, keyword)           [type] = { #type, keyword, NULL, sizeof(keyword) - 1, 0 }
+#define TOKEN_KEYWORD_ALIAS(type, keyword, alias) \
+  [type] = { #type, keyword, alias, sizeof(keyword) - 1, sizeof(alias) - 1 }
+
+static const struct token_type_info goc_lexer_token_types[TT_EOF + 1] = {
+  TOKEN_TYPE(TT_UNKNOWN),
+
+  TOKEN_TYPE(TT_STRING_LIT), TOKEN_TYPE(TT_CHAR_LIT),
+  TOKEN_KEYWORD(TT_TRUE_LIT, KEYWORD_TRUE), TOKEN_KEYWORD(TT_FALSE_LIT, KEYWORD_FALSE),
+
+  TOKEN_TYPE(TT_NUM_LIT), TOKEN_TYPE(TT_REAL_LIT),
+  TOKEN_KEYWORD(TT_INT8, KEYWORD_INT8), TOKEN_KEYWORD(TT_INT16, KEYWORD_INT16),
+  TOKEN_KEYWORD_ALIAS(TT_INT32, KEYWORD_INT32, KEYWORD_INT), TOKEN_KEYWORD(TT_INT64, KEYWORD_INT64),
+  TOKEN_KEYWORD(TT_UINT8, KEYWORD_UINT8), TOKEN_KEYWORD(TT_UINT16, KEYWORD_UINT16),
+  TOKEN_KEYWORD_ALIAS(TT_UINT32, KEYWORD_UINT32, KEYWORD_UINT), TOKEN_KEYWORD(TT_UINT64, KEYWORD_UINT64),
+  TOKEN_KEYWORD(TT_FLOAT, KEYWORD_FLOAT), TOKEN_KEYWORD(TT_DOUBLE, KEYWORD_DOUBLE),
+  TOKEN_KEYWORD(TT_CHAR, KEYWORD_CHAR), TOKEN_KEYWORD(TT_STRING, KEYWORD_STRING),
+  TOKEN_KEYWORD(TT_BOOL, KEYWORD_BOOL),
+
+  TOKEN_KEYWORD(TT_IF, KEYWORD_IF), TOKEN_KEYWORD(TT_ELSE, KEYWORD_ELSE),
+  TOKEN_KEYWORD(TT_SWITCH, KEYWORD_SWITCH), TOKEN_KEYWORD(TT_CASE, KEYWORD_CASE),
+  TOKEN_KEYWORD(TT_WHILE, KEYWORD_WHILE), TOKEN_KEYWORD(TT_FOR, KEYWORD_FOR), TOKEN_KEYWORD(TT_DO, KEYWORD_DO),
+  TOKEN_TYPE(TT_NULL_ITERATOR), TOKEN_KEYWORD(TT_RANGE, KEYWORD_RANGE),
+
+  TOKEN_KEYWORD(TT_PACKAGE, KEYWORD_PACKAGE),
+  TOKEN_KEYWORD(TT_IMPORT, KEYWORD_IMPORT),
+  TOKEN_KEYWORD(TT_TYPE, KEYWORD_TYPE),
+
+  TOKEN_KEYWORD(TT_FUNC, KEYWORD_FUNC),
+  TOKEN_KEYWORD(TT_STRUCT, KEYWORD_STRUCT),
+  TOKEN_KEYWORD(TT_INTERFACE, KEYWORD_INTER),
+  TOKEN_KEYWORD(TT_ENUM, KEYWORD_ENUM),
+  TOKEN_KEYWORD(TT_UNION, KEYWORD_UNION),
+
+  TOKEN_KEYWORD(TT_NIL, KEYWORD_NIL),
+  TOKEN_KEYWORD(TT_IOTA, KEYWORD_IOTA),
+  TOKEN_KEYWORD(TT_RETURN, KEYWORD_RETURN),
+  TOKEN_KEYWORD(TT_VAR, KEYWORD_VAR),
+  TOKEN_KEYWORD(TT_CONST, KEYWORD_CONST),
+  TOKEN_TYPE(TT_IDENT),
+
+  TOKEN_TYPE(TT_LBRACE), TOKEN_TYPE(TT_RBRACE),
+  TOKEN_TYPE(TT_LPAREN), TOKEN_TYPE(TT_RPAREN),
+  TOKEN_TYPE(TT_LSQPAREN), TOKEN_TYPE(TT_RSQPAREN),
+
+  TOKEN_TYPE(TT_SEMICOLON), TOKEN_TYPE(TT_COMMA), TOKEN_TYPE(TT_QUESTMARK),
+  TOKEN_TYPE(TT_COLON), TOKEN_TYPE(TT_PERIOD),
+
+  TOKEN_TYPE(TT_PLUS), TOKEN_TYPE(TT_MINUS), TOKEN_TYPE(TT_STAR), TOKEN_TYPE(TT_AMPER), TOKEN_TYPE(TT_ARROW),
+  TOKEN_TYPE(TT_UNOP_LOG_NOT), TOKEN_TYPE(TT_UNOP_BIT_NOT),
+  TOKEN_TYPE(TT_UNOP_INCR), TOKEN_TYPE(TT_UNOP_DECR),
+  TOKEN_TYPE(TT_BINOP_ARIT_DIV), TOKEN_TYPE(TT_BINOP_ARIT_MOD),
+  TOKEN_TYPE(TT_BINOP_ARIT_PLUS_EQ), TOKEN_TYPE(TT_BINOP_ARIT_MINUS_EQ), TOKEN_TYPE(TT_BINOP_ARIT_MUL_EQ),
+  TOKEN_TYPE(TT_BINOP_ARIT_DIV_EQ), TOKEN_TYPE(TT_BINOP_ARIT_MOD_EQ),
+  TOKEN_TYPE(TT_BINOP_COMP_EQ), TOKEN_TYPE(TT_BINOP_COMP_NEQ),
+  TOKEN_TYPE(TT_BINOP_COMP_LTHAN), TOKEN_TYPE(TT_BINOP_COMP_GTHAN),
+  TOKEN_TYPE(TT_BINOP_COMP_LTHAN_EQ), TOKEN_TYPE(TT_BINOP_COMP_GTHAN_EQ),
+  TOKEN_TYPE(TT_BINOP_LOG_AND), TOKEN_TYPE(TT_BINOP_LOG_OR),
+  TOKEN_TYPE(TT_BINOP_BIT_AND), TOKEN_TYPE(TT_BINOP_BIT_OR), TOKEN_TYPE(TT_BINOP_BIT_XOR),
+  TOKEN_TYPE(TT_BINOP_BIT_LSHIFT), TOKEN_TYPE(TT_BINOP_BIT_RSHIFT),
+  TOKEN_TYPE(TT_BINOP_BIT_AND_EQ), TOKEN_TYPE(TT_BINOP_BIT_OR_EQ), TOKEN_TYPE(TT_BINOP_BIT_XOR_EQ),
+  TOKEN_TYPE(TT_BINOP_BIT_LSHIFT_EQ), TOKEN_TYPE(TT_BINOP_BIT_RSHIFT_EQ),
+
+  TOKEN_TYPE(TT_ASSIGN), TOKEN_TYPE(TT_AUTO_ASSIGN),
+
+  TOKEN_TYPE(TT_EOF)
+};
 
-static bool        goc_lexer_func(char *word);
-static bool        goc_lexer_struct(char *word);
-static bool        goc_lexer_interface(char *word);
-static bool        goc_lexer_enum(char *word);
-static bool        goc_lexer_union(char *word);
+#define CLASS_LETTER(ch, class) [ch] = class, [(ch) - 'a' + 'A'] = class
+
+// Bytes >= 0x80, control characters and anything the language does not use are LEXER_CLASS_OTHER
+static const uint8_t goc_lexer_char_classes[256] = {
+  [CHAR_WSPACE] = LEXER_CLASS_WSPACE, [CHAR_TAB] = LEXER_CLASS_WSPACE, [CHAR_NEW_LINE] = LEXER_CLASS_WSPACE,
+
+  ['0'] = LEXER_CLASS_DIGIT, ['1'] = LEXER_CLASS_DIGIT, ['2'] = LEXER_CLASS_DIGIT, ['3'] = LEXER_CLASS_DIGIT,
+  ['4'] = LEXER_CLASS_DIGIT, ['5'] = LEXER_CLASS_DIGIT, ['6'] = LEXER_CLASS_DIGIT, ['7'] = LEXER_CLASS_DIGIT,
+  ['8'] = LEXER_CLASS_DIGIT, ['9'] = LEXER_CLASS_DIGIT,
+
+  CLASS_LETTER('a', LEXER_CLASS_HEX_ALPHA), CLASS_LETTER('b', LEXER_CLASS_HEX_ALPHA),
+  CLASS_LETTER('c', LEXER_CLASS_HEX_ALPHA), CLASS_LETTER('d', LEXER_CLASS_HEX_ALPHA),
+  CLASS_LETTER('e', LEXER_CLASS_HEX_ALPHA), CLASS_LETTER('f', LEXER_CLASS_HEX_ALPHA),
+  CLASS_LETTER('g', LEXER_CLASS_ALPHA), CLASS_LETTER('h', LEXER_CLASS_ALPHA), CLASS_LETTER('i', LEXER_CLASS_ALPHA),
+  CLASS_LETTER('j', LEXER_CLASS_ALPHA), CLASS_LETTER('k', LEXER_CLASS_ALPHA), CLASS_LETTER('l', LEXER_CLASS_ALPHA),
+  CLASS_LETTER('m', LEXER_CLASS_ALPHA), CLASS_LETTER('n', LEXER_CLASS_ALPHA), CLASS_LETTER('o', LEXER_CLASS_ALPHA),
+  CLASS_LETTER('p', LEXER_CLASS_ALPHA), CLASS_LETTER('q', LEXER_CLASS_ALPHA), CLASS_LETTER('r', LEXER_CLASS_ALPHA),
+  CLASS_LETTER('s', LEXER_CLASS_ALPHA), CLASS_LETTER('t', LEXER_CLASS_ALPHA), CLASS_LETTER('u', LEXER_CLASS_ALPHA),
+  CLASS_LETTER('v', LEXER_CLASS_ALPHA), CLASS_LETTER('w', LEXER_CLASS_ALPHA), CLASS_LETTER('x', LEXER_CLASS_ALPHA),
+  CLASS_LETTER('y', LEXER_CLASS_ALPHA), CLASS_LETTER('z', LEXER_CLASS_ALPHA),
+  [CHAR_UNDER] = LEXER_CLASS_UNDER,
+
+  [CHAR_QUOTE] = LEXER_CLASS_QUOTE, [CHAR_BACKTICK] = LEXER_CLASS_QUOTE, [CHAR_APOST] = LEXER_CLASS_APOST, [CHAR_PERIOD] = LEXER_CLASS_PERIOD,
+
+  [CHAR_LBRACE] = LEXER_CLASS_LBRACE, [CHAR_RBRACE] = LEXER_CLASS_RBRACE,
+  [CHAR_LPAREN] = LEXER_CLASS_LPAREN, [CHAR_RPAREN] = LEXER_CLASS_RPAREN,
+  [CHAR_LSQPAREN] = LEXER_CLASS_LSQPAREN, [CHAR_RSQPAREN] = LEXER_CLASS_RSQPAREN,
+  [CHAR_SEMICOLON] = LEXER_CLASS_SEMICOLON, [CHAR_COMMA] = LEXER_CLASS_COMMA,
+  [CHAR_QUESTMARK] = LEXER_CLASS_QUESTMARK, [CHAR_COLON] = LEXER_CLASS_COLON,
+  [CHAR_TIL] = LEXER_CLASS_TIL, [CHAR_BANG] = LEXER_CLASS_BANG, [CHAR_HAT] = LEXER_CLASS_HAT,
+  [CHAR_AMPER] = LEXER_CLASS_AMPER, [CHAR_BAR] = LEXER_CLASS_BAR,
+  [CHAR_STAR] = LEXER_CLASS_STAR, [CHAR_SLASH] = LEXER_CLASS_SLASH, [CHAR_PERCENT] = LEXER_CLASS_PERCENT,
+  [CHAR_PLUS] = LEXER_CLASS_PLUS, [CHAR_MINUS] = LEXER_CLASS_MINUS,
+  [CHAR_EQUAL] = LEXER_CLASS_EQUAL, [CHAR_LTHAN] = LEXER_CLASS_LTHAN, [CHAR_GTHAN] = LEXER_CLASS_GTHAN,
+};
 
-static bool        goc_lexer_nil(char *word);
-static bool        goc_lexer_iota(char *word);
-static bool        goc_lexer_return(char *word);
-static bool        goc_lexer_var(char *word);
-static bool        goc_lexer_const(char *word);
+#undef CLASS_LETTER
+
+// Operator DFA. Every prefix of an operator is an operator too, so the state after a prefix is the TokenType
+// it lexes to on its own, TT_BEGIN being the start state. A row maps the class of the next byte to the next
+// state, TT_BEGIN (no entry) ends the operator at the current state.
+static const uint8_t goc_lexer_operator_dfa[TT_EOF + 1][LEXER_CLASS_COUNT] = {
+  [TT_BEGIN] = {
+    [LEXER_CLASS_LBRACE]    = TT_LBRACE,          [LEXER_CLASS_RBRACE]   = TT_RBRACE,
+    [LEXER_CLASS_LPAREN]    = TT_LPAREN,          [LEXER_CLASS_RPAREN]   = TT_RPAREN,
+    [LEXER_CLASS_LSQPAREN]  = TT_LSQPAREN,        [LEXER_CLASS_RSQPAREN] = TT_RSQPAREN,
+    [LEXER_CLASS_SEMICOLON] = TT_SEMICOLON,       [LEXER_CLASS_COMMA]    = TT_COMMA,
+    [LEXER_CLASS_QUESTMARK] = TT_QUESTMARK,       [LEXER_CLASS_COLON]    = TT_COLON,
+    [LEXER_CLASS_PERIOD]    = TT_PERIOD,          [LEXER_CLASS_TIL]      = TT_UNOP_BIT_NOT,
+    [LEXER_CLASS_BANG]      = TT_UNOP_LOG_NOT,    [LEXER_CLASS_HAT]      = TT_BINOP_BIT_XOR,
+    [LEXER_CLASS_AMPER]     = TT_AMPER,           [LEXER_CLASS_BAR]      = TT_BINOP_BIT_OR,
+    [LEXER_CLASS_STAR]      = TT_STAR,            [LEXER_CLASS_SLASH]    = TT_BINOP_ARIT_DIV,
+    [LEXER_CLASS_PERCENT]   = TT_BINOP_ARIT_MOD,  [LEXER_CLASS_PLUS]     = TT_PLUS,
+    [LEXER_CLASS_MINUS]     = TT_MINUS,           [LEXER_CLASS_EQUAL]    = TT_ASSIGN,
+    [LEXER_CLASS_LTHAN]     = TT_BINOP_COMP_LTHAN, [LEXER_CLASS_GTHAN]   = TT_BINOP_COMP_GTHAN,
+  },
+
+  [TT_COLON]             = { [LEXER_CLASS_EQUAL] = TT_AUTO_ASSIGN },
+  [TT_ASSIGN]            = { [LEXER_CLASS_EQUAL] = TT_BINOP_COMP_EQ },
+  [TT_UNOP_LOG_NOT]      = { [LEXER_CLASS_EQUAL] = TT_BINOP_COMP_NEQ },
+  [TT_STAR]              = { [LEXER_CLASS_EQUAL] = TT_BINOP_ARIT_MUL_EQ },
+  [TT_BINOP_ARIT_DIV]    = { [LEXER_CLASS_EQUAL] = TT_BINOP_ARIT_DIV_EQ },
+  [TT_BINOP_ARIT_MOD]    = { [LEXER_CLASS_EQUAL] = TT_BINOP_ARIT_MOD_EQ },
+  [TT_BINOP_BIT_XOR]     = { [LEXER_CLASS_EQUAL] = TT_BINOP_BIT_XOR_EQ },
+  [TT_PLUS]              = { [LEXER_CLASS_PLUS]  = TT_UNOP_INCR,     [LEXER_CLASS_EQUAL] = TT_BINOP_ARIT_PLUS_EQ },
+  [TT_MINUS]             = {
+    [LEXER_CLASS_MINUS] = TT_UNOP_DECR, [LEXER_CLASS_EQUAL] = TT_BINOP_ARIT_MINUS_EQ, [LEXER_CLASS_GTHAN] = TT_ARROW
+  },
+  [TT_AMPER]             = { [LEXER_CLASS_AMPER] = TT_BINOP_LOG_AND, [LEXER_CLASS_EQUAL] = TT_BINOP_BIT_AND_EQ },
+  [TT_BINOP_BIT_OR]      = { [LEXER_CLASS_BAR]   = TT_BINOP_LOG_OR,  [LEXER_CLASS_EQUAL] = TT_BINOP_BIT_OR_EQ },
+  [TT_BINOP_COMP_LTHAN]  = { [LEXER_CLASS_LTHAN] = TT_BINOP_BIT_LSHIFT, [LEXER_CLASS_EQUAL] = TT_BINOP_COMP_LTHAN_EQ },
+  [TT_BINOP_COMP_GTHAN]  = { [LEXER_CLASS_GTHAN] = TT_BINOP_BIT_RSHIFT, [LEXER_CLASS_EQUAL] = TT_BINOP_COMP_GTHAN_EQ },
+  [TT_BINOP_BIT_LSHIFT]  = { [LEXER_CLASS_EQUAL] = TT_BINOP_BIT_LSHIFT_EQ },
+  [TT_BINOP_BIT_RSHIFT]  = { [LEXER_CLASS_EQUAL] = TT_BINOP_BIT_RSHIFT_EQ },
+};
 
-static bool        goc_lexer_int8(char *word);
-static bool        goc_lexer_int16(char *word);
-static bool        goc_lexer_int32(char *word);
-static bool        goc_lexer_int64(char *word);
+// goc_lexer_keyword_hash slot -> keyword TokenType (TT_BEGIN for an empty slot), aliases get their own slot
+static const uint8_t goc_lexer_keyword_slots[KEYWORD_SLOTS] = {
+  [goc_lexer_keyword_hash('p', 'e', 7)] = TT_PACKAGE,
+  [goc_lexer_keyword_hash('i', 't', 6)] = TT_IMPORT,
+  [goc_lexer_keyword_hash('t', 'f', 7)] = TT_TYPE,
+
+  [goc_lexer_keyword_hash('f', 'c', 4)] = TT_FUNC,
+  [goc_lexer_keyword_hash('s', 't', 6)] = TT_STRUCT,
+  [goc_lexer_keyword_hash('i', 'e', 9)] = TT_INTERFACE,
+  [goc_lexer_keyword_hash('e', 'm', 4)] = TT_ENUM,
+  [goc_lexer_keyword_hash('u', 'n', 5)] = TT_UNION,
+
+  [goc_lexer_keyword_hash('n', 'l', 3)] = TT_NIL,
+  [goc_lexer_keyword_hash('i', 'a', 4)] = TT_IOTA,
+  [goc_lexer_keyword_hash('r', 'n', 6)] = TT_RETURN,
+  [goc_lexer_keyword_hash('v', 'r', 3)] = TT_VAR,
+  [goc_lexer_keyword_hash('c', 't', 5)] = TT_CONST,
+
+  [goc_lexer_keyword_hash('i', 't', 3)] = TT_INT32,
+  [goc_lexer_keyword_hash('i', '8', 4)] = TT_INT8,
+  [goc_lexer_keyword_hash('i', '6', 5)] = TT_INT16,
+  [goc_lexer_keyword_hash('i', '2', 5)] = TT_INT32,
+  [goc_lexer_keyword_hash('i', '4', 5)] = TT_INT64,
+
+  [goc_lexer_keyword_hash('u', 't', 4)] = TT_UINT32,
+  [goc_lexer_keyword_hash('u', '8', 5)] = TT_UINT8,
+  [goc_lexer_keyword_hash('u', '6', 6)] = TT_UINT16,
+  [goc_lexer_keyword_hash('u', '2', 6)] = TT_UINT32,
+  [goc_lexer_keyword_hash('u', '4', 6)] = TT_UINT64,
+
+  [goc_lexer_keyword_hash('f', 't', 5)] = TT_FLOAT,
+  [goc_lexer_keyword_hash('d', 'e', 6)] = TT_DOUBLE,
+
+  [goc_lexer_keyword_hash('c', 'r', 4)] = TT_CHAR,
+  [goc_lexer_keyword_hash('s', 'g', 6)] = TT_STRING,
+
+  [goc_lexer_keyword_hash('b', 'l', 4)] = TT_BOOL,
+  [goc_lexer_keyword_hash('t', 'e', 4)] = TT_TRUE_LIT,
+  [goc_lexer_keyword_hash('f', 'e', 5)] = TT_FALSE_LIT,
+
+  [goc_lexer_keyword_hash('i', 'f', 2)] = TT_IF,
+  [goc_lexer_keyword_hash('e', 'e', 4)] = TT_ELSE,
+
+  [goc_lexer_keyword_hash('s', 'h', 6)] = TT_SWITCH,
+  [goc_lexer_keyword_hash('c', 'e', 4)] = TT_CASE,
+
+  [goc_lexer_keyword_hash('d', 'o', 2)] = TT_DO,
+  [goc_lexer_keyword_hash('w', 'e', 5)] = TT_WHILE,
+  [goc_lexer_keyword_hash('f', 'r', 3)] = TT_FOR,
+  [goc_lexer_keyword_hash('r', 'e', 5)] = TT_RANGE,
+};
 
-static bool        goc_lexer_uint8(char *word);
-static bool        goc_lexer_uint16(char *word);
-static bool        goc_lexer_uint32(char *word);
-static bool        goc_lexer_uint64(char *word);
+// Stage one masks of GOC_LEXER_SIMD_WINDOW blocks, base is the index of the first block they cover. Slides
+// forward as the SIMD lexer's cursor leaves it.
+struct lexer_simd_window {
+  LexerSimdIsa isa;
+  size_t       base,
+               s_blocks;
+  uint64_t     masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW];
+};
 
-static bool        goc_lexer_float(char *word);
-static bool        goc_lexer_double(char *word);
+// One slice [start, end) of the source for the parallel lexer, both ends at whitespace outside any literal or
+// comment. Lexed into its own tokens and symbols, then copied at token_offset / literal_offset of the result.
+struct lexer_chunk {
+  size_t      start,
+              end;
+  TokenArray  tokens;
+  InternTable symbols;
+  SymbolId   *symbols_map;
+  size_t      token_offset,
+              literal_offset;
+};
 
-static bool        goc_lexer_char(char *word);
-static bool        goc_lexer_string(char *word);
+// Work shared by the parallel lexer's threads, each takes the next chunk until none is left
+struct lexer_pool {
+  struct lexer_buffer *buffer;
+  TokenArray           tokens;
+  struct lexer_chunk  *chunks;
+  size_t               s_chunks;
+  atomic_size_t        next;
+  SourceLoc            base;
+  LexerSimdIsa         isa;
+};
 
-static bool        goc_lexer_bool(char *word);
-static bool        goc_lexer_true(char *word);
-static bool        goc_lexer_false(char *word);
+static TokenArray  goc_lexer_token_array_create(size_t s_tokens, size_t s_literals);
+static void        goc_lexer_token_array_grow(TokenArray token_array);
+static void        goc_lexer_token_array_grow_literals(TokenArray token_array);
+static inline struct token_segment *goc_lexer_token_array_segment(TokenArray token_array, size_t index, size_t *offset);
+static inline union token_value    *goc_lexer_token_array_literal(TokenArray token_array, uint32_t literal);
+static inline SourceLoc             goc_lexer_token_array_last_loc(TokenArray token_array);
+static void        goc_lexer_token_array_push(
+  TokenArray token_array, TokenType type, SourceLoc loc, size_t length, union token_value *value
+);
+static TokenArray  goc_lexer_tokenize(struct lexer_buffer *buffer, const char *name, struct lexer_simd_window *window);
+static void        goc_lexer_tokenize_range(
+  struct lexer_buffer *buffer, TokenArray tokens, SourceLoc base, struct lexer_simd_window *window
+);
+static TokenArray  goc_lexer_tokenize_parallel(struct lexer_buffer *buffer, const char *name, uint32_t s_threads);
+static size_t      goc_lexer_parallel_split(struct lexer_buffer *buffer, struct lexer_chunk *chunks, size_t s_chunks);
+static void        goc_lexer_parallel_run(struct lexer_pool *pool, uint32_t s_threads, void *worker(void *arg));
+static void       *goc_lexer_parallel_lex(void *arg);
+static void       *goc_lexer_parallel_merge(void *arg);
+
+static void        goc_lexer_stream_fill(struct lexer_stream *stream, size_t s_want);
+static void        goc_lexer_stream_fill_string(struct lexer_stream *stream);
+static void        goc_lexer_stream_skip(struct lexer_stream *stream);
+static void        goc_lexer_stream_count_lines(struct lexer_stream *stream, size_t pos);
+
+static bool        goc_lexer_buffer_load(const char *file_name, struct lexer_buffer *buffer);
+static void        goc_lexer_buffer_unload(struct lexer_buffer *buffer);
+__attribute__((cold))
+static void        goc_lexer_report(struct lexer_buffer *buffer, const char *message, size_t offset);
+
+static SymbolId    goc_lexer_intern(struct lexer_buffer *buffer, const char *text, size_t s_text);
+static TokenType   goc_lexer_get_token(struct lexer_buffer *buffer, union token_value *value);
+static TokenType   goc_lexer_match_token(struct lexer_buffer *buffer, char ch, union token_value *value);
+static TokenType   goc_lexer_get_token_simd(
+  struct lexer_buffer *buffer, struct lexer_simd_window *window, union token_value *value
+);
+static inline size_t goc_lexer_simd_find(
+  struct lexer_buffer *buffer, struct lexer_simd_window *window, LexerSimdMask mask, size_t pos, bool in_class
+);
+static size_t      goc_lexer_simd_find_next(
+  struct lexer_buffer *buffer, struct lexer_simd_window *window, LexerSimdMask mask, size_t pos, bool in_class
+);
 
-static bool        goc_lexer_if(char *word);
-static bool        goc_lexer_else(char *word);
+static char        goc_lexer_peek(struct lexer_buffer *buffer);
+static char        goc_lexer_consume(struct lexer_buffer *buffer);
+static void        goc_lexer_unconsume_char(struct lexer_buffer *buffer);
+static char        goc_lexer_consume_wspace(struct lexer_buffer *buffer);
+static char        goc_lexer_consume_comment(struct lexer_buffer *buffer, char ch);
+static TokenType   goc_lexer_consume_ident(struct lexer_buffer *buffer, union token_value *value);
+static size_t      goc_lexer_ident_end(const char *data, size_t s_data, size_t pos);
+static size_t      goc_lexer_letter_size(const char *data, size_t s_data, size_t pos, bool digit);
+static TokenType   goc_lexer_consume_number(struct lexer_buffer *buffer, union token_value *value);
+static TokenType   goc_lexer_consume_string_lit(struct lexer_buffer *buffer, union token_value *value, char ch);
+static size_t      goc_lexer_string_end(const char *data, size_t s_data, size_t pos, bool *escaped);
+static size_t      goc_lexer_string_decode(struct lexer_buffer *buffer, size_t pos, size_t end);
+static size_t      goc_lexer_escape_decode(struct lexer_buffer *buffer, size_t pos, size_t end, char **out);
+static int         goc_lexer_hex_value(char ch);
+static TokenType   goc_lexer_consume_char_lit(struct lexer_buffer *buffer, char ch);
+static size_t      goc_lexer_char_lit_end(const char *data, size_t s_data, size_t pos, bool *valid);
 
-static bool        goc_lexer_switch(char *word);
-static bool        goc_lexer_case(char *word);
+static bool        goc_lexer_comment_block_end(char ch, char next);
 
-static bool        goc_lexer_do(char *word);
-static bool        goc_lexer_while(char *word);
-static bool        goc_lexer_for(char *word);
-static bool        goc_lexer_range(char *word);
+static bool        goc_lexer_ident(char ch);
+static bool        goc_lexer_ident_middle(char ch);
+static bool        goc_lexer_skip(char ch);
 
-static double      pow_int(double value, int exp);
+static TokenType   goc_lexer_keyword(const char *word, size_t s_word);
 
 #endif // !GOC_LEXER_PRIVATE_H
@@ -0,0 +1,33 @@
+#ifndef GOC_LEXER_SIMD_H
+#define GOC_LEXER_SIMD_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "goc_lexer.h"
+
+// Stage one of the SIMD lexer: classify the source 64 bytes at a time into one bitmask per character class,
+// bit i of a block set when byte i of that block belongs to the class. Bytes past the end of the data are in
+// no class. Stage two (goc_lexer.c) walks these masks instead of testing every byte.
+
+#define GOC_LEXER_SIMD_BLOCK  64
+#define GOC_LEXER_SIMD_WINDOW 256
+
+typedef enum lexer_simd_mask {
+  LEXER_SIMD_MASK_WSPACE = 0, // ' ', '\t', '\n'
+  LEXER_SIMD_MASK_IDENT,      // [A-Za-z0-9_]
+  LEXER_SIMD_MASK_DIGIT,      // [0-9]
+  LEXER_SIMD_MASK_QUOTE,      // '"'
+  LEXER_SIMD_MASK_SLASH,      // '/', comment starts
+  LEXER_SIMD_MASK_COUNT
+} LexerSimdMask;
+
+// Classifies up to GOC_LEXER_SIMD_WINDOW blocks of data, returns the number of blocks filled
+size_t       goc_lexer_simd_classify(
+  const char *data, size_t s_data, uint64_t masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW], LexerSimdIsa isa
+);
+LexerSimdIsa goc_lexer_simd_resolve_isa(LexerSimdIsa isa);
+
+#endif // !GOC_LEXER_SIMD_H
@@ -0,0 +1,41 @@
+#ifndef GOC_LEXER_SIMD_PRIVATE_H
+#define GOC_LEXER_SIMD_PRIVATE_H
+
+// ==========================================================# PRIVATE #==================================================================
+
+#include <string.h>
+
+#include "goc_error.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GOC_LEXER_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define GOC_LEXER_SIMD_X86 0
+#endif
+
+// Bit n set when the byte belongs to LexerSimdMask n, bytes >= 0x80 are in no class
+static const uint8_t goc_lexer_simd_classes[256] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x01, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10,
+  0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+  0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x02,
+  0x00, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+  0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+static size_t goc_lexer_simd_classify_scalar(
+  const char *data, size_t s_blocks, uint64_t masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW], size_t index
+);
+#if GOC_LEXER_SIMD_X86
+static size_t goc_lexer_simd_classify_sse2(
+  const char *data, size_t s_blocks, uint64_t masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW], size_t index
+);
+static size_t goc_lexer_simd_classify_avx2(
+  const char *data, size_t s_blocks, uint64_t masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW], size_t index
+);
+#endif
+
+#endif // !GOC_LEXER_SIMD_PRIVATE_H
@@ -0,0 +1,32 @@
+#ifndef GOC_NUMBER_H
+#define GOC_NUMBER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Numeric literal parser used by the lexer. Integers are decimal, 0x / 0o / 0b prefixed hexadecimal, octal and
+// binary, or legacy octal with a leading 0, with '_' allowed between digits and after a prefix, and must fit in an
+// int64 (a minus sign is an operator of its own). Reals are decimal with a fraction and / or an exponent, converted
+// to the correctly rounded double. The literal must not run into an identifier character.
+
+typedef enum number_kind {
+  NUMBER_INVALID = 0,
+  NUMBER_INT,
+  NUMBER_REAL,
+  NUMBER_OVERFLOW
+} NumberKind;
+
+typedef struct number {
+  NumberKind kind;
+  size_t     s_text; // bytes of text the literal spans, also when invalid
+  union {
+    uint64_t integer;
+    double   real;
+  } value;
+} Number;
+
+Number goc_number_parse(const char *text, size_t s_text);
+
+#endif // !GOC_NUMBER_H
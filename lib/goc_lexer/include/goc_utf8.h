@@ -0,0 +1,26 @@
+#ifndef GOC_UTF8_H
+#define GOC_UTF8_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// UTF-8 support for the lexer. Sequences are decoded strictly: no overlong forms, no surrogates, nothing past
+// U+10FFFF, no truncated sequence. Letters are told apart by Unicode block (the letter, syllable and ideograph
+// blocks, without their punctuation, symbols and digits) instead of carrying the full Unicode category tables.
+
+#define GOC_UTF8_SIZE_MAX  4
+#define GOC_UTF8_CODE_MAX  0x10ffff
+
+uint32_t goc_utf8_decode(const char *data, size_t s_data, size_t *s_sequence); // *s_sequence is 0 when invalid
+size_t   goc_utf8_encode(uint32_t code_point, char *out);                      // out holds GOC_UTF8_SIZE_MAX bytes
+size_t   goc_utf8_sequence_size(char lead);                                    // 1 for ASCII and stray bytes
+bool     goc_utf8_letter(uint32_t code_point);                                 // non-ASCII identifier starts
+bool     goc_utf8_digit(uint32_t code_point);                                  // non-ASCII digits, after the start
+
+// Offset of the first byte of data that is not part of a valid sequence, s_data when all of it is valid.
+// ASCII runs are skipped 32 (AVX2), 16 (SSE2) or 8 bytes at a time, only the other bytes are decoded.
+size_t   goc_utf8_validate(const char *data, size_t s_data);
+
+#endif // !GOC_UTF8_H
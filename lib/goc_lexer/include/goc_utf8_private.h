@@ -0,0 +1,81 @@
+#ifndef GOC_UTF8_PRIVATE_H
+#define GOC_UTF8_PRIVATE_H
+
+// ==========================================================# PRIVATE #==================================================================
+
+#include <string.h>
+
+#include "goc_error.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define GOC_UTF8_X86 1
+#include <immintrin.h>
+#else
+#define GOC_UTF8_X86 0
+#endif
+
+#define UTF8_ASCII_MASK 0x8080808080808080ull
+
+// Smallest code point of a 2, 3 and 4 byte sequence, anything below is an overlong form
+static const uint32_t goc_utf8_size_min[GOC_UTF8_SIZE_MAX + 1] = { 0, 0, 0x80, 0x800, 0x10000 };
+
+// Sorted, inclusive [first, last] ranges of the code points accepted in identifiers: Latin, Greek, Cyrillic,
+// Armenian, Hebrew, Arabic, the Indic scripts, Thai, Georgian, Hangul, kana, CJK ideographs, Yi, the fullwidth
+// forms and the supplementary scripts, with the punctuation, symbol and emoji blocks and the decimal digits left out.
+static const uint32_t goc_utf8_letters[][2] = {
+  { 0x00aa,  0x00aa  }, { 0x00b5,  0x00b5  }, { 0x00ba,  0x00ba  }, { 0x00c0,  0x00d6  },
+  { 0x00d8,  0x00f6  }, { 0x00f8,  0x02c1  }, { 0x02c6,  0x02d1  }, { 0x02e0,  0x02e4  },
+  { 0x02ec,  0x02ec  }, { 0x02ee,  0x02ee  }, { 0x0370,  0x0374  }, { 0x0376,  0x037d  },
+  { 0x037f,  0x037f  }, { 0x0386,  0x0386  }, { 0x0388,  0x03f5  }, { 0x03f7,  0x0481  },
+  { 0x048a,  0x052f  }, { 0x0531,  0x0556  }, { 0x0559,  0x0559  }, { 0x0560,  0x0588  },
+  { 0x05d0,  0x05ea  }, { 0x05ef,  0x05f2  }, { 0x0620,  0x064a  }, { 0x066e,  0x06d3  },
+  { 0x06d5,  0x06d5  }, { 0x06fa,  0x06fc  }, { 0x0900,  0x0963  }, { 0x0970,  0x09e5  },
+  { 0x09f0,  0x0a65  }, { 0x0a70,  0x0ae5  }, { 0x0af0,  0x0b65  }, { 0x0b70,  0x0be5  },
+  { 0x0bf0,  0x0c65  }, { 0x0c70,  0x0ce5  }, { 0x0cf0,  0x0d65  }, { 0x0d70,  0x0de5  },
+  { 0x0df0,  0x0dff  }, { 0x0e01,  0x0e30  }, { 0x0e32,  0x0e33  }, { 0x0e40,  0x0e46  },
+  { 0x10a0,  0x10fa  }, { 0x10fc,  0x11ff  }, { 0x1e00,  0x1fbc  }, { 0x1fc2,  0x1fcc  },
+  { 0x1fd0,  0x1fdb  }, { 0x1fe0,  0x1fec  }, { 0x1ff2,  0x1ffc  }, { 0x2071,  0x2071  },
+  { 0x207f,  0x207f  }, { 0x2090,  0x209c  }, { 0x2c00,  0x2ce4  }, { 0x2d00,  0x2d6f  },
+  { 0x2d80,  0x2dde  }, { 0x3041,  0x3096  }, { 0x309d,  0x309f  }, { 0x30a1,  0x30fa  },
+  { 0x30fc,  0x30ff  }, { 0x3105,  0x312f  }, { 0x3131,  0x318e  }, { 0x3400,  0x4dbf  },
+  { 0x4e00,  0xa48c  }, { 0xac00,  0xd7a3  }, { 0xf900,  0xfdfb  }, { 0xfe70,  0xfefc  },
+  { 0xff21,  0xff3a  }, { 0xff41,  0xff5a  }, { 0xff66,  0xffdc  }, { 0x10000, 0x1049f },
+  { 0x104aa, 0x10d2f }, { 0x10d3a, 0x11065 }, { 0x11070, 0x110ef }, { 0x110fa, 0x11135 },
+  { 0x11140, 0x111cf }, { 0x111da, 0x112ef }, { 0x112fa, 0x1144f }, { 0x1145a, 0x114cf },
+  { 0x114da, 0x1164f }, { 0x1165a, 0x116bf }, { 0x116ca, 0x1172f }, { 0x1173a, 0x118df },
+  { 0x118ea, 0x1194f }, { 0x1195a, 0x11c4f }, { 0x11c5a, 0x11d4f }, { 0x11d5a, 0x11d9f },
+  { 0x11daa, 0x16a5f }, { 0x16a6a, 0x16abf }, { 0x16aca, 0x16b4f }, { 0x16b5a, 0x1cfff },
+  { 0x1d400, 0x1d7cd }, { 0x1e000, 0x1e13f }, { 0x1e14a, 0x1e2ef }, { 0x1e2fa, 0x1e94f },
+  { 0x1e95a, 0x1efff }, { 0x20000, 0x3134f }
+};
+
+// Sorted, inclusive ranges of the non-ASCII decimal digits (Unicode category Nd), which an identifier may hold
+// after its first character
+static const uint32_t goc_utf8_digits[][2] = {
+  { 0x0660,  0x0669  }, { 0x06f0,  0x06f9  }, { 0x07c0,  0x07c9  }, { 0x0966,  0x096f  },
+  { 0x09e6,  0x09ef  }, { 0x0a66,  0x0a6f  }, { 0x0ae6,  0x0aef  }, { 0x0b66,  0x0b6f  },
+  { 0x0be6,  0x0bef  }, { 0x0c66,  0x0c6f  }, { 0x0ce6,  0x0cef  }, { 0x0d66,  0x0d6f  },
+  { 0x0de6,  0x0def  }, { 0x0e50,  0x0e59  }, { 0x0ed0,  0x0ed9  }, { 0x0f20,  0x0f29  },
+  { 0x1040,  0x1049  }, { 0x1090,  0x1099  }, { 0x17e0,  0x17e9  }, { 0x1810,  0x1819  },
+  { 0x1946,  0x194f  }, { 0x19d0,  0x19d9  }, { 0x1a80,  0x1a89  }, { 0x1a90,  0x1a99  },
+  { 0x1b50,  0x1b59  }, { 0x1bb0,  0x1bb9  }, { 0x1c40,  0x1c49  }, { 0x1c50,  0x1c59  },
+  { 0xa620,  0xa629  }, { 0xa8d0,  0xa8d9  }, { 0xa900,  0xa909  }, { 0xa9d0,  0xa9d9  },
+  { 0xa9f0,  0xa9f9  }, { 0xaa50,  0xaa59  }, { 0xabf0,  0xabf9  }, { 0xff10,  0xff19  },
+  { 0x104a0, 0x104a9 }, { 0x10d30, 0x10d39 }, { 0x11066, 0x1106f }, { 0x110f0, 0x110f9 },
+  { 0x11136, 0x1113f }, { 0x111d0, 0x111d9 }, { 0x112f0, 0x112f9 }, { 0x11450, 0x11459 },
+  { 0x114d0, 0x114d9 }, { 0x11650, 0x11659 }, { 0x116c0, 0x116c9 }, { 0x11730, 0x11739 },
+  { 0x118e0, 0x118e9 }, { 0x11950, 0x11959 }, { 0x11c50, 0x11c59 }, { 0x11d50, 0x11d59 },
+  { 0x11da0, 0x11da9 }, { 0x16a60, 0x16a69 }, { 0x16ac0, 0x16ac9 }, { 0x16b50, 0x16b59 },
+  { 0x1d7ce, 0x1d7ff }, { 0x1e140, 0x1e149 }, { 0x1e2f0, 0x1e2f9 }, { 0x1e950, 0x1e959 },
+  { 0x1fbf0, 0x1fbf9 }
+};
+
+static bool   goc_utf8_in(const uint32_t ranges[][2], size_t s_ranges, uint32_t code_point);
+static size_t goc_utf8_ascii_end(const char *data, size_t s_data, size_t pos);
+static size_t goc_utf8_ascii_end_scalar(const char *data, size_t s_data, size_t pos);
+#if GOC_UTF8_X86
+static size_t goc_utf8_ascii_end_sse2(const char *data, size_t s_data, size_t pos);
+static size_t goc_utf8_ascii_end_avx2(const char *data, size_t s_data, size_t pos);
+#endif
+
+#endif // !GOC_UTF8_PRIVATE_H
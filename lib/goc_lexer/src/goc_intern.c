@@ -0,0 +1,165 @@
+#include <string.h>
+
+#include "goc_error.h"
+#include "goc_arena.h"
+#include "goc_intern.h"
+
+// Open addressing (linear probing) over symbol ids, the strings themselves live in an arena
+struct intern_entry {
+  const char *text;
+  uint32_t    s_text,
+              hash;
+};
+
+struct intern_table {
+  Arena                arena;
+  struct intern_entry *entries;
+  size_t               s_entries,
+                       s_entries_alloc;
+  SymbolId            *slots;
+  size_t               s_slots;
+};
+
+// The global table every goc_intern* function works on, private tables only back goc_intern_table_*
+static struct intern_table intern_global = { NULL, NULL, 1, 0, NULL, 0 };
+
+static const size_t intern_table_size_init = 4096;
+static const size_t intern_arena_chunk_size = 256 * 1024;
+
+// =========================================================# PRIVATE #================================================================
+
+// Word-at-a-time multiplicative hash, identifiers are short so this is a couple of multiplies
+static uint32_t _goc_intern_hash(const char *text, size_t s_text) {
+  uint64_t hash = 0x9e3779b97f4a7c15ull ^ s_text,
+           word;
+  for (; s_text >= sizeof(word); text += sizeof(word), s_text -= sizeof(word)) {
+    memcpy(&word, text, sizeof(word));
+    hash = (hash ^ word) * 0xff51afd7ed558ccdull;
+    hash ^= hash >> 32;
+  }
+  if (s_text > 0) {
+    word = 0;
+    memcpy(&word, text, s_text);
+    hash = (hash ^ word) * 0xff51afd7ed558ccdull;
+  }
+  hash ^= hash >> 29;
+  return (uint32_t)(hash ^ (hash >> 32));
+}
+
+static void _goc_intern_grow(InternTable table) {
+  size_t s_slots = table->s_slots ? 2 * table->s_slots : intern_table_size_init;
+  SymbolId *slots = (SymbolId *)calloc(s_slots, sizeof(SymbolId));
+  goc_error_assert(goc_error_mem_error, slots != NULL);
+  for (size_t id = 1; id < table->s_entries; id++) {
+    size_t slot = table->entries[id].hash & (s_slots - 1);
+    for (; slots[slot] != GOC_SYMBOL_INVALID; slot = (slot + 1) & (s_slots - 1));
+    slots[slot] = (SymbolId)id;
+  }
+  free(table->slots);
+  table->slots = slots;
+  table->s_slots = s_slots;
+}
+
+static size_t _goc_intern_find(InternTable table, const char *text, size_t s_text, uint32_t hash) {
+  size_t mask = table->s_slots - 1;
+  for (size_t slot = hash & mask; ; slot = (slot + 1) & mask) {
+    SymbolId id = table->slots[slot];
+    if (id == GOC_SYMBOL_INVALID)
+      return slot;
+    struct intern_entry *entry = &(table->entries[id]);
+    if (entry->hash == hash && entry->s_text == s_text && memcmp(entry->text, text, s_text) == 0)
+      return slot;
+  }
+}
+
+// ==========================================================# PUBLIC #================================================================
+
+InternTable goc_intern_table_create(void) {
+  InternTable table = (InternTable)calloc(1, sizeof(struct intern_table));
+  if (table == NULL)
+    return NULL;
+  table->s_entries = 1;
+  return table;
+}
+
+void goc_intern_table_free(InternTable table) {
+  if (table == NULL || table == &intern_global)
+    return;
+  goc_arena_free(table->arena);
+  free(table->entries);
+  free(table->slots);
+  free(table);
+}
+
+SymbolId goc_intern_table_add(InternTable table, const char *text, size_t s_text) {
+  goc_error_assert(goc_error_nullptr, table != NULL);
+  goc_error_assert(goc_error_nullptr, text != NULL || s_text == 0);
+  goc_error_assert(goc_error_inval_arg, s_text < UINT32_MAX);
+
+  // Keep the load factor under 1/2
+  if (2 * table->s_entries >= table->s_slots)
+    _goc_intern_grow(table);
+
+  uint32_t hash = _goc_intern_hash(text, s_text);
+  size_t slot = _goc_intern_find(table, text, s_text, hash);
+  if (table->slots[slot] != GOC_SYMBOL_INVALID)
+    return table->slots[slot];
+
+  if (table->arena == NULL) {
+    table->arena = goc_arena_create(intern_arena_chunk_size);
+    goc_error_assert(goc_error_mem_error, table->arena != NULL);
+  }
+  if (table->s_entries >= table->s_entries_alloc) {
+    size_t s_alloc = table->s_entries_alloc ? 2 * table->s_entries_alloc : intern_table_size_init;
+    struct intern_entry *temp = (struct intern_entry *)realloc(table->entries, s_alloc * sizeof(struct intern_entry));
+    goc_error_assert(goc_error_mem_error, temp != NULL);
+    table->entries = temp;
+    table->s_entries_alloc = s_alloc;
+  }
+
+  const char *copy = goc_arena_strndup(table->arena, text, s_text);
+  goc_error_assert(goc_error_mem_error, copy != NULL);
+
+  SymbolId id = (SymbolId)table->s_entries++;
+  table->entries[id] = (struct intern_entry){ copy, (uint32_t)s_text, hash };
+  table->slots[slot] = id;
+  return id;
+}
+
+SymbolId goc_intern_table_lookup(InternTable table, const char *text, size_t s_text) {
+  if (table == NULL || table->s_slots == 0 || (text == NULL && s_text > 0))
+    return GOC_SYMBOL_INVALID;
+  return table->slots[_goc_intern_find(table, text, s_text, _goc_intern_hash(text, s_text))];
+}
+
+const char *goc_intern_table_get_text(InternTable table, SymbolId id) {
+  return (table && id != GOC_SYMBOL_INVALID && id < table->s_entries) ? table->entries[id].text : NULL;
+}
+
+size_t goc_intern_table_get_size(InternTable table, SymbolId id) {
+  return (table && id != GOC_SYMBOL_INVALID && id < table->s_entries) ? table->entries[id].s_text : 0;
+}
+
+size_t goc_intern_table_get_count(InternTable table) {
+  return table ? table->s_entries - 1 : 0;
+}
+
+SymbolId goc_intern(const char *text, size_t s_text) {
+  return goc_intern_table_add(&intern_global, text, s_text);
+}
+
+SymbolId goc_intern_lookup(const char *text, size_t s_text) {
+  return goc_intern_table_lookup(&intern_global, text, s_text);
+}
+
+const char *goc_intern_get_text(SymbolId id) {
+  return goc_intern_table_get_text(&intern_global, id);
+}
+
+size_t goc_intern_get_size(SymbolId id) {
+  return goc_intern_table_get_size(&intern_global, id);
+}
+
+size_t goc_intern_get_count(void) {
+  return goc_intern_table_get_count(&intern_global);
+}
@@ -6,123 +6,238 @@
 TokenArray goc_lexer(const char *file_name) {
   goc_error_assert(goc_error_nullptr, file_name != NULL);
 
-  FILE *file = fopen(file_name, READ);
-  if (file == NULL)
+  struct lexer_buffer buffer = {0};
+  if (!goc_lexer_buffer_load(file_name, &buffer))
     goc_error_lexer_print_input_file(file_name);
 
-  struct token_pos global = { 1, 0, 0, 0 };
+  // The TokenArray takes ownership of the buffer, its tokens are views into it
+  return goc_lexer_tokenize(&buffer, file_name, NULL);
+}
 
-  TokenArray tokens = goc_lexer_token_array_create(token_size_init);
-  size_t s_tokens = 0;
-  for (TokenType type = TT_BEGIN; type != TT_EOF; s_tokens++) {
-    if (s_tokens >= tokens->s_tokens) {
-      Token temp = (Token)realloc(tokens->tokens, 2 * s_tokens * sizeof(struct token));
-      goc_error_assert(goc_error_mem_error, temp != NULL);
-      tokens->s_tokens = 2 * s_tokens;
-      tokens->tokens = temp;
-    }
-    type = goc_lexer_get_token(file, &global, &(tokens->tokens[s_tokens].pos), &(tokens->tokens[s_tokens].value));
-    tokens->tokens[s_tokens].type = type;
-  }
+TokenArray goc_lexer_from_buffer(const char *data, size_t s_data) {
+  goc_error_assert(goc_error_nullptr, data != NULL || s_data == 0);
+  struct lexer_buffer buffer = { data, s_data, 0, 0, GOC_SOURCE_ID_INVALID };
+  return goc_lexer_tokenize(&buffer, NULL, NULL);
+}
 
-  if (s_tokens == 0) {
-    goc_lexer_token_array_free(tokens);
-    return NULL;
-  } else if (s_tokens != tokens->s_tokens) {
-    Token temp = (Token)realloc(tokens->tokens, s_tokens * sizeof(struct token));
-    goc_error_assert(goc_error_mem_error, temp != NULL);
-    tokens->s_tokens = s_tokens;
-    tokens->tokens = temp;
-  }
+TokenArray goc_lexer_simd(const char *file_name, LexerSimdIsa isa) {
+  goc_error_assert(goc_error_nullptr, file_name != NULL);
 
-  return tokens;
+  struct lexer_buffer buffer = {0};
+  if (!goc_lexer_buffer_load(file_name, &buffer))
+    goc_error_lexer_print_input_file(file_name);
+
+  struct lexer_simd_window window = { .isa = goc_lexer_simd_resolve_isa(isa) };
+  return goc_lexer_tokenize(&buffer, file_name, &window);
+}
+
+TokenArray goc_lexer_simd_from_buffer(const char *data, size_t s_data, LexerSimdIsa isa) {
+  goc_error_assert(goc_error_nullptr, data != NULL || s_data == 0);
+  struct lexer_buffer buffer = { data, s_data, 0, 0, GOC_SOURCE_ID_INVALID };
+  struct lexer_simd_window window = { .isa = goc_lexer_simd_resolve_isa(isa) };
+  return goc_lexer_tokenize(&buffer, NULL, &window);
+}
+
+TokenArray goc_lexer_parallel(const char *file_name, uint32_t s_threads) {
+  goc_error_assert(goc_error_nullptr, file_name != NULL);
+
+  struct lexer_buffer buffer = {0};
+  if (!goc_lexer_buffer_load(file_name, &buffer))
+    goc_error_lexer_print_input_file(file_name);
+  return goc_lexer_tokenize_parallel(&buffer, file_name, s_threads);
+}
+
+TokenArray goc_lexer_parallel_from_buffer(const char *data, size_t s_data, uint32_t s_threads) {
+  goc_error_assert(goc_error_nullptr, data != NULL || s_data == 0);
+  struct lexer_buffer buffer = { data, s_data, 0, 0, GOC_SOURCE_ID_INVALID };
+  return goc_lexer_tokenize_parallel(&buffer, NULL, s_threads);
+}
+
+LexerStream goc_lexer_open(int fd, const char *name) {
+  goc_error_assert(goc_error_inval_arg, fd >= 0);
+
+  LexerStream stream = (LexerStream)calloc(1, sizeof(struct lexer_stream));
+  goc_error_assert(goc_error_mem_error, stream != NULL);
+  stream->ring = (char *)malloc(lexer_stream_size);
+  stream->name = strdup(name ? name : GOC_LEXER_STREAM_NAME);
+  stream->tokens = goc_lexer_token_array_create(1, 1);
+  goc_error_assert(goc_error_mem_error, stream->ring != NULL && stream->name != NULL && stream->tokens != NULL);
+
+  stream->fd = fd;
+  stream->s_ring = lexer_stream_size;
+  stream->line = 1;
+  stream->tokens->stream = stream;
+  stream->buffer = (struct lexer_buffer){
+    stream->ring, 0, 0, 0, GOC_SOURCE_ID_INVALID, NULL, stream, NULL, 0, stream->tokens->diagnostics
+  };
+  return stream;
+}
+
+Token goc_lexer_next(LexerStream stream) {
+  goc_error_assert(goc_error_nullptr, stream != NULL);
+  struct lexer_buffer *buffer = &(stream->buffer);
+
+  // Whitespace and comments can span refills, the token itself is lexed with lookahead bytes in the window
+  goc_lexer_stream_skip(stream);
+  buffer->start = buffer->cursor;
+  goc_lexer_stream_fill(stream, lexer_stream_lookahead);
+  if (buffer->cursor < buffer->s_data && goc_lexer_char_class(buffer->data[buffer->cursor]) == LEXER_CLASS_QUOTE)
+    goc_lexer_stream_fill_string(stream);
+  goc_lexer_stream_count_lines(stream, buffer->cursor);
+  stream->token_pos = stream->offset + buffer->cursor;
+
+  union token_value value = {0};
+  TokenType type = goc_lexer_get_token(buffer, &value);
+
+  TokenArray tokens = stream->tokens;
+  tokens->columns.s_tokens = tokens->columns.s_literals = 0;
+  goc_lexer_token_array_push(tokens, type, GOC_SOURCE_LOC_INVALID, buffer->cursor - buffer->start, &value);
+  return (Token){ tokens, 0 };
+}
+
+void goc_lexer_close(LexerStream stream) {
+  if (stream == NULL)
+    return;
+  goc_lexer_token_array_free(stream->tokens);
+  free(stream->buffer.scratch);
+  free(stream->ring);
+  free(stream->name);
+  free(stream);
 }
 
 Token goc_lexer_token_array_at(TokenArray token_array, size_t index) {
-  return token_array ? ((index >= 0 && index < token_array->s_tokens) ? &(token_array->tokens[index]) : NULL) : NULL;
+  return (token_array && index < token_array->columns.s_tokens) ? (Token){ token_array, index } : (Token){ NULL, 0 };
 }
 
 size_t goc_lexer_token_array_get_size(TokenArray token_array) {
-  return !token_array ? 0 : token_array->s_tokens;
+  return !token_array ? 0 : token_array->columns.s_tokens;
+}
+
+Diagnostics goc_lexer_token_array_get_diagnostics(TokenArray token_array) {
+  return !token_array ? NULL : token_array->diagnostics;
+}
+
+Diagnostics goc_lexer_stream_get_diagnostics(LexerStream stream) {
+  return !stream ? NULL : stream->tokens->diagnostics;
 }
 
 void goc_lexer_token_array_free(TokenArray token_array) {
   if (token_array == NULL)
     return;
-  if (token_array->tokens)
-    free(token_array->tokens);
-  free(token_array);
+  // The array lives in its own arena, tokens are released with it whatever their count
+  Arena arena = token_array->arena;
+  goc_source_unregister(token_array->source.source);
+  goc_lexer_buffer_unload(&(token_array->source));
+  goc_diagnostics_free(token_array->diagnostics);
+  goc_arena_free(arena);
 }
 
 const TokenType goc_lexer_token_get_token_type(Token token) {
-  goc_error_assert(goc_error_nullptr, token != NULL);
-  return token->type;
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  size_t offset;
+  return (TokenType)goc_lexer_token_array_segment(token.array, token.index, &offset)->types[offset];
+}
+
+const SourceLoc goc_lexer_token_get_loc(Token token) {
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  size_t offset;
+  return goc_lexer_token_array_segment(token.array, token.index, &offset)->locs[offset];
 }
 
 const size_t goc_lexer_token_get_pos_abs(Token token) {
-  goc_error_assert(goc_error_nullptr, token != NULL);
-  return token->pos.abs;
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  if (token.array->stream != NULL)
+    return token.array->stream->token_pos + 1;
+  return goc_source_loc_offset(goc_lexer_token_get_loc(token)) + 1;
 }
 
 const size_t goc_lexer_token_get_pos_line(Token token) {
-  goc_error_assert(goc_error_nullptr, token != NULL);
-  return token->pos.line;
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  if (token.array->stream != NULL)
+    return token.array->stream->line;
+  return goc_source_loc_line(goc_lexer_token_get_loc(token));
 }
 
 const size_t goc_lexer_token_get_pos_rel(Token token) {
-  goc_error_assert(goc_error_nullptr, token != NULL);
-  return token->pos.rel;
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  if (token.array->stream != NULL)
+    return token.array->stream->token_pos - token.array->stream->line_start + 1;
+  return goc_source_loc_rel(goc_lexer_token_get_loc(token));
 }
 
 const size_t goc_lexer_token_get_pos_s_word(Token token) {
-  goc_error_assert(goc_error_nullptr, token != NULL);
-  return token->pos.s_word;
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  size_t offset;
+  return goc_lexer_token_array_segment(token.array, token.index, &offset)->lengths[offset];
 }
 
 int64_t goc_lexer_token_get_value_number_literal(Token token) {
-  goc_error_assert(goc_error_nullptr, token != NULL);
-  return token->value.num_lit;
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  size_t offset;
+  struct token_segment *segment = goc_lexer_token_array_segment(token.array, token.index, &offset);
+  if (segment->types[offset] != TT_NUM_LIT)
+    return 0;
+  return goc_lexer_token_array_literal(token.array, segment->values[offset])->num_lit;
 }
 
 double goc_lexer_token_get_value_real_literal(Token token) {
-  goc_error_assert(goc_error_nullptr, token != NULL);
-  return token->value.real_lit;
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  size_t offset;
+  struct token_segment *segment = goc_lexer_token_array_segment(token.array, token.index, &offset);
+  if (segment->types[offset] != TT_REAL_LIT)
+    return 0;
+  return goc_lexer_token_array_literal(token.array, segment->values[offset])->real_lit;
 }
 
-char *goc_lexer_token_get_value_text(Token token) {
-  goc_error_assert(goc_error_nullptr, token != NULL);
-  size_t len = strlen(token->value.text);
-  char *cp = (char *)calloc(len, sizeof(char));
-  if (cp == NULL)
-    return NULL;
-  strncpy(cp, token->value.text, len);
-  return cp;
+SymbolId goc_lexer_token_get_symbol(Token token) {
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  size_t offset;
+  struct token_segment *segment = goc_lexer_token_array_segment(token.array, token.index, &offset);
+  TokenType type = (TokenType)segment->types[offset];
+  return (type == TT_IDENT || type == TT_STRING_LIT) ? segment->values[offset] : GOC_SYMBOL_INVALID;
+}
+
+TokenText goc_lexer_token_get_value_text(Token token) {
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+  TokenArray array = token.array;
+  size_t offset;
+  struct token_segment *segment = goc_lexer_token_array_segment(array, token.index, &offset);
+  if (array->stream != NULL)
+    return (TokenText){ array->stream->ring + (array->stream->token_pos - array->stream->offset), segment->lengths[offset] };
+  size_t start = segment->locs[offset] - goc_source_loc(array->source.source, 0);
+  return (TokenText){ array->source.data + start, segment->lengths[offset] };
+}
+
+const char *goc_lexer_token_type_to_str(TokenType type) {
+  if (type > TT_EOF || goc_lexer_token_types[type].name == NULL)
+    return goc_lexer_token_types[TT_UNKNOWN].name;
+  return goc_lexer_token_types[type].name;
 }
 
 const char *goc_lexer_token_to_str(Token token) {
-  if (token == NULL)
+  if (token.array == NULL)
     return NULL;
 
-  char *token_str = (char *)calloc(token_str_max_size, sizeof(char));
+  char *token_str = (char *)malloc(token_str_max_size);
   if (token_str == NULL)
     return NULL;
 
-  const char *token_type_str = goc_lexer_token_type_match_str(token->type);
-  if (token_type_str == NULL)
-    return NULL;
+  TokenType type = goc_lexer_token_get_token_type(token);
+  const char *token_type_str = goc_lexer_token_type_to_str(type);
 
   char token_value_str[TOKEN_TEXT_MAX_SIZE + 2] = {0};
-  switch (token->type) {
+  switch (type) {
     case TT_IDENT: case TT_STRING_LIT: case TT_CHAR_LIT: {
-      snprintf(token_value_str, TOKEN_TEXT_MAX_SIZE + 2, "%c%s%c", CHAR_LTHAN, token->value.text, CHAR_GTHAN);
+      TokenText text = goc_lexer_token_get_value_text(token);
+      snprintf(token_value_str, TOKEN_TEXT_MAX_SIZE + 2, "%c%.*s%c", CHAR_LTHAN, (int)text.s_text, text.text, CHAR_GTHAN);
       break;
     }
     case TT_NUM_LIT: {
-      snprintf(token_value_str, token_str_max_size - 1, "%ld", token->value.num_lit);
+      snprintf(token_value_str, TOKEN_TEXT_MAX_SIZE + 2, "%ld", goc_lexer_token_get_value_number_literal(token));
       break;
     }
     case TT_REAL_LIT: {
-      snprintf(token_value_str, token_str_max_size - 1, "%lf", token->value.real_lit);
+      snprintf(token_value_str, TOKEN_TEXT_MAX_SIZE + 2, "%lf", goc_lexer_token_get_value_real_literal(token));
       break;
     }
     default: {
@@ -141,7 +256,10 @@ const char *goc_lexer_token_to_str(Token token) {
     ANSI_COLORS[ANSI_COLOR_WHITE], ANSI_COLORS[ANSI_COLOR_RESET],
     ANSI_COLORS[ANSI_COLOR_GREEN], token_value_str, ANSI_COLORS[ANSI_COLOR_RESET],
     ANSI_COLORS[ANSI_COLOR_WHITE], ANSI_COLORS[ANSI_COLOR_RESET],
-    ANSI_COLORS[ANSI_COLOR_CYAN], token->pos.abs, token->pos.line, token->pos.rel, token->pos.s_word, ANSI_COLORS[ANSI_COLOR_RESET],
+    ANSI_COLORS[ANSI_COLOR_CYAN],
+    goc_lexer_token_get_pos_abs(token), goc_lexer_token_get_pos_line(token),
+    goc_lexer_token_get_pos_rel(token), goc_lexer_token_get_pos_s_word(token),
+    ANSI_COLORS[ANSI_COLOR_RESET],
     ANSI_COLORS[ANSI_COLOR_YELLOW], ANSI_COLORS[ANSI_COLOR_RESET]
   );
 
@@ -150,758 +268,1090 @@ const char *goc_lexer_token_to_str(Token token) {
 
 // ====================================================# PRIVATE #======================================================================
 
-static TokenArray goc_lexer_token_array_create(size_t s_tokens) {
-  if (s_tokens == 0)
+// s_tokens and s_literals size the first segments, later ones double. Nothing is zeroed, the arena's first
+// chunk is only touched as tokens are pushed.
+static TokenArray goc_lexer_token_array_create(size_t s_tokens, size_t s_literals) {
+  uint8_t segment_shift = s_tokens > 1 ? (uint8_t)(64 - __builtin_clzll(s_tokens - 1)) : 0,
+          literal_shift = s_literals > 1 ? (uint8_t)(64 - __builtin_clzll(s_literals - 1)) : 0;
+  size_t s_chunk = sizeof(struct token_array) + 4 * GOC_ARENA_ALIGN_DEFAULT
+    + ((size_t)1 << segment_shift) * (sizeof(uint8_t) + sizeof(SourceLoc) + 2 * sizeof(uint32_t))
+    + ((size_t)1 << literal_shift) * sizeof(union token_value);
+
+  Arena arena = goc_arena_create(s_chunk);
+  if (arena == NULL)
     return NULL;
-
-  TokenArray token_array = (TokenArray)malloc(sizeof(struct token_array));
-  if (token_array == NULL)
+  TokenArray token_array = goc_arena_new(arena, struct token_array);
+  if (token_array == NULL) {
+    goc_arena_free(arena);
     return NULL;
+  }
 
-  Token tokens = (Token)calloc(s_tokens, sizeof(struct token));
-  if (tokens == NULL) {
-    free(token_array);
+  memset(token_array, 0, sizeof(struct token_array));
+  token_array->diagnostics = goc_diagnostics_create();
+  if (token_array->diagnostics == NULL) {
+    goc_arena_free(arena);
     return NULL;
   }
-
-  token_array->tokens = tokens;
-  token_array->s_tokens = s_tokens;
+  token_array->arena = arena;
+  token_array->columns.segment_shift = segment_shift;
+  token_array->columns.literal_shift = literal_shift;
+  token_array->source.source = GOC_SOURCE_ID_INVALID;
+  goc_lexer_token_array_grow(token_array);
+  goc_lexer_token_array_grow_literals(token_array);
   return token_array;
 }
 
-static TokenType goc_lexer_get_token(FILE *file, struct token_pos *global, struct token_pos *pos, union token_value *value) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, global != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
-  goc_error_assert(goc_error_nullptr, value != NULL);
+// Appends the next token segment, the ones before are left where they are
+static void goc_lexer_token_array_grow(TokenArray token_array) {
+  goc_error_check(goc_error_nullptr, token_array != NULL);
+  goc_error_assert(goc_error_mem_error, token_array->columns.s_segments < TOKEN_SEGMENTS_MAX);
+
+  size_t s_segment = (size_t)1 << (token_array->columns.segment_shift + token_array->columns.s_segments);
+  struct token_segment *segment = &(token_array->columns.segments[token_array->columns.s_segments]);
+  segment->locs    = goc_arena_new_n(token_array->arena, SourceLoc, s_segment);
+  segment->lengths = goc_arena_new_n(token_array->arena, uint32_t, s_segment);
+  segment->values  = goc_arena_new_n(token_array->arena, uint32_t, s_segment);
+  segment->types   = goc_arena_new_n(token_array->arena, uint8_t, s_segment);
+  goc_error_assert(
+    goc_error_mem_error,
+    segment->locs != NULL && segment->lengths != NULL && segment->values != NULL && segment->types != NULL
+  );
 
-  char ch;
-  while ((ch = goc_lexer_consume_comment(file, global, pos, goc_lexer_consume_wspace(file, global, pos))) == CHAR_WSPACE);
+  token_array->columns.s_segments++;
+  token_array->columns.tail_start = token_array->columns.tail_end;
+  token_array->columns.tail_end += s_segment;
+}
 
-  switch (ch) {
-    case CHAR_LBRACE:     return TT_LBRACE;
-    case CHAR_RBRACE:     return TT_RBRACE;
-    case CHAR_LPAREN:     return TT_LPAREN;
-    case CHAR_RPAREN:     return TT_RPAREN;
-    case CHAR_LSQPAREN:   return TT_LSQPAREN;
-    case CHAR_RSQPAREN:   return TT_RSQPAREN;
-
-    case CHAR_SEMICOLON:  return TT_SEMICOLON;
-    case CHAR_COMMA:      return TT_COMMA;
-    case CHAR_QUESTMARK:  return TT_QUESTMARK;
-    case CHAR_EOF:        return TT_EOF;
-
-    case CHAR_TIL:        return TT_UNOP_BIT_NOT;
-    case CHAR_STAR:       return goc_lexer_consume_char(file, global, pos, CHAR_EQUAL) ? TT_BINOP_ARIT_MUL_EQ     : TT_STAR; 
-    case CHAR_SLASH:      return goc_lexer_consume_char(file, global, pos, CHAR_EQUAL) ? TT_BINOP_ARIT_DIV_EQ     : TT_BINOP_ARIT_DIV;
-    case CHAR_PERCENT:    return goc_lexer_consume_char(file, global, pos, CHAR_EQUAL) ? TT_BINOP_ARIT_MOD_EQ     : TT_BINOP_ARIT_MOD;
-    case CHAR_BANG:       return goc_lexer_consume_char(file, global, pos, CHAR_EQUAL) ? TT_BINOP_COMP_NEQ        : TT_UNOP_LOG_NOT;
-    case CHAR_EQUAL:      return goc_lexer_consume_char(file, global, pos, CHAR_EQUAL) ? TT_BINOP_COMP_EQ         : TT_ASSIGN;
-    case CHAR_COLON:      return goc_lexer_consume_char(file, global, pos, CHAR_EQUAL) ? TT_AUTO_ASSIGN           : TT_COLON;
-    case CHAR_HAT:        return goc_lexer_consume_char(file, global, pos, CHAR_EQUAL) ? TT_BINOP_BIT_XOR_EQ      : TT_BINOP_BIT_XOR;
-
-    case CHAR_QUOTE:      return goc_lexer_consume_string_lit(file, global, pos, value, ch);
-    case CHAR_APOST:      return goc_lexer_consume_char_lit(file, global, pos, value, ch);
-
-    case CHAR_LTHAN: {
-      if (goc_lexer_consume_char(file, global, pos, CHAR_LTHAN)) {
-        if (goc_lexer_consume_char(file, global, pos, CHAR_EQUAL))
-          return TT_BINOP_BIT_LSHIFT_EQ;
-        return TT_BINOP_BIT_LSHIFT;
-      }
-      if (goc_lexer_consume_char(file, global, pos, CHAR_EQUAL))
-        return TT_BINOP_COMP_LTHAN_EQ;
-      return TT_BINOP_COMP_LTHAN;
-    }
+static void goc_lexer_token_array_grow_literals(TokenArray token_array) {
+  goc_error_check(goc_error_nullptr, token_array != NULL);
+  goc_error_assert(goc_error_mem_error, token_array->columns.s_literal_segments < TOKEN_SEGMENTS_MAX);
 
-    case CHAR_GTHAN: {
-      if (goc_lexer_consume_char(file, global, pos, CHAR_GTHAN)) {
-        if (goc_lexer_consume_char(file, global, pos, CHAR_EQUAL))
-          return TT_BINOP_BIT_RSHIFT_EQ;
-        return TT_BINOP_BIT_RSHIFT;
-      }
-      if (goc_lexer_consume_char(file, global, pos, CHAR_EQUAL))
-        return TT_BINOP_COMP_GTHAN_EQ;
-      return TT_BINOP_COMP_GTHAN;
-    }
+  size_t s_segment = (size_t)1 << (token_array->columns.literal_shift + token_array->columns.s_literal_segments);
+  union token_value *literals = goc_arena_new_n(token_array->arena, union token_value, s_segment);
+  goc_error_assert(goc_error_mem_error, literals != NULL);
 
-    case CHAR_AMPER: {
-      if (goc_lexer_consume_char(file, global, pos, CHAR_AMPER))
-        return TT_BINOP_LOG_AND;
-      if (goc_lexer_consume_char(file, global, pos, CHAR_EQUAL))
-        return TT_BINOP_BIT_AND_EQ;
-      return  TT_AMPER;
-    } 
-
-    case CHAR_BAR: {
-      if (goc_lexer_consume_char(file, global, pos, CHAR_BAR))
-        return TT_BINOP_LOG_OR;
-      if (goc_lexer_consume_char(file, global, pos, CHAR_EQUAL))
-        return TT_BINOP_BIT_OR_EQ;
-      return TT_BINOP_BIT_OR;
-    }
+  token_array->columns.literals[token_array->columns.s_literal_segments++] = literals;
+  token_array->columns.literal_tail_start = token_array->columns.literal_tail_end;
+  token_array->columns.literal_tail_end += s_segment;
+}
 
-    case CHAR_PLUS: {
-      if (goc_lexer_consume_char(file, global, pos, CHAR_PLUS))
-        return TT_UNOP_INCR;
-      if (goc_lexer_consume_char(file, global, pos, CHAR_EQUAL))
-        return TT_BINOP_ARIT_PLUS_EQ;
-      return TT_PLUS;
-    } 
-
-    case CHAR_MINUS: {
-      if (goc_lexer_consume_char(file, global, pos, CHAR_MINUS))
-        return TT_UNOP_DECR;
-      if (goc_lexer_consume_char(file, global, pos, CHAR_EQUAL))
-        return TT_BINOP_ARIT_MINUS_EQ;
-      if (goc_lexer_consume_char(file, global, pos, CHAR_GTHAN))
-        return TT_ARROW;
-      return TT_MINUS;
-    }
+static inline struct token_segment *goc_lexer_token_array_segment(TokenArray token_array, size_t index, size_t *offset) {
+  return &(token_array->columns.segments[goc_lexer_inline_locate(index, token_array->columns.segment_shift, offset)]);
+}
 
-    case CHAR_PERIOD: {
-      if (!isdigit(goc_lexer_peek(file)))
-        return TT_PERIOD;
-      goc_lexer_unconsume_char(file, global, pos, ch);
-      return goc_lexer_consume_number(file, global, pos, value);
-    }
- 
-    default: {
-      if (isdigit(ch)) {
-        goc_lexer_unconsume_char(file, global, pos, ch);
-        return goc_lexer_consume_number(file, global, pos, value);
-      } else if (goc_lexer_ident(ch)) {
-        if (ch == CHAR_UNDER && !goc_lexer_ident(goc_lexer_peek(file)))
-          return TT_NULL_ITERATOR;
-
-        size_t index = 0;
-        do {
-          if (index > token_text_max_size)
-            goc_error_lexer_print_buffer_overrun(file, pos->abs, pos->line, pos->rel + index, pos->s_word);
-          if (index > 0)
-            ch = goc_lexer_consume(file, global, pos);
-          value->text[index++] = ch;
-        } while (goc_lexer_ident_middle(goc_lexer_peek(file)));
-
-        if (goc_lexer_package(value->text))
-          return TT_PACKAGE;
-        if (goc_lexer_import(value->text))
-          return TT_IMPORT;
-        if (goc_lexer_typedef(value->text))
-          return TT_TYPE;
-
-        if (goc_lexer_func(value->text))
-          return TT_FUNC;
-        if (goc_lexer_struct(value->text))
-          return TT_STRUCT;
-        if (goc_lexer_interface(value->text))
-          return TT_INTERFACE;
-        if (goc_lexer_enum(value->text))
-          return TT_ENUM;
-        if (goc_lexer_union(value->text))
-          return TT_UNION;
-
-        if (goc_lexer_nil(value->text))
-          return TT_NIL;
-        if (goc_lexer_iota(value->text))
-          return TT_IOTA;
-        if (goc_lexer_return(value->text))
-          return TT_RETURN;
-        if (goc_lexer_var(value->text))
-          return TT_VAR;
-        if (goc_lexer_const(value->text))
-          return TT_CONST;
-
-        if (goc_lexer_int8(value->text))
-          return TT_INT8;
-        if (goc_lexer_int16(value->text))
-          return TT_INT16;
-        if (goc_lexer_int32(value->text))
-          return TT_INT32;
-        if (goc_lexer_int64(value->text))
-          return TT_INT64;
-
-        if (goc_lexer_uint8(value->text))
-          return TT_UINT8;
-        if (goc_lexer_uint16(value->text))
-          return TT_UINT16;
-        if (goc_lexer_uint32(value->text))
-          return TT_UINT32;
-        if (goc_lexer_uint64(value->text))
-          return TT_UINT64;
-
-        if (goc_lexer_float(value->text))
-          return TT_FLOAT;
-        if (goc_lexer_double(value->text))
-          return TT_DOUBLE;
-
-        if (goc_lexer_char(value->text))
-          return TT_CHAR;
-        if (goc_lexer_string(value->text))
-          return TT_STRING;
-
-        if (goc_lexer_bool(value->text))
-          return TT_BOOL;
-        if (goc_lexer_true(value->text))
-          return TT_TRUE_LIT;
-        if (goc_lexer_false(value->text))
-          return TT_FALSE_LIT;
-
-        if (goc_lexer_if(value->text))
-          return TT_IF;
-        if (goc_lexer_else(value->text))
-          return TT_ELSE;
-
-        if (goc_lexer_switch(value->text))
-          return TT_SWITCH;
-        if (goc_lexer_case(value->text))
-          return TT_CASE;
-        
-        if (goc_lexer_do(value->text))
-          return TT_DO;
-        if (goc_lexer_while(value->text))
-          return TT_WHILE;
-        if (goc_lexer_for(value->text))
-          return TT_FOR;
-        if (goc_lexer_range(value->text))
-          return TT_RANGE;
-
-        return TT_IDENT;
-      }
+static inline union token_value *goc_lexer_token_array_literal(TokenArray token_array, uint32_t literal) {
+  size_t offset;
+  size_t segment = goc_lexer_inline_locate(literal, token_array->columns.literal_shift, &offset);
+  return &(token_array->columns.literals[segment][offset]);
+}
 
-      goc_error_lexer_print_invalid_ident(file, pos->abs, pos->line, pos->rel, pos->s_word);
-    } 
+// Tokens are pushed in source order, which the paranoid checks hold the arrays to
+static inline SourceLoc goc_lexer_token_array_last_loc(TokenArray token_array) {
+  size_t offset;
+  return goc_lexer_token_array_segment(token_array, token_array->columns.s_tokens - 1, &offset)->locs[offset];
+}
+
+static void goc_lexer_token_array_push(
+  TokenArray token_array, TokenType type, SourceLoc loc, size_t length, union token_value *value
+) {
+  goc_error_check(goc_error_nullptr, token_array != NULL);
+  goc_error_check(goc_error_nullptr, value != NULL);
+  goc_error_check(goc_error_inval_arg, length <= UINT32_MAX);
+  goc_error_check_paranoid(
+    goc_error_inval_arg, token_array->columns.s_tokens == 0 || goc_lexer_token_array_last_loc(token_array) <= loc
+  );
+
+  uint32_t column_value = 0;
+  if (type == TT_IDENT || type == TT_STRING_LIT) {
+    column_value = value->symbol;
+  } else if (type == TT_NUM_LIT || type == TT_REAL_LIT) {
+    if (token_array->columns.s_literals >= token_array->columns.literal_tail_end)
+      goc_lexer_token_array_grow_literals(token_array);
+    union token_value *tail = token_array->columns.literals[token_array->columns.s_literal_segments - 1];
+    column_value = (uint32_t)token_array->columns.s_literals;
+    tail[token_array->columns.s_literals++ - token_array->columns.literal_tail_start] = *value;
   }
 
-  return TT_UNKNOWN;
+  if (token_array->columns.s_tokens >= token_array->columns.tail_end)
+    goc_lexer_token_array_grow(token_array);
+  struct token_segment *tail = &(token_array->columns.segments[token_array->columns.s_segments - 1]);
+  size_t offset = token_array->columns.s_tokens++ - token_array->columns.tail_start;
+  tail->types[offset]   = (uint8_t)type;
+  tail->locs[offset]    = loc;
+  tail->lengths[offset] = (uint32_t)length;
+  tail->values[offset]  = column_value;
 }
 
-static const char *goc_lexer_token_type_match_str(TokenType type) {
-  switch (type) {
-    case TT_LBRACE:              return "TT_LBRACE";
-    case TT_RBRACE:              return "TT_RBRACE";
-    case TT_LPAREN:              return "TT_LPAREN";
-    case TT_RPAREN:              return "TT_RPAREN";
-    case TT_LSQPAREN:            return "TT_LSQPAREN";
-    case TT_RSQPAREN:            return "TT_RSQPAREN";
-
-    case TT_SEMICOLON:           return "TT_SEMICOLON";
-    case TT_COMMA:               return "TT_COMMA";
-    case TT_QUESTMARK:           return "TT_QUESTMARK";
-    case TT_COLON:               return "TT_COLON";
-    case TT_PERIOD:              return "TT_PERIOD";
-    case TT_EOF:                 return "TT_EOF";
-
-    // AMBIGUOUS UNTIL PARSING OPERATORS
-    case TT_PLUS:                return "TT_PLUS";
-    case TT_MINUS:               return "TT_MINUS";
-    case TT_STAR:                return "TT_STAR";
-    case TT_AMPER:               return "TT_AMPER";
-    case TT_ARROW:               return "TT_ARROW";
-
-    // UNARY OPERATORS
-    case TT_UNOP_LOG_NOT:        return "TT_UNOP_LOG_NOT";
-    case TT_UNOP_BIT_NOT:        return "TT_UNOP_BIT_NOT";
-    case TT_UNOP_INCR:           return "TT_UNOP_INCR";
-    case TT_UNOP_DECR:           return "TT_UNOP_DECR";
-
-    // BIN OPERATORS
-
-      // ARITHMETIC
-    case TT_BINOP_ARIT_DIV:      return "TT_BINOP_ARIT_DIV";
-    case TT_BINOP_ARIT_MOD:      return "TT_BINOP_ARIT_MOD";
-    case TT_BINOP_ARIT_PLUS_EQ:  return "TT_BINOP_ARIT_PLUS_EQ";
-    case TT_BINOP_ARIT_MINUS_EQ: return "TT_BINOP_ARIT_MINUS_EQ";
-    case TT_BINOP_ARIT_MUL_EQ:   return "TT_BINOP_ARIT_MUL_EQ";
-    case TT_BINOP_ARIT_DIV_EQ:   return "TT_BINOP_ARIT_DIV_EQ";
-    case TT_BINOP_ARIT_MOD_EQ:   return "TT_BINOP_ARIT_MOD_EQ";
-    
-      // COMPARISON
-    case TT_BINOP_COMP_EQ:       return "TT_BINOP_COMP_EQ";
-    case TT_BINOP_COMP_NEQ:      return "TT_BINOP_COMP_NEQ";
-    case TT_BINOP_COMP_LTHAN:    return "TT_BINOP_COMP_LTHAN";
-    case TT_BINOP_COMP_GTHAN:    return "TT_BINOP_COMP_GTHAN";
-    case TT_BINOP_COMP_LTHAN_EQ: return "TT_BINOP_COMP_LTHAN_EQ";
-    case TT_BINOP_COMP_GTHAN_EQ: return "TT_BINOP_COMP_GTHAN_EQ";
-
-      // LOGICAL
-    case TT_BINOP_LOG_AND:       return "TT_BINOP_LOG_AND";
-    case TT_BINOP_LOG_OR:        return "TT_BINOP_LOG_OR";
-    
-      // BITWISE ARITHMETIC
-    case TT_BINOP_BIT_AND:       return "TT_BINOP_BIT_AND";
-    case TT_BINOP_BIT_OR:        return "TT_BINOP_BIT_OR";
-    case TT_BINOP_BIT_XOR:       return "TT_BINOP_BIT_XOR";
-    case TT_BINOP_BIT_LSHIFT:    return "TT_BINOP_BIT_LSHIFT";
-    case TT_BINOP_BIT_RSHIFT:      return "TT_BINOP_BIT_RSHIFT";
-
-    case TT_BINOP_BIT_AND_EQ:    return "TT_BINOP_BIT_AND_EQ";
-    case TT_BINOP_BIT_OR_EQ:     return "TT_BINOP_BIT_OR_EQ";
-    case TT_BINOP_BIT_XOR_EQ:    return "TT_BINOP_BIT_XOR_EQ";
-    case TT_BINOP_BIT_LSHIFT_EQ: return "TT_BINOP_BIT_LSHIFT_EQ";
-    case TT_BINOP_BIT_RSHIFT_EQ: return "TT_BINOP_BIT_RSHIFT_EQ";
-
-    // ASSIGN
-    case TT_ASSIGN:              return "TT_ASSIGN";
-    case TT_AUTO_ASSIGN:         return "TT_AUTO_ASSIGN";      
-
-    // VALUES
-    case TT_NUM_LIT:             return "TT_NUM_LIT";
-    case TT_REAL_LIT:            return "TT_REAL_LIT";
-
-    // KEYWORDS
-    case TT_STRING_LIT:          return "TT_STRING_LIT";
-    case TT_CHAR_LIT:            return "TT_CHAR_LIT";
-
-    case TT_INT8:                return "TT_INT8";
-    case TT_INT16:               return "TT_INT16";
-    case TT_INT32:               return "TT_INT32";
-    case TT_INT64:               return "TT_INT64";
-
-    case TT_UINT8:               return "TT_UINT8";
-    case TT_UINT16:              return "TT_UINT16";
-    case TT_UINT32:              return "TT_UINT32";
-    case TT_UINT64:              return "TT_UINT64";
-
-    case TT_FLOAT:               return "TT_FLOAT";
-    case TT_DOUBLE:              return "TT_DOUBLE";
-
-    case TT_CHAR:                return "TT_CHAR";
-    case TT_STRING:              return "TT_STRING";
-    
-    case TT_BOOL:                return "TT_BOOL";
-    case TT_TRUE_LIT:            return "TT_TRUE_LIT";
-    case TT_FALSE_LIT:           return "TT_FALSE_LIT";
-
-    case TT_IF:                  return "TT_IF";
-    case TT_ELSE:                return "TT_ELSE";
-
-    case TT_SWITCH:              return "TT_SWITCH";
-    case TT_CASE:                return "TT_CASE";
-
-    case TT_WHILE:               return "TT_WHILE";
-    case TT_FOR:                 return "TT_FOR";
-    case TT_DO:                  return "TT_DO";
-    case TT_NULL_ITERATOR:       return "TT_NULL_ITERATOR";
-    case TT_RANGE:               return "TT_RANGE";
-
-    case TT_PACKAGE:             return "TT_PACKAGE";
-    case TT_IMPORT:              return "TT_IMPORT";
-    case TT_TYPE:                return "TT_TYPE";
-
-    case TT_FUNC:                return "TT_FUNC";
-    case TT_STRUCT:              return "TT_STRUCT";
-    case TT_INTERFACE:           return "TT_INTERFACE";
-    case TT_ENUM:                return "TT_ENUM";
-    case TT_UNION:               return "TT_UNION";
-
-    case TT_NIL:                 return "TT_NIL";
-    case TT_IOTA:                return "TT_IOTA";
-    case TT_RETURN:              return "TT_RETURN";
-    case TT_VAR:                 return "TT_VAR";
-    case TT_CONST:               return "TT_CONST";
-    case TT_IDENT:               return "TT_IDENT";
- 
-    default:                     return "TT_UNKNOWN";
-  }
-}
-
-static void goc_lexer_update_token_pos(struct token_pos *global, struct token_pos *pos, const char ch) {
-  if (global == NULL)
-    return;
-  global->abs++;
-  global->line += (ch == CHAR_NEW_LINE);
-  global->rel = (ch == CHAR_NEW_LINE) ? 0 : global->rel + 1;
+// window selects the SIMD engine, NULL the scalar one
+static TokenArray goc_lexer_tokenize(struct lexer_buffer *buffer, const char *name, struct lexer_simd_window *window) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
 
-  if (pos == NULL)
-    return;
+  if (buffer->source == GOC_SOURCE_ID_INVALID)
+    buffer->source = goc_source_register(name, buffer->data, buffer->s_data);
 
-  size_t s_word = pos->s_word;
-  if (!goc_lexer_skip(ch))
-    pos->s_word++;
-  if (s_word > 0)
-    return;
-  pos->abs  = global->abs;
-  pos->line = global->line;
-  pos->rel  = global->rel;
-}
-
-static char goc_lexer_peek(FILE *file) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  char ch = fgetc(file);
-  ungetc(ch, file);
-  return ch;
-}
-
-static char goc_lexer_peek_n(FILE *file, uint32_t n) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_inval_arg, n <= TOKEN_MAX_PEEK);
-  uint64_t current_pos = ftell(file);
-  if (current_pos == -1)
-    return CHAR_NULL;
-  char peek_buffer[TOKEN_MAX_PEEK] = { CHAR_NULL };
-  if (fgets(peek_buffer, n + 1, file) == NULL)
-    return CHAR_NULL;
-  fseek(file, current_pos, SEEK_SET);
-  return peek_buffer[n - 1];
-}
-
-static char goc_lexer_consume(FILE *file, struct token_pos *global, struct token_pos *pos) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, global != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
-  char ch = fgetc(file);
-  goc_lexer_update_token_pos(global, pos, ch);
-  return ch;
-}
-
-static void goc_lexer_unconsume_char(FILE *file, struct token_pos *global, struct token_pos *pos, const char ch) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, global != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
-
-  global->abs--;
-  if (ch == CHAR_NEW_LINE) {
-    global->line--;
-
-    fseek(file, 0, SEEK_SET);
-    char line_buffer[TOKEN_TEXT_MAX_SIZE];
-    uint32_t current_line = 1;
-    for (; fgets(line_buffer, sizeof(line_buffer), file); current_line++)
-      if (current_line == global->line) {
-        global->rel = strlen(line_buffer) - 1;
-        break;
-      }
+  size_t s_estimate = buffer->s_data / token_bytes_estimate + 1;
+  TokenArray tokens = goc_lexer_token_array_create(s_estimate, s_estimate / token_literals_ratio);
+  goc_error_assert(goc_error_mem_error, tokens != NULL);
+  buffer->diagnostics = tokens->diagnostics;
+  goc_lexer_tokenize_range(buffer, tokens, goc_source_loc(buffer->source, 0), window);
 
-    fseek(file, global->abs, SEEK_SET);
-    ungetc(ch, file);
-    return;
-  }
-  global->rel--;
-  if (!goc_lexer_skip(ch))
-    pos->s_word--;
-  ungetc(ch, file);
+  tokens->source = *buffer;
+  tokens->source.cursor = tokens->source.start = 0;
+  return tokens;
 }
 
-static bool goc_lexer_consume_char(FILE *file, struct token_pos *global, struct token_pos *pos, const char ch) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, global != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
-
-  char consumed = fgetc(file);
-  if (consumed != ch) {
-    ungetc(consumed, file);
-    return false;
+// Lexes from buffer->cursor up to buffer->s_data, EOF token included, base is the loc of offset 0
+static void goc_lexer_tokenize_range(
+  struct lexer_buffer *buffer, TokenArray tokens, SourceLoc base, struct lexer_simd_window *window
+) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, tokens != NULL);
+  for (TokenType type = TT_BEGIN; type != TT_EOF; ) {
+    union token_value value = {0};
+    type = window ? goc_lexer_get_token_simd(buffer, window, &value) : goc_lexer_get_token(buffer, &value);
+    goc_lexer_token_array_push(tokens, type, base + (SourceLoc)buffer->start, buffer->cursor - buffer->start, &value);
   }
-  goc_lexer_update_token_pos(global, pos, ch);
-  return true;
 }
 
-static char goc_lexer_consume_wspace(FILE *file, struct token_pos *global, struct token_pos *pos) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, global != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
-  while (goc_lexer_skip(goc_lexer_peek(file)))
-    (void)goc_lexer_consume(file, global, pos);
-  return goc_lexer_consume(file, global, pos);
-}
+// Splits the source into chunks lexed by a pool of threads, each interning into its own table. The tables are
+// then merged into the global one in chunk order, which hands out the same symbol ids as a sequential run, and
+// the chunks are copied into one TokenArray with their symbols and literal indices remapped.
+static TokenArray goc_lexer_tokenize_parallel(struct lexer_buffer *buffer, const char *name, uint32_t s_threads) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
 
-static char goc_lexer_consume_comment(FILE *file, struct token_pos *global, struct token_pos *pos, char ch) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, global != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
+  if (s_threads == 0) {
+    long s_cores = sysconf(_SC_NPROCESSORS_ONLN);
+    s_threads = s_cores > 0 ? (uint32_t)s_cores : 1;
+  }
+  size_t s_chunks = buffer->s_data / lexer_chunk_size_min;
+  if (s_chunks > (size_t)s_threads * lexer_chunks_per_thread)
+    s_chunks = (size_t)s_threads * lexer_chunks_per_thread;
+
+  struct lexer_simd_window window = { .isa = goc_lexer_simd_resolve_isa(LEXER_SIMD_AUTO) };
+  if (s_threads == 1 || s_chunks <= 1)
+    return goc_lexer_tokenize(buffer, name, &window);
+
+  if (buffer->source == GOC_SOURCE_ID_INVALID)
+    buffer->source = goc_source_register(name, buffer->data, buffer->s_data);
+  struct lexer_chunk *chunks = (struct lexer_chunk *)calloc(s_chunks, sizeof(struct lexer_chunk));
+  goc_error_assert(goc_error_mem_error, chunks != NULL);
+  struct lexer_pool pool = {
+    .buffer = buffer, .chunks = chunks, .s_chunks = goc_lexer_parallel_split(buffer, chunks, s_chunks),
+    .base = goc_source_loc(buffer->source, 0), .isa = window.isa
+  };
+  goc_lexer_parallel_run(&pool, s_threads, goc_lexer_parallel_lex);
+
+  size_t s_tokens = 0,
+         s_literals = 0;
+  for (size_t index = 0; index < pool.s_chunks; index++) {
+    struct lexer_chunk *chunk = &(chunks[index]);
+    chunk->token_offset = s_tokens;
+    chunk->literal_offset = s_literals;
+    s_tokens += chunk->tokens->columns.s_tokens;
+    s_literals += chunk->tokens->columns.s_literals;
+
+    size_t s_symbols = goc_intern_table_get_count(chunk->symbols);
+    chunk->symbols_map = (SymbolId *)malloc((s_symbols + 1) * sizeof(SymbolId));
+    goc_error_assert(goc_error_mem_error, chunk->symbols_map != NULL);
+    chunk->symbols_map[GOC_SYMBOL_INVALID] = GOC_SYMBOL_INVALID;
+    for (SymbolId id = 1; id <= s_symbols; id++)
+      chunk->symbols_map[id] = goc_intern(
+        goc_intern_table_get_text(chunk->symbols, id), goc_intern_table_get_size(chunk->symbols, id)
+      );
+  }
 
-  if (ch != CHAR_SLASH)
-    return ch;
+  // Sized exactly, the result is a single segment the threads copy into
+  pool.tokens = goc_lexer_token_array_create(s_tokens, s_literals);
+  goc_error_assert(goc_error_mem_error, pool.tokens != NULL);
+  pool.tokens->columns.s_tokens = s_tokens;
+  pool.tokens->columns.s_literals = s_literals;
+  atomic_store(&(pool.next), 0);
+  goc_lexer_parallel_run(&pool, s_threads, goc_lexer_parallel_merge);
+
+  // Diagnostics are kept in chunk order, the order a sequential run reports them in
+  for (size_t index = 0; index < pool.s_chunks; index++) {
+    goc_diagnostics_append(pool.tokens->diagnostics, chunks[index].tokens->diagnostics);
+    goc_lexer_token_array_free(chunks[index].tokens);
+    goc_intern_table_free(chunks[index].symbols);
+    free(chunks[index].symbols_map);
+  }
+  free(chunks);
 
-  switch (ch = goc_lexer_peek(file)) {
-    case CHAR_SLASH: {
-      (void)goc_lexer_consume_char(file, global, pos, CHAR_SLASH);
-      while ((ch = goc_lexer_consume(file, global, pos)) != CHAR_NEW_LINE);
-      break;
+  TokenArray tokens = pool.tokens;
+#if GOC_CHECK_LEVEL >= GOC_CHECK_PARANOID
+  for (size_t index = 1, offset; index < tokens->columns.s_tokens; index++) {
+    SourceLoc previous = goc_lexer_token_array_segment(tokens, index - 1, &offset)->locs[offset];
+    goc_error_check(goc_error_inval_arg, previous <= goc_lexer_token_array_segment(tokens, index, &offset)->locs[offset]);
+  }
+#endif
+  tokens->source = *buffer;
+  tokens->source.cursor = tokens->source.start = 0;
+  return tokens;
+}
+
+// Boundary pre-pass: one sequential walk that only stops at quotes, apostrophes and slashes, tracking the string,
+// char literal and comment state the lexer would be in. Chunks end at the first whitespace outside all of them past
+// their share of the source, so no token crosses a boundary. Returns the number of chunks actually placed.
+static size_t goc_lexer_parallel_split(struct lexer_buffer *buffer, struct lexer_chunk *chunks, size_t s_chunks) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, chunks != NULL);
+
+  const char *data = buffer->data;
+  size_t s_data = buffer->s_data,
+         s_share = s_data / s_chunks,
+         chunk = 0,
+         pos = 0;
+  chunks[0].start = 0;
+  while (pos < s_data && chunk + 1 < s_chunks) {
+    switch (data[pos]) {
+      case CHAR_WSPACE: case CHAR_NEW_LINE: case CHAR_TAB: {
+        if (pos >= (chunk + 1) * s_share) {
+          chunks[chunk].end = pos;
+          chunks[++chunk].start = pos;
+        }
+        pos++;
+        break;
+      }
+      case CHAR_QUOTE: case CHAR_BACKTICK: {
+        // An unterminated literal ends at its new line, which is left to the whitespace case
+        size_t end = goc_lexer_string_end(data, s_data, pos, NULL);
+        pos = end < s_data && data[end] == data[pos] ? end + 1 : end;
+        break;
+      }
+      case CHAR_APOST: {
+        bool valid;
+        pos = goc_lexer_char_lit_end(data, s_data, pos, &valid);
+        break;
+      }
+      case CHAR_SLASH: {
+        char next = pos + 1 < s_data ? data[pos + 1] : CHAR_NULL;
+        if (next == CHAR_SLASH) {
+          const char *end = memchr(data + pos, CHAR_NEW_LINE, s_data - pos);
+          pos = end ? (size_t)(end - data) : s_data;
+        } else if (next == CHAR_STAR) {
+          for (pos += 2; pos + 1 < s_data && !goc_lexer_comment_block_end(data[pos], data[pos + 1]); pos++);
+          pos += 2;
+        } else {
+          pos++;
+        }
+        break;
+      }
+      default: {
+        pos++;
+        break;
+      }
     }
-    case CHAR_STAR: {
-      (void)goc_lexer_consume_char(file, global, pos, CHAR_STAR);
-      char next = goc_lexer_consume(file, global, pos);
-      for (; !goc_lexer_comment_block_end(ch, next); next = goc_lexer_consume(file, global, pos))
-        if (goc_lexer_comment_block_end(next, ch = goc_lexer_consume(file, global, pos)))
-          break;
-      ch = goc_lexer_consume(file, global, pos);
-      break;
+  }
+  chunks[chunk].end = s_data;
+  return chunk + 1;
+}
+
+// Runs worker on min(s_threads, s_chunks) threads, the calling thread being one of them
+static void goc_lexer_parallel_run(struct lexer_pool *pool, uint32_t s_threads, void *worker(void *arg)) {
+  goc_error_check(goc_error_nullptr, pool != NULL);
+
+  size_t s_workers = s_threads < pool->s_chunks ? s_threads : pool->s_chunks;
+  pthread_t *threads = (pthread_t *)malloc(s_workers * sizeof(pthread_t));
+  goc_error_assert(goc_error_mem_error, threads != NULL);
+
+  // A thread that cannot be started just leaves its chunks to the others
+  size_t s_started = 0;
+  for (; s_started + 1 < s_workers && pthread_create(&(threads[s_started]), NULL, worker, pool) == 0; s_started++);
+  (void)worker(pool);
+  for (size_t thread = 0; thread < s_started; thread++)
+    pthread_join(threads[thread], NULL);
+  free(threads);
+}
+
+static void *goc_lexer_parallel_lex(void *arg) {
+  struct lexer_pool *pool = (struct lexer_pool *)arg;
+  struct lexer_simd_window window = { .isa = pool->isa };
+
+  for (size_t index; (index = atomic_fetch_add(&(pool->next), 1)) < pool->s_chunks; ) {
+    struct lexer_chunk *chunk = &(pool->chunks[index]);
+    chunk->symbols = goc_intern_table_create();
+    size_t s_estimate = (chunk->end - chunk->start) / token_bytes_estimate + 1;
+    chunk->tokens = goc_lexer_token_array_create(s_estimate, s_estimate / token_literals_ratio);
+    goc_error_assert(goc_error_mem_error, chunk->symbols != NULL && chunk->tokens != NULL);
+
+    // The chunk's lexer sees the source as ending at the chunk end, offsets stay those of the whole source
+    struct lexer_buffer buffer = {
+      pool->buffer->data, chunk->end, chunk->start, chunk->start, pool->buffer->source, chunk->symbols,
+      NULL, NULL, 0, chunk->tokens->diagnostics
+    };
+    window.base = window.s_blocks = 0;
+    goc_lexer_tokenize_range(&buffer, chunk->tokens, pool->base, &window);
+    free(buffer.scratch);
+
+    // Only the last chunk ends the token stream
+    if (index + 1 < pool->s_chunks)
+      chunk->tokens->columns.s_tokens--;
+  }
+  return NULL;
+}
+
+static void *goc_lexer_parallel_merge(void *arg) {
+  struct lexer_pool *pool = (struct lexer_pool *)arg;
+  TokenArray tokens = pool->tokens;
+
+  for (size_t index; (index = atomic_fetch_add(&(pool->next), 1)) < pool->s_chunks; ) {
+    struct lexer_chunk *chunk = &(pool->chunks[index]);
+    TokenArray source = chunk->tokens;
+    struct token_segment *target = &(tokens->columns.segments[0]);
+
+    // The chunk's own segments are copied one after the other
+    for (size_t segment = 0, start = 0; start < source->columns.s_tokens; segment++) {
+      struct token_segment *from = &(source->columns.segments[segment]);
+      size_t s_segment = (size_t)1 << (source->columns.segment_shift + segment),
+             s_copy = source->columns.s_tokens - start < s_segment ? source->columns.s_tokens - start : s_segment,
+             offset = chunk->token_offset + start;
+
+      memcpy(target->types + offset, from->types, s_copy * sizeof(uint8_t));
+      memcpy(target->locs + offset, from->locs, s_copy * sizeof(SourceLoc));
+      memcpy(target->lengths + offset, from->lengths, s_copy * sizeof(uint32_t));
+      for (size_t token = 0; token < s_copy; token++) {
+        uint32_t value = from->values[token];
+        switch ((TokenType)from->types[token]) {
+          case TT_IDENT: case TT_STRING_LIT: value = chunk->symbols_map[value];            break;
+          case TT_NUM_LIT: case TT_REAL_LIT: value += (uint32_t)chunk->literal_offset;    break;
+          default:                                                                          break;
+        }
+        target->values[offset + token] = value;
+      }
+      start += s_copy;
     }
-    default: {
-      return CHAR_SLASH;
+
+    for (size_t segment = 0, start = 0; start < source->columns.s_literals; segment++) {
+      size_t s_segment = (size_t)1 << (source->columns.literal_shift + segment),
+             s_copy = source->columns.s_literals - start < s_segment ? source->columns.s_literals - start : s_segment;
+      memcpy(
+        tokens->columns.literals[0] + chunk->literal_offset + start, source->columns.literals[segment], s_copy * sizeof(union token_value)
+      );
+      start += s_copy;
     }
   }
-
-  return ch;
+  return NULL;
 }
 
-static TokenType goc_lexer_consume_number(FILE *file, struct token_pos *global, struct token_pos *pos, union token_value *value) { 
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, global != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
-  goc_error_assert(goc_error_nullptr, value != NULL);
-
-  if (!goc_lexer_base_alpha(goc_lexer_peek(file)))
-    goc_error_lexer_print_invalid_number(file, pos->abs, pos->line, pos->rel, pos->s_word);
+// Makes s_want bytes past the cursor available unless the input ends first. Everything before the cursor is
+// dropped to make room, once its lines have been counted.
+static void goc_lexer_stream_fill(struct lexer_stream *stream, size_t s_want) {
+  goc_error_check(goc_error_nullptr, stream != NULL);
+  goc_error_check(goc_error_inval_arg, s_want <= stream->s_ring);
 
-  uint32_t base = BASE_10,
-           digit = 0,
-           exp = 0;
-  int32_t  num_lit = 0;
-  double   real_lit = 0;
-  bool     consumed_period = false;
+  struct lexer_buffer *buffer = &(stream->buffer);
+  if (stream->eof || buffer->s_data - buffer->cursor >= s_want)
+    return;
 
-  if (goc_lexer_peek(file) == CHAR_ZERO && goc_lexer_peek_n(file, 2) == CHAR_HEXA) {
-    base = BASE_16;
-    (void)goc_lexer_consume_char(file, global, pos, CHAR_ZERO);
-    (void)goc_lexer_consume_char(file, global, pos, CHAR_HEXA);
+  // The start of the cursor's line is kept too when it is close and leaves room, for the line text of diagnostics
+  goc_lexer_stream_count_lines(stream, buffer->cursor);
+  size_t keep = buffer->cursor;
+  if (stream->line_start >= stream->offset) {
+    size_t s_line = buffer->cursor - (stream->line_start - stream->offset);
+    if (s_line <= lexer_stream_lookahead && s_line + s_want <= stream->s_ring)
+      keep -= s_line;
+  }
+  if (keep > 0) {
+    size_t s_keep = buffer->s_data - keep;
+    memmove(stream->ring, stream->ring + keep, s_keep);
+    stream->offset += keep;
+    buffer->s_data = s_keep;
+    buffer->cursor = buffer->start = stream->scan = buffer->cursor - keep;
   }
- 
-  while (goc_lexer_base_alpha(goc_lexer_peek(file))) {
-    char ch = goc_lexer_consume(file, global, pos);
-    if (ch == CHAR_PERIOD && base == BASE_10) {
-      consumed_period = true;
-      real_lit = (double)num_lit;
+
+  while (!stream->eof && buffer->s_data - buffer->cursor < s_want) {
+    ssize_t s_read = read(stream->fd, stream->ring + buffer->s_data, stream->s_ring - buffer->s_data);
+    if (s_read == -1 && errno == EINTR)
       continue;
+    if (s_read == -1)
+      goc_error_lexer_print_input_file(stream->name);
+    stream->eof = s_read == 0;
+    buffer->s_data += (size_t)s_read;
+  }
+}
+
+// String literals are not bounded, the window is refilled until it holds the one at the cursor whole, and doubled
+// when the literal alone fills it
+static void goc_lexer_stream_fill_string(struct lexer_stream *stream) {
+  goc_error_check(goc_error_nullptr, stream != NULL);
+
+  struct lexer_buffer *buffer = &(stream->buffer);
+  while (!stream->eof && goc_lexer_string_end(buffer->data, buffer->s_data, buffer->cursor, NULL) >= buffer->s_data) {
+    if (buffer->s_data - buffer->cursor == stream->s_ring) {
+      char *ring = (char *)realloc(stream->ring, 2 * stream->s_ring);
+      goc_error_assert(goc_error_mem_error, ring != NULL);
+      stream->ring = ring;
+      stream->s_ring *= 2;
+      buffer->data = ring;
     }
+    goc_lexer_stream_fill(stream, buffer->s_data - buffer->cursor + 1);
+  }
+}
+
+// Skips whitespace and comments up to the next token start, refilling the window as they run out
+static void goc_lexer_stream_skip(struct lexer_stream *stream) {
+  goc_error_check(goc_error_nullptr, stream != NULL);
 
-    digit = goc_lexer_base_convert(file, pos, ch, base);
-    if (consumed_period) {
-      exp++;
-      real_lit = real_lit + (double)digit / pow_int(base, exp);
+  struct lexer_buffer *buffer = &(stream->buffer);
+  enum { SKIP_CODE, SKIP_LINE_COMMENT, SKIP_BLOCK_COMMENT } state = SKIP_CODE;
+  for (;;) {
+    // Two bytes tell a comment start from a slash
+    if (buffer->s_data - buffer->cursor < 2 && !stream->eof) {
+      goc_lexer_stream_fill(stream, 2);
       continue;
     }
-    num_lit = num_lit * base + digit;
+    if (buffer->cursor >= buffer->s_data)
+      return;
+
+    const char *data = buffer->data;
+    size_t s_data = buffer->s_data;
+    switch (state) {
+      case SKIP_CODE: {
+        char ch = data[buffer->cursor],
+             next = buffer->cursor + 1 < s_data ? data[buffer->cursor + 1] : CHAR_NULL;
+        if (goc_lexer_skip(ch))
+          buffer->cursor++;
+        else if (ch == CHAR_SLASH && (next == CHAR_SLASH || next == CHAR_STAR)) {
+          state = next == CHAR_SLASH ? SKIP_LINE_COMMENT : SKIP_BLOCK_COMMENT;
+          buffer->cursor += 2;
+        } else
+          return;
+        break;
+      }
+      case SKIP_LINE_COMMENT: {
+        const char *end = memchr(data + buffer->cursor, CHAR_NEW_LINE, s_data - buffer->cursor);
+        buffer->cursor = end ? (size_t)(end - data) + 1 : s_data;
+        state = end ? SKIP_CODE : state;
+        break;
+      }
+      case SKIP_BLOCK_COMMENT: {
+        size_t pos = buffer->cursor;
+        for (; pos + 1 < s_data && !goc_lexer_comment_block_end(data[pos], data[pos + 1]); pos++);
+        if (pos + 1 < s_data) {
+          buffer->cursor = pos + 2;
+          state = SKIP_CODE;
+        } else {
+          // Keep a trailing '*', its '/' may come with the next read
+          buffer->cursor = stream->eof ? s_data : pos;
+        }
+        break;
+      }
+    }
   }
+}
 
-  if (consumed_period) {
-    value->real_lit = real_lit;
-    return TT_REAL_LIT;
+// Advances line counting from ring[scan] to ring[pos]
+static void goc_lexer_stream_count_lines(struct lexer_stream *stream, size_t pos) {
+  goc_error_check(goc_error_nullptr, stream != NULL);
+  if (pos <= stream->scan)
+    return;
+  const char *data = stream->ring;
+  for (const char *nl, *cursor = data + stream->scan; (nl = memchr(cursor, CHAR_NEW_LINE, (size_t)(data + pos - cursor))); cursor = nl + 1) {
+    stream->line++;
+    stream->line_start = stream->offset + (size_t)(nl + 1 - data);
   }
-
-  value->num_lit = num_lit;
-  return TT_NUM_LIT;
+  stream->scan = pos;
 }
 
-static TokenType goc_lexer_consume_string_lit(
-  FILE *file, struct token_pos *global, struct token_pos *pos, union token_value *value, char ch
-) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, global != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
-  if (ch != CHAR_QUOTE)
-    goc_error_lexer_print_invalid_string_lit(file, pos->line, pos->rel, pos->abs, pos->s_word);
-  value->text[0] = ch;
-  size_t index = 1;
-  for (; (ch = goc_lexer_consume(file, global, pos)) != CHAR_QUOTE; value->text[index] = ch, index++)
-    if (index + 1 >= TOKEN_TEXT_MAX_SIZE)
-      goc_error_lexer_print_buffer_overrun(file, pos->line, pos->rel, pos->abs, pos->s_word);
-  value->text[index] = ch;
-  return TT_STRING_LIT;
+// The file is read once by goc_source, the buffer only views it
+static bool goc_lexer_buffer_load(const char *file_name, struct lexer_buffer *buffer) {
+  goc_error_check(goc_error_nullptr, file_name != NULL);
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+
+  SourceId source = goc_source_load(file_name);
+  if (source == GOC_SOURCE_ID_INVALID)
+    return false;
+  *buffer = (struct lexer_buffer){ goc_source_get_data(source), goc_source_get_size(source), 0, 0, source };
+  return true;
 }
 
-static TokenType goc_lexer_consume_char_lit(
-  FILE *file, struct token_pos *global, struct token_pos *pos, union token_value *value, char ch
-) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, global != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
-  if (ch != CHAR_APOST)
-    goc_error_lexer_print_invalid_char_lit(file, pos->line, pos->rel, pos->abs, pos->s_word);
-  value->text[0] = ch;
-  value->text[1] = goc_lexer_consume(file, global, pos);
-  if ((ch = goc_lexer_consume(file, global, pos)) != CHAR_QUOTE)
-    goc_error_lexer_print_invalid_char_lit(file, pos->line, pos->rel, pos->abs, pos->s_word);
-  value->text[2] = ch;
-  return TT_CHAR_LIT;
-}
-
-static uint32_t goc_lexer_base_convert(FILE *file, struct token_pos *pos, char ch, uint32_t base) {
-  goc_error_assert(goc_error_nullptr, file != NULL);
-  goc_error_assert(goc_error_nullptr, pos != NULL);
-  goc_error_assert(goc_error_inval_arg, base == BASE_16 || base == BASE_10);
-  if (!goc_lexer_base_alpha(ch))
-    goc_error_lexer_print_invalid_number(file, pos->abs, pos->line, pos->rel, pos->s_word);
-  return isdigit(ch) ? (ch - '0') : (islower(ch) ? (ch - 'a' + 10) : (ch - 'A' + 10));
-}
-
-static bool goc_lexer_base_alpha(char ch) {
-  return (
-    (isdigit(ch) || ch == CHAR_PERIOD) && BASE_10) || ((isdigit(ch) || (ch >= 'A' && ch <= 'F') || (ch >= 'a' && ch <= 'f')) && BASE_16
+static void goc_lexer_buffer_unload(struct lexer_buffer *buffer) {
+  if (buffer == NULL)
+    return;
+  free(buffer->scratch);
+  *buffer = (struct lexer_buffer){0};
+}
+
+// Records an error at offset, spanning the text consumed so far, then lexing goes on. The line is copied from the
+// registered source (a chunk only sees its own part of it), or from the window of a stream, where lines are counted.
+static void goc_lexer_report(struct lexer_buffer *buffer, const char *message, size_t offset) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, buffer->diagnostics != NULL);
+
+  const char *data = buffer->data,
+             *text;
+  size_t s_data = buffer->s_data,
+         pos = offset,
+         line, rel, s_line;
+  struct lexer_stream *stream = buffer->stream;
+  if (stream != NULL) {
+    // Lines are counted on from the token start without moving the stream's count, which the token's line is
+    goc_error_check(goc_error_inval_arg, offset >= stream->scan);
+    size_t line_abs = stream->line_start;
+    line = stream->line;
+    for (const char *nl, *cursor = data + stream->scan; (nl = memchr(cursor, CHAR_NEW_LINE, (size_t)(data + offset - cursor))); cursor = nl + 1) {
+      line++;
+      line_abs = stream->offset + (size_t)(nl + 1 - data);
+    }
+    pos = stream->offset + offset;
+    rel = pos - line_abs + 1;
+    size_t line_start = line_abs > stream->offset ? line_abs - stream->offset : 0;
+    const char *line_end = memchr(data + line_start, CHAR_NEW_LINE, s_data - line_start);
+    s_line = (line_end ? (size_t)(line_end - data) : s_data) - line_start;
+    text = data + line_start;
+  } else {
+    SourceLoc loc = goc_source_loc(buffer->source, offset);
+    line = goc_source_loc_line(loc);
+    rel = goc_source_loc_rel(loc);
+    text = goc_source_line_text(buffer->source, line, &s_line);
+  }
+
+  goc_diagnostics_add(
+    buffer->diagnostics, goc_error_lexer_invalid_syntax, message,
+    stream ? stream->name : goc_source_get_name(buffer->source), text, s_line,
+    (uint32_t)pos + 1, (uint32_t)line, (uint32_t)rel, (uint32_t)(buffer->cursor - buffer->start)
   );
 }
 
-static bool goc_lexer_comment_block_end(char ch, char next) {
-  return ch == CHAR_STAR && next == CHAR_SLASH;
-}
+static TokenType goc_lexer_get_token(struct lexer_buffer *buffer, union token_value *value) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, value != NULL);
 
-static bool goc_lexer_ident(char ch) {
-  return isalpha(ch) || ch == CHAR_UNDER;
+  char ch;
+  while ((ch = goc_lexer_consume_comment(buffer, goc_lexer_consume_wspace(buffer))) == CHAR_WSPACE);
+  return goc_lexer_match_token(buffer, ch, value);
 }
 
-static bool goc_lexer_ident_middle(char ch) {
-  return isalpha(ch) || isdigit(ch) || ch == CHAR_UNDER;
-}
+// Token starting with ch, already consumed at buffer->start
+static TokenType goc_lexer_match_token(struct lexer_buffer *buffer, char ch, union token_value *value) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, value != NULL);
 
-static bool goc_lexer_skip(char ch) {
-  return ch == CHAR_WSPACE || ch == CHAR_NEW_LINE || ch == CHAR_TAB;
-}
+  LexerCharClass class = goc_lexer_char_class(ch);
+  switch (class) {
+    case LEXER_CLASS_QUOTE: return goc_lexer_consume_string_lit(buffer, value, ch);
+    case LEXER_CLASS_APOST: return goc_lexer_consume_char_lit(buffer, ch);
 
-static bool goc_lexer_package(char *word) {
-  return word ? strcmp(word, KEYWORD_PACKAGE) == 0 : false;
-}
+    case LEXER_CLASS_DIGIT: {
+      goc_lexer_unconsume_char(buffer);
+      return goc_lexer_consume_number(buffer, value);
+    }
 
-static bool goc_lexer_import(char *word) {
-  return word ? strcmp(word, KEYWORD_IMPORT) == 0 : false;
-}
+    case LEXER_CLASS_ALPHA: case LEXER_CLASS_HEX_ALPHA: case LEXER_CLASS_UNDER: {
+      if (
+        ch == CHAR_UNDER && !goc_lexer_ident(goc_lexer_peek(buffer))
+        && goc_lexer_ident_end(buffer->data, buffer->s_data, buffer->cursor) == buffer->cursor
+      )
+        return TT_NULL_ITERATOR;
+      return goc_lexer_consume_ident(buffer, value);
+    }
 
-static bool goc_lexer_typedef(char *word) {
-  return word ? strcmp(word, KEYWORD_TYPE) == 0 : false;
-}
+    case LEXER_CLASS_PERIOD: {
+      if (goc_lexer_char_class(goc_lexer_peek(buffer)) == LEXER_CLASS_DIGIT) {
+        goc_lexer_unconsume_char(buffer);
+        return goc_lexer_consume_number(buffer, value);
+      }
+      break;
+    }
 
-static bool goc_lexer_func(char *word) {
-  return word ? strcmp(word, KEYWORD_FUNC) == 0 : false;
-}
+    case LEXER_CLASS_OTHER: case LEXER_CLASS_WSPACE: {
+      // CHAR_EOF also stands for a 0xff byte, only the real end of the buffer is TT_EOF
+      if (ch == CHAR_EOF && buffer->start >= buffer->s_data)
+        return TT_EOF;
+      size_t s_letter = goc_lexer_letter_size(buffer->data, buffer->s_data, buffer->start, false);
+      if (s_letter > 0) {
+        buffer->cursor = buffer->start + s_letter;
+        return goc_lexer_consume_ident(buffer, value);
+      }
+      // A run of stray bytes is a single TT_UNKNOWN token, up to a letter
+      while (
+        buffer->cursor < buffer->s_data && goc_lexer_char_class(goc_lexer_peek(buffer)) == LEXER_CLASS_OTHER
+        && goc_lexer_letter_size(buffer->data, buffer->s_data, buffer->cursor, false) == 0
+      )
+        buffer->cursor++;
+      goc_lexer_report(buffer, GOC_ERROR_LEXER_INVALID_IDENT, buffer->start);
+      return TT_UNKNOWN;
+    }
 
-static bool goc_lexer_struct(char *word) {
-  return word ? strcmp(word, KEYWORD_STRUCT) == 0 : false;
-}
+    default: {
+      break;
+    }
+  }
 
-static bool goc_lexer_interface(char *word) {
-  return word ? strcmp(word, KEYWORD_INTER) == 0 : false;
+  // Operators: ch is consumed, then one table lookup per byte until the DFA stops
+  TokenType state = (TokenType)goc_lexer_operator_dfa[TT_BEGIN][class];
+  for (TokenType next; (next = (TokenType)goc_lexer_operator_dfa[state][goc_lexer_char_class(goc_lexer_peek(buffer))]) != TT_BEGIN; state = next)
+    buffer->cursor++;
+  return state;
 }
 
-static bool goc_lexer_enum(char *word) {
-  return word ? strcmp(word, KEYWORD_ENUM) == 0 : false;
+static SymbolId goc_lexer_intern(struct lexer_buffer *buffer, const char *text, size_t s_text) {
+  return buffer->symbols ? goc_intern_table_add(buffer->symbols, text, s_text) : goc_intern(text, s_text);
 }
 
-static bool goc_lexer_union(char *word) {
-  return word ? strcmp(word, KEYWORD_UNION) == 0 : false;
-}
+// Stage two of the SIMD lexer: whitespace, line comments, identifiers, string literals and plain decimal numbers
+// are delimited with the stage one masks. Operators, block comments and every input that would make the scalar
+// engine report an error go through its own routines, so both engines emit the same tokens.
+static TokenType goc_lexer_get_token_simd(
+  struct lexer_buffer *buffer, struct lexer_simd_window *window, union token_value *value
+) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, window != NULL);
+  goc_error_check(goc_error_nullptr, value != NULL);
+
+  const char *data = buffer->data;
+  size_t pos = goc_lexer_simd_find(buffer, window, LEXER_SIMD_MASK_WSPACE, buffer->cursor, false);
+  while (pos + 1 < buffer->s_data && data[pos] == CHAR_SLASH && data[pos + 1] == CHAR_SLASH) {
+    const char *end = memchr(data + pos, CHAR_NEW_LINE, buffer->s_data - pos);
+    pos = end ? goc_lexer_simd_find(buffer, window, LEXER_SIMD_MASK_WSPACE, (size_t)(end - data) + 1, false) : buffer->s_data;
+  }
+  buffer->cursor = buffer->start = pos;
+  if (pos >= buffer->s_data || (data[pos] == CHAR_SLASH && pos + 1 < buffer->s_data && data[pos + 1] == CHAR_STAR))
+    return goc_lexer_get_token(buffer, value);
+
+  char ch = data[pos];
+  if ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'z') {
+    size_t end = goc_lexer_simd_find(buffer, window, LEXER_SIMD_MASK_IDENT, pos + 1, false),
+           s_word = end - pos;
+    buffer->cursor = end;
+    // A Unicode letter goes on with the scalar engine
+    if (end < buffer->s_data && (unsigned char)data[end] >= 0x80)
+      return goc_lexer_consume_ident(buffer, value);
+    TokenType keyword = goc_lexer_keyword(data + pos, s_word);
+    if (keyword != TT_IDENT)
+      return keyword;
+    value->symbol = goc_lexer_intern(buffer, data + pos, s_word);
+    return TT_IDENT;
+  } else if (ch == CHAR_QUOTE) {
+    // Without a backslash before it the first quote closes the literal, escapes are left to the scalar engine
+    size_t end = goc_lexer_simd_find(buffer, window, LEXER_SIMD_MASK_QUOTE, pos + 1, true),
+           s_text = end - pos - 1;
+    if (
+      end < buffer->s_data && memchr(data + pos + 1, CHAR_BACKSLASH, s_text) == NULL
+      && memchr(data + pos + 1, CHAR_NEW_LINE, s_text) == NULL && goc_utf8_validate(data + pos + 1, s_text) == s_text
+    ) {
+      buffer->cursor = end + 1;
+      value->symbol = goc_lexer_intern(buffer, data + pos + 1, s_text);
+      return TT_STRING_LIT;
+    }
+  } else if (ch >= '0' && ch <= '9') {
+    buffer->cursor = pos;
+    return goc_lexer_consume_number(buffer, value);
+  }
 
-static bool goc_lexer_nil(char *word) {
-  return word ? strcmp(word, KEYWORD_NIL) == 0 : false;
+  buffer->cursor = pos + 1;
+  return goc_lexer_match_token(buffer, ch, value);
 }
 
-static bool goc_lexer_iota(char *word) {
-  return word ? strcmp(word, KEYWORD_IOTA) == 0 : false;
+// First position from pos whose membership in mask is in_class, s_data if there is none. Tokens are short, so
+// the answer is almost always in pos's own block: that case stays inline, the rest walks (and slides) the window.
+static inline size_t goc_lexer_simd_find(
+  struct lexer_buffer *buffer, struct lexer_simd_window *window, LexerSimdMask mask, size_t pos, bool in_class
+) {
+  size_t block = pos / GOC_LEXER_SIMD_BLOCK - window->base;
+  if (pos < buffer->s_data && block < window->s_blocks) {
+    uint64_t bits = window->masks[mask][block];
+    bits = (in_class ? bits : ~bits) & (~(uint64_t)0 << (pos % GOC_LEXER_SIMD_BLOCK));
+    if (bits != 0) {
+      pos = (pos & ~(size_t)(GOC_LEXER_SIMD_BLOCK - 1)) + (size_t)__builtin_ctzll(bits);
+      return pos < buffer->s_data ? pos : buffer->s_data;
+    }
+  }
+  return goc_lexer_simd_find_next(buffer, window, mask, pos, in_class);
 }
 
-static bool goc_lexer_return(char *word) {
-  return word ? strcmp(word, KEYWORD_RETURN) == 0 : false;
-}
+static size_t goc_lexer_simd_find_next(
+  struct lexer_buffer *buffer, struct lexer_simd_window *window, LexerSimdMask mask, size_t pos, bool in_class
+) {
+  while (pos < buffer->s_data) {
+    size_t block = pos / GOC_LEXER_SIMD_BLOCK;
+    if (block < window->base || block >= window->base + window->s_blocks) {
+      size_t offset = block * GOC_LEXER_SIMD_BLOCK;
+      window->base = block;
+      window->s_blocks = goc_lexer_simd_classify(buffer->data + offset, buffer->s_data - offset, window->masks, window->isa);
+    }
 
-static bool goc_lexer_var(char *word) {
-  return word ? strcmp(word, KEYWORD_VAR) == 0 : false;
+    uint64_t bits = window->masks[mask][block - window->base];
+    bits = (in_class ? bits : ~bits) & (~(uint64_t)0 << (pos % GOC_LEXER_SIMD_BLOCK));
+    if (bits != 0) {
+      pos = block * GOC_LEXER_SIMD_BLOCK + (size_t)__builtin_ctzll(bits);
+      break;
+    }
+    pos = (block + 1) * GOC_LEXER_SIMD_BLOCK;
+  }
+  return pos < buffer->s_data ? pos : buffer->s_data;
 }
 
-static bool goc_lexer_const(char *word) {
-  return word ? strcmp(word, KEYWORD_CONST) == 0 : false;
+static char goc_lexer_peek(struct lexer_buffer *buffer) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  return buffer->cursor < buffer->s_data ? buffer->data[buffer->cursor] : CHAR_EOF;
 }
 
-static bool goc_lexer_int8(char *word) {
-  return word ? strcmp(word, KEYWORD_INT8) == 0 : false;
+static char goc_lexer_consume(struct lexer_buffer *buffer) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  return buffer->cursor < buffer->s_data ? buffer->data[buffer->cursor++] : CHAR_EOF;
 }
 
-static bool goc_lexer_int16(char *word) {
-  return word ? strcmp(word, KEYWORD_INT16) == 0 : false;
+static void goc_lexer_unconsume_char(struct lexer_buffer *buffer) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_inval_arg, buffer->cursor > buffer->start);
+  buffer->cursor--;
 }
 
-static bool goc_lexer_int32(char *word) {
-  return word ? (strcmp(word, KEYWORD_INT) == 0 || strcmp(word, KEYWORD_INT32) == 0) : false;
+static char goc_lexer_consume_wspace(struct lexer_buffer *buffer) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  while (goc_lexer_skip(goc_lexer_peek(buffer)))
+    buffer->cursor++;
+  buffer->start = buffer->cursor;
+  return goc_lexer_consume(buffer);
 }
 
-static bool goc_lexer_int64(char *word) {
-  return word ? strcmp(word, KEYWORD_INT64) == 0 : false;
-}
+static char goc_lexer_consume_comment(struct lexer_buffer *buffer, char ch) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
 
-static bool goc_lexer_uint8(char *word) {
-  return word ? strcmp(word, KEYWORD_UINT8) == 0 : false;
-}
+  if (ch != CHAR_SLASH)
+    return ch;
 
-static bool goc_lexer_uint16(char *word) {
-  return word ? strcmp(word, KEYWORD_UINT16) == 0 : false;
-}
+  switch (goc_lexer_peek(buffer)) {
+    case CHAR_SLASH: {
+      const char *end = memchr(buffer->data + buffer->cursor, CHAR_NEW_LINE, buffer->s_data - buffer->cursor);
+      buffer->cursor = end ? (size_t)(end - buffer->data) + 1 : buffer->s_data;
+      break;
+    }
+    case CHAR_STAR: {
+      buffer->cursor++;
+      for (char next = goc_lexer_consume(buffer); buffer->cursor < buffer->s_data; ) {
+        ch = next;
+        next = goc_lexer_consume(buffer);
+        if (goc_lexer_comment_block_end(ch, next))
+          break;
+      }
+      break;
+    }
+    default: {
+      return CHAR_SLASH;
+    }
+  }
 
-static bool goc_lexer_uint32(char *word) {
-  return word ? (strcmp(word, KEYWORD_UINT) == 0 || strcmp(word, KEYWORD_UINT32) == 0) : false;
+  // A comment separates tokens like whitespace does
+  if (buffer->cursor < buffer->s_data)
+    return CHAR_WSPACE;
+  buffer->start = buffer->cursor;
+  return CHAR_EOF;
+}
+
+// Identifier at buffer->start, its first character consumed. ASCII runs go through the class table, a byte
+// >= 0x80 past them hands over to the UTF-8 decoder.
+static TokenType goc_lexer_consume_ident(struct lexer_buffer *buffer, union token_value *value) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, value != NULL);
+
+  while (goc_lexer_ident_middle(goc_lexer_peek(buffer)))
+    buffer->cursor++;
+  if ((unsigned char)goc_lexer_peek(buffer) >= 0x80)
+    buffer->cursor = goc_lexer_ident_end(buffer->data, buffer->s_data, buffer->cursor);
+
+  const char *word = buffer->data + buffer->start;
+  size_t s_word = buffer->cursor - buffer->start;
+  TokenType keyword = goc_lexer_keyword(word, s_word);
+  if (keyword != TT_IDENT)
+    return keyword;
+
+  value->symbol = goc_lexer_intern(buffer, word, s_word);
+  return TT_IDENT;
+}
+
+// End of the identifier going on at data[pos]: Unicode letters and digits and the ASCII runs after them
+static size_t goc_lexer_ident_end(const char *data, size_t s_data, size_t pos) {
+  for (size_t s_letter; pos < s_data && (s_letter = goc_lexer_letter_size(data, s_data, pos, true)) > 0; )
+    for (pos += s_letter; pos < s_data && goc_lexer_ident_middle(data[pos]); pos++);
+  return pos;
+}
+
+// Size of the UTF-8 encoded letter at data[pos], 0 if there is none (ASCII, invalid sequence, not a letter). With
+// digit, for the characters after the first one of an identifier, a Unicode digit counts as well.
+static size_t goc_lexer_letter_size(const char *data, size_t s_data, size_t pos, bool digit) {
+  if (pos >= s_data || (unsigned char)data[pos] < 0x80)
+    return 0;
+  size_t s_sequence = 0;
+  uint32_t code_point = goc_utf8_decode(data + pos, s_data - pos, &s_sequence);
+  if (s_sequence == 0)
+    return 0;
+  return goc_utf8_letter(code_point) || (digit && goc_utf8_digit(code_point)) ? s_sequence : 0;
+}
+
+static TokenType goc_lexer_consume_number(struct lexer_buffer *buffer, union token_value *value) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, value != NULL);
+
+  Number number = goc_number_parse(buffer->data + buffer->cursor, buffer->s_data - buffer->cursor);
+  buffer->cursor += number.s_text;
+  switch (number.kind) {
+    case NUMBER_INT: {
+      value->num_lit = (int64_t)number.value.integer;
+      return TT_NUM_LIT;
+    }
+    case NUMBER_REAL: {
+      value->real_lit = number.value.real;
+      return TT_REAL_LIT;
+    }
+    case NUMBER_OVERFLOW: {
+      goc_lexer_report(buffer, GOC_ERROR_LEXER_NUMBER_OVERFLOW, buffer->start);
+      break;
+    }
+    default: {
+      // The invalid text is skipped whole, the token spans at least one byte
+      if (buffer->cursor == buffer->start)
+        buffer->cursor++;
+      goc_lexer_report(buffer, GOC_ERROR_LEXER_INVALID_NUMBER, buffer->start);
+      break;
+    }
+  }
+  return TT_UNKNOWN;
 }
 
-static bool goc_lexer_uint64(char *word) {
-  return word ? strcmp(word, KEYWORD_UINT64) == 0 : false;
-}
+// Interpreted ("...") literals are interned decoded, raw (`...`) ones as they are. The token text stays the
+// source span, quotes included. An unterminated literal is a TT_UNKNOWN token up to the end of its first line,
+// one that is not valid UTF-8 or has invalid escapes a TT_UNKNOWN token over the whole literal.
+static TokenType goc_lexer_consume_string_lit(struct lexer_buffer *buffer, union token_value *value, char ch) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, value != NULL);
+  goc_error_check(goc_error_inval_arg, ch == CHAR_QUOTE || ch == CHAR_BACKTICK);
+
+  bool escaped = false;
+  size_t end = goc_lexer_string_end(buffer->data, buffer->s_data, buffer->start, &escaped);
+  if (end >= buffer->s_data || buffer->data[end] != ch) {
+    const char *line_end = memchr(buffer->data + buffer->cursor, CHAR_NEW_LINE, buffer->s_data - buffer->cursor);
+    buffer->cursor = line_end ? (size_t)(line_end - buffer->data) : buffer->s_data;
+    goc_lexer_report(buffer, GOC_ERROR_LEXER_INVALID_STRING_LIT, buffer->start);
+    return TT_UNKNOWN;
+  }
+  buffer->cursor = end + 1;
 
-static bool goc_lexer_float(char *word) {
-  return word ? strcmp(word, KEYWORD_FLOAT) == 0 : false;
-}
+  size_t s_raw = end - buffer->start - 1,
+         invalid = goc_utf8_validate(buffer->data + buffer->start + 1, s_raw);
+  if (invalid < s_raw) {
+    goc_lexer_report(buffer, GOC_ERROR_LEXER_INVALID_UTF8, buffer->start + 1 + invalid);
+    return TT_UNKNOWN;
+  }
 
-static bool goc_lexer_double(char *word) {
-  return word ? strcmp(word, KEYWORD_DOUBLE) == 0 : false;
+  if (escaped) {
+    size_t s_errors = goc_diagnostics_get_count(buffer->diagnostics),
+           s_text = goc_lexer_string_decode(buffer, buffer->start + 1, end);
+    if (goc_diagnostics_get_count(buffer->diagnostics) != s_errors)
+      return TT_UNKNOWN;
+    value->symbol = goc_lexer_intern(buffer, buffer->scratch, s_text);
+  } else {
+    value->symbol = goc_lexer_intern(buffer, buffer->data + buffer->start + 1, end - buffer->start - 1);
+  }
+  return TT_STRING_LIT;
 }
 
-static bool goc_lexer_char(char *word) {
-  return word ? strcmp(word, KEYWORD_CHAR) == 0 : false;
-}
+// Offset of the delimiter closing the literal opened at data[pos], s_data if it is not closed. An interpreted
+// literal does not span lines, the offset of the new line ending it is returned when it is not closed on its own.
+// memchr finds the next quote and the next backslash, an escape skips the byte after the backslash. escaped (if not
+// NULL) tells whether an interpreted literal holds any escape.
+static size_t goc_lexer_string_end(const char *data, size_t s_data, size_t pos, bool *escaped) {
+  goc_error_check(goc_error_nullptr, data != NULL || s_data == 0);
 
-static bool goc_lexer_string(char *word) {
-  return word ? strcmp(word, KEYWORD_STRING) == 0 : false;
-}
+  char delimiter = data[pos];
+  const char *end = memchr(data + pos + 1, delimiter, s_data - pos - 1);
+  if (delimiter == CHAR_BACKTICK)
+    return end ? (size_t)(end - data) : s_data;
 
-static bool goc_lexer_bool(char *word) {
-  return word ? strcmp(word, KEYWORD_BOOL) == 0 : false;
-}
+  size_t open = pos;
+  for (pos++; end != NULL; ) {
+    const char *slash = memchr(data + pos, CHAR_BACKSLASH, (size_t)(end - data) - pos);
+    if (slash == NULL)
+      break;
+    if (escaped != NULL)
+      *escaped = true;
+    pos = (size_t)(slash - data) + 2;
+    if (pos > (size_t)(end - data))
+      end = pos < s_data ? memchr(data + pos, delimiter, s_data - pos) : NULL;
+  }
+  size_t close = end ? (size_t)(end - data) : s_data;
+  const char *line_end = memchr(data + open + 1, CHAR_NEW_LINE, close - open - 1);
+  return line_end ? (size_t)(line_end - data) : close;
+}
+
+// Decodes the escapes of the interpreted literal data[pos, end) into buffer->scratch, returns the decoded size.
+// Decoding never grows the text: \xHH, \NNN, \uHHHH and \UHHHHHHHH are (UTF-8 encoded) at most their own size.
+// An invalid escape is reported and dropped, decoding goes on after the digits it does have.
+static size_t goc_lexer_string_decode(struct lexer_buffer *buffer, size_t pos, size_t end) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+
+  if (buffer->s_scratch < end - pos) {
+    char *scratch = (char *)realloc(buffer->scratch, end - pos);
+    goc_error_assert(goc_error_mem_error, scratch != NULL);
+    buffer->scratch = scratch;
+    buffer->s_scratch = end - pos;
+  }
 
-static bool goc_lexer_true(char *word) {
-  return word ? strcmp(word, KEYWORD_TRUE) == 0 : false;
+  const char *data = buffer->data;
+  char *out = buffer->scratch;
+  while (pos < end) {
+    const char *slash = memchr(data + pos, CHAR_BACKSLASH, end - pos);
+    size_t s_run = (slash ? (size_t)(slash - data) : end) - pos;
+    memcpy(out, data + pos, s_run);
+    out += s_run;
+    pos += s_run;
+    if (pos >= end)
+      break;
+    pos = goc_lexer_escape_decode(buffer, pos, end, &out);
+  }
+  return (size_t)(out - buffer->scratch);
 }
 
-static bool goc_lexer_false(char *word) {
-  return word ? strcmp(word, KEYWORD_FALSE) == 0 : false;
-}
+// Decodes the escape whose backslash is at data[pos], its digits taken up to end, into *out (moved past the at
+// most GOC_UTF8_SIZE_MAX bytes written). Returns the offset past the escape.
+static size_t goc_lexer_escape_decode(struct lexer_buffer *buffer, size_t pos, size_t end, char **out) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_nullptr, out != NULL && *out != NULL);
 
-static bool goc_lexer_if(char *word) {
-  return word ? strcmp(word, KEYWORD_IF) == 0 : false;
-}
+  const char *data = buffer->data;
+  size_t escape = pos++;
+  char ch = data[pos++];
+  switch (ch) {
+    case 'a': *(*out)++ = '\a'; break;
+    case 'b': *(*out)++ = '\b'; break;
+    case 'f': *(*out)++ = '\f'; break;
+    case 'n': *(*out)++ = '\n'; break;
+    case 'r': *(*out)++ = '\r'; break;
+    case 't': *(*out)++ = '\t'; break;
+    case 'v': *(*out)++ = '\v'; break;
+    case CHAR_BACKSLASH: case CHAR_QUOTE: case CHAR_APOST: *(*out)++ = ch; break;
+
+    case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': {
+      uint32_t byte = (uint32_t)(ch - '0');
+      size_t digit = 0;
+      for (; digit < 2 && pos < end && data[pos] >= '0' && data[pos] <= '7'; digit++, pos++)
+        byte = 8 * byte + (uint32_t)(data[pos] - '0');
+      if (digit < 2 || byte > 0xff) {
+        goc_lexer_report(buffer, GOC_ERROR_LEXER_INVALID_ESCAPE, escape);
+        break;
+      }
+      *(*out)++ = (char)byte;
+      break;
+    }
 
-static bool goc_lexer_else(char *word) {
-  return word ? strcmp(word, KEYWORD_ELSE) == 0 : false;
-}
+    case 'x': case 'u': case 'U': {
+      size_t s_digits = ch == 'x' ? 2 : ch == 'u' ? 4 : 8;
+      uint32_t code = 0;
+      size_t digit = 0;
+      for (int hex; digit < s_digits && pos < end && (hex = goc_lexer_hex_value(data[pos])) >= 0; digit++, pos++)
+        code = 16 * code + (uint32_t)hex;
+      if (digit < s_digits || (ch != 'x' && (code > 0x10ffff || (code >= 0xd800 && code <= 0xdfff)))) {
+        goc_lexer_report(buffer, GOC_ERROR_LEXER_INVALID_ESCAPE, escape);
+        break;
+      }
+      if (ch == 'x') {
+        *(*out)++ = (char)code;
+        break;
+      }
+      *out += goc_utf8_encode(code, *out);
+      break;
+    }
 
-static bool goc_lexer_switch(char *word) {
-  return word ? strcmp(word, KEYWORD_SWITCH) == 0 : false;
+    default: {
+      goc_lexer_report(buffer, GOC_ERROR_LEXER_INVALID_ESCAPE, escape);
+      break;
+    }
+  }
+  return pos;
+}
+
+static int goc_lexer_hex_value(char ch) {
+  if (ch >= '0' && ch <= '9')
+    return ch - '0';
+  if ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'f')
+    return (ch | 0x20) - 'a' + 10;
+  return -1;
+}
+
+// A backslash escape as the body is decoded as in interpreted string literals, it must be a single one
+static TokenType goc_lexer_consume_char_lit(struct lexer_buffer *buffer, char ch) {
+  goc_error_check(goc_error_nullptr, buffer != NULL);
+  goc_error_check(goc_error_inval_arg, ch == CHAR_APOST);
+
+  bool valid = false;
+  buffer->cursor = goc_lexer_char_lit_end(buffer->data, buffer->s_data, buffer->start, &valid);
+  if (valid && buffer->data[buffer->start + 1] == CHAR_BACKSLASH) {
+    char decoded[GOC_UTF8_SIZE_MAX],
+         *out = decoded;
+    size_t s_errors = goc_diagnostics_get_count(buffer->diagnostics),
+           close = buffer->cursor - 1,
+           end = goc_lexer_escape_decode(buffer, buffer->start + 1, close, &out);
+    if (goc_diagnostics_get_count(buffer->diagnostics) != s_errors)
+      return TT_UNKNOWN;
+    valid = end == close;
+  }
+  if (valid)
+    return TT_CHAR_LIT;
+  goc_lexer_report(buffer, GOC_ERROR_LEXER_INVALID_CHAR_LIT, buffer->start);
+  return TT_UNKNOWN;
 }
 
-static bool goc_lexer_case(char *word) {
-  return word ? strcmp(word, KEYWORD_CASE) == 0 : false;
+// End (past its last byte) of the char literal opened at data[pos]: one UTF-8 encoded character other than an
+// apostrophe or a new line, or a backslash escape up to the next apostrophe on its line past the escaped byte, then
+// the closing apostrophe. A malformed literal ends after the next apostrophe on its line, or right after its
+// opening one.
+static size_t goc_lexer_char_lit_end(const char *data, size_t s_data, size_t pos, bool *valid) {
+  goc_error_check(goc_error_nullptr, valid != NULL);
+
+  const char *text = data + pos + 1;
+  size_t s_text = s_data - pos - 1;
+  *valid = false;
+  if (s_text > 0 && text[0] == CHAR_BACKSLASH) {
+    const char *line_end = memchr(text, CHAR_NEW_LINE, s_text);
+    size_t s_line = line_end ? (size_t)(line_end - text) : s_text;
+    const char *close = s_line > 2 ? memchr(text + 2, CHAR_APOST, s_line - 2) : NULL;
+    *valid = close != NULL;
+    return close ? (size_t)(close - data) + 1 : pos + 1;
+  }
+
+  size_t s_sequence = 0;
+  (void)goc_utf8_decode(text, s_text, &s_sequence);
+  size_t end = pos + 1 + s_sequence;
+  bool single = s_sequence > 0 && text[0] != CHAR_APOST && text[0] != CHAR_NEW_LINE;
+  *valid = single && end < s_data && data[end] == CHAR_APOST;
+  if (*valid)
+    return end + 1;
+
+  const char *line_end = memchr(text, CHAR_NEW_LINE, s_text),
+             *close = memchr(text, CHAR_APOST, line_end ? (size_t)(line_end - text) : s_text);
+  return close ? (size_t)(close - data) + 1 : pos + 1;
 }
 
-static bool goc_lexer_do(char *word) {
-  return word ? strcmp(word, KEYWORD_DO) == 0 : false;
+static bool goc_lexer_comment_block_end(char ch, char next) {
+  return ch == CHAR_STAR && next == CHAR_SLASH;
 }
 
-static bool goc_lexer_while(char *word) {
-  return word ? strcmp(word, KEYWORD_WHILE) == 0 : false;
+static bool goc_lexer_ident(char ch) {
+  return goc_lexer_char_in(ch, LEXER_CLASSES_IDENT);
 }
 
-static bool goc_lexer_for(char *word) {
-  return word ? strcmp(word, KEYWORD_FOR) == 0 : false;
+static bool goc_lexer_ident_middle(char ch) {
+  return goc_lexer_char_in(ch, LEXER_CLASSES_IDENT_MIDDLE);
 }
 
-static bool goc_lexer_range(char *word) {
-  return word ? strcmp(word, KEYWORD_RANGE) == 0 : false;
+static bool goc_lexer_skip(char ch) {
+  return goc_lexer_char_class(ch) == LEXER_CLASS_WSPACE;
 }
 
-static double pow_int(double value, int32_t exp) {
-  if (value == 0 || value == 1)
-    return value;
-  if (exp == 1)
-    return value;
-  double factor = exp < 0 ? 1 / value : value,
-         res = 1;
-  if (exp < 0)
-    exp *= -1;
-  for (; exp; res *= factor, exp--);
-  return res;
+// One probe in the keyword slots and at most one compare, plain identifiers mostly miss on the slot or length
+static TokenType goc_lexer_keyword(const char *word, size_t s_word) {
+  if (s_word < KEYWORD_MIN_SIZE || s_word > KEYWORD_MAX_SIZE)
+    return TT_IDENT;
+
+  TokenType type = (TokenType)goc_lexer_keyword_slots[goc_lexer_keyword_hash(word[0], word[s_word - 1], s_word)];
+  if (type == TT_BEGIN)
+    return TT_IDENT;
+
+  const struct token_type_info *info = &(goc_lexer_token_types[type]);
+  if (s_word == info->s_keyword && memcmp(word, info->keyword, s_word) == 0)
+    return type;
+  if (s_word == info->s_alias && memcmp(word, info->alias, s_word) == 0)
+    return type;
+  return TT_IDENT;
 }
@@ -0,0 +1,193 @@
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include "goc_error.h"
+#include "goc_writer.h"
+#include "goc_lexer_dump.h"
+
+struct lexer_dump {
+  Writer          writer;
+  LexerDumpFormat format;
+  bool            colors;
+};
+
+static const size_t lexer_dump_size = 1024 * 1024;
+
+#define goc_lexer_dump_literal(dump, text) goc_writer_literal((dump)->writer, (text))
+
+// =========================================================# PRIVATE #================================================================
+
+static void _goc_lexer_dump_append(LexerDump dump, const char *text, size_t s_text) {
+  goc_writer_append(dump->writer, text, s_text);
+}
+
+static void _goc_lexer_dump_color(LexerDump dump, ANSI_Color color) {
+  if (dump->colors)
+    _goc_lexer_dump_append(dump, ANSI_COLORS[color], strlen(ANSI_COLORS[color]));
+}
+
+static void _goc_lexer_dump_uint(LexerDump dump, uint64_t value) {
+  goc_writer_uint(dump->writer, value, 0);
+}
+
+static void _goc_lexer_dump_int(LexerDump dump, int64_t value) {
+  if (value < 0)
+    goc_lexer_dump_literal(dump, "-");
+  _goc_lexer_dump_uint(dump, value < 0 ? 0 - (uint64_t)value : (uint64_t)value);
+}
+
+static void _goc_lexer_dump_real(LexerDump dump, double value) {
+  Writer writer = dump->writer;
+  goc_writer_reserve(writer, GOC_WRITER_NUMBER_MAX);
+  int s_text = snprintf(writer->data + writer->s_data, GOC_WRITER_NUMBER_MAX, "%.17g", value);
+  writer->s_data += (size_t)s_text;
+}
+
+static void _goc_lexer_dump_le(LexerDump dump, uint64_t value, size_t size) {
+  Writer writer = dump->writer;
+  goc_writer_reserve(writer, size);
+  for (size_t byte = 0; byte < size; byte++, value >>= 8)
+    writer->data[writer->s_data++] = (char)(value & 0xff);
+}
+
+static bool _goc_lexer_dump_has_text(TokenType type) {
+  return type == TT_IDENT || type == TT_STRING_LIT || type == TT_CHAR_LIT;
+}
+
+static void _goc_lexer_dump_text(LexerDump dump, Token token, TokenType type) {
+  _goc_lexer_dump_color(dump, ANSI_COLOR_CYAN);
+  _goc_lexer_dump_uint(dump, goc_lexer_token_get_pos_line(token));
+  goc_lexer_dump_literal(dump, ":");
+  _goc_lexer_dump_uint(dump, goc_lexer_token_get_pos_rel(token));
+  _goc_lexer_dump_color(dump, ANSI_COLOR_RESET);
+  goc_lexer_dump_literal(dump, " ");
+
+  const char *name = goc_lexer_token_type_to_str(type);
+  _goc_lexer_dump_color(dump, ANSI_COLOR_RED);
+  _goc_lexer_dump_append(dump, name, strlen(name));
+  _goc_lexer_dump_color(dump, ANSI_COLOR_RESET);
+
+  if (_goc_lexer_dump_has_text(type) || type == TT_NUM_LIT || type == TT_REAL_LIT) {
+    goc_lexer_dump_literal(dump, " ");
+    _goc_lexer_dump_color(dump, ANSI_COLOR_GREEN);
+    if (_goc_lexer_dump_has_text(type)) {
+      TokenText text = goc_lexer_token_get_value_text(token);
+      _goc_lexer_dump_append(dump, text.text, text.s_text);
+    } else if (type == TT_NUM_LIT) {
+      _goc_lexer_dump_int(dump, goc_lexer_token_get_value_number_literal(token));
+    } else {
+      _goc_lexer_dump_real(dump, goc_lexer_token_get_value_real_literal(token));
+    }
+    _goc_lexer_dump_color(dump, ANSI_COLOR_RESET);
+  }
+  goc_lexer_dump_literal(dump, "\n");
+}
+
+static void _goc_lexer_dump_ndjson(LexerDump dump, Token token, TokenType type) {
+  const char *name = goc_lexer_token_type_to_str(type);
+  goc_lexer_dump_literal(dump, "{\"type\":\"");
+  _goc_lexer_dump_append(dump, name, strlen(name));
+  goc_lexer_dump_literal(dump, "\",\"abs\":");
+  _goc_lexer_dump_uint(dump, goc_lexer_token_get_pos_abs(token));
+  goc_lexer_dump_literal(dump, ",\"line\":");
+  _goc_lexer_dump_uint(dump, goc_lexer_token_get_pos_line(token));
+  goc_lexer_dump_literal(dump, ",\"rel\":");
+  _goc_lexer_dump_uint(dump, goc_lexer_token_get_pos_rel(token));
+  goc_lexer_dump_literal(dump, ",\"s_word\":");
+  _goc_lexer_dump_uint(dump, goc_lexer_token_get_pos_s_word(token));
+
+  if (_goc_lexer_dump_has_text(type)) {
+    TokenText text = goc_lexer_token_get_value_text(token);
+    goc_lexer_dump_literal(dump, ",\"text\":");
+    goc_writer_json_string(dump->writer, text.text, text.s_text);
+  } else if (type == TT_NUM_LIT) {
+    goc_lexer_dump_literal(dump, ",\"value\":");
+    _goc_lexer_dump_int(dump, goc_lexer_token_get_value_number_literal(token));
+  } else if (type == TT_REAL_LIT) {
+    double value = goc_lexer_token_get_value_real_literal(token);
+    goc_lexer_dump_literal(dump, ",\"value\":");
+    if (isfinite(value))
+      _goc_lexer_dump_real(dump, value);
+    else
+      goc_lexer_dump_literal(dump, "null");
+  }
+  goc_lexer_dump_literal(dump, "}\n");
+}
+
+static void _goc_lexer_dump_binary(LexerDump dump, Token token, TokenType type) {
+  uint64_t value = 0;
+  if (type == TT_NUM_LIT) {
+    value = (uint64_t)goc_lexer_token_get_value_number_literal(token);
+  } else if (type == TT_REAL_LIT) {
+    double real = goc_lexer_token_get_value_real_literal(token);
+    memcpy(&value, &real, sizeof(value));
+  }
+
+  _goc_lexer_dump_le(dump, (uint64_t)type, 4);
+  _goc_lexer_dump_le(dump, goc_lexer_token_get_pos_abs(token), 4);
+  _goc_lexer_dump_le(dump, goc_lexer_token_get_pos_line(token), 4);
+  _goc_lexer_dump_le(dump, goc_lexer_token_get_pos_rel(token), 4);
+  _goc_lexer_dump_le(dump, goc_lexer_token_get_pos_s_word(token), 4);
+  _goc_lexer_dump_le(dump, value, 8);
+
+  if (_goc_lexer_dump_has_text(type)) {
+    TokenText text = goc_lexer_token_get_value_text(token);
+    _goc_lexer_dump_append(dump, text.text, text.s_text);
+  }
+}
+
+// ==========================================================# PUBLIC #================================================================
+
+LexerDump goc_lexer_dump_create(int fd, LexerDumpFormat format) {
+  goc_error_assert(goc_error_inval_arg, fd >= 0);
+  goc_error_assert(goc_error_inval_arg, format <= LEXER_DUMP_BINARY);
+
+  LexerDump dump = (LexerDump)malloc(sizeof(struct lexer_dump));
+  if (dump == NULL)
+    return NULL;
+  dump->writer = goc_writer_create(fd, lexer_dump_size);
+  if (dump->writer == NULL) {
+    free(dump);
+    return NULL;
+  }
+  dump->format = format;
+  dump->colors = format == LEXER_DUMP_TEXT && isatty(fd);
+
+  if (format == LEXER_DUMP_BINARY) {
+    goc_lexer_dump_literal(dump, LEXER_DUMP_MAGIC);
+    _goc_lexer_dump_le(dump, LEXER_DUMP_VERSION, 4);
+  }
+  return dump;
+}
+
+void goc_lexer_dump_token(LexerDump dump, Token token) {
+  goc_error_assert(goc_error_nullptr, dump != NULL);
+  goc_error_assert(goc_error_nullptr, token.array != NULL);
+
+  TokenType type = goc_lexer_token_get_token_type(token);
+  switch (dump->format) {
+    case LEXER_DUMP_TEXT:   _goc_lexer_dump_text(dump, token, type);   break;
+    case LEXER_DUMP_NDJSON: _goc_lexer_dump_ndjson(dump, token, type); break;
+    case LEXER_DUMP_BINARY: _goc_lexer_dump_binary(dump, token, type); break;
+  }
+}
+
+void goc_lexer_dump_tokens(LexerDump dump, TokenArray tokens) {
+  goc_error_assert(goc_error_nullptr, dump != NULL);
+  size_t s_tokens = goc_lexer_token_array_get_size(tokens);
+  for (size_t index = 0; index < s_tokens; index++)
+    goc_lexer_dump_token(dump, goc_lexer_token_array_at(tokens, index));
+}
+
+void goc_lexer_dump_flush(LexerDump dump) {
+  goc_error_assert(goc_error_nullptr, dump != NULL);
+  goc_writer_flush(dump->writer);
+}
+
+void goc_lexer_dump_free(LexerDump dump) {
+  if (dump == NULL)
+    return;
+  goc_writer_free(dump->writer);
+  free(dump);
+}
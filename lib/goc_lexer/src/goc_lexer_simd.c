@@ -0,0 +1,164 @@
+#include "goc_lexer_simd.h"
+#include "goc_lexer_simd_private.h"
+
+// ====================================================# PUBLIC #======================================================================
+
+size_t goc_lexer_simd_classify(
+  const char *data, size_t s_data, uint64_t masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW], LexerSimdIsa isa
+) {
+  goc_error_assert(goc_error_nullptr, data != NULL || s_data == 0);
+  goc_error_assert(goc_error_nullptr, masks != NULL);
+
+  size_t (*classify_blocks)(
+    const char *data, size_t s_blocks, uint64_t masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW], size_t index
+  );
+  switch (goc_lexer_simd_resolve_isa(isa)) {
+#if GOC_LEXER_SIMD_X86
+    case LEXER_SIMD_AVX2: classify_blocks = goc_lexer_simd_classify_avx2;   break;
+    case LEXER_SIMD_SSE2: classify_blocks = goc_lexer_simd_classify_sse2;   break;
+#endif
+    default:              classify_blocks = goc_lexer_simd_classify_scalar; break;
+  }
+
+  size_t s_blocks = s_data / GOC_LEXER_SIMD_BLOCK;
+  if (s_blocks >= GOC_LEXER_SIMD_WINDOW)
+    return classify_blocks(data, GOC_LEXER_SIMD_WINDOW, masks, 0);
+  s_blocks = classify_blocks(data, s_blocks, masks, 0);
+
+  // The last partial block is padded with NUL, which is in no class, never reading past the (mapped) data
+  size_t s_tail = s_data % GOC_LEXER_SIMD_BLOCK;
+  if (s_tail > 0) {
+    char padded[GOC_LEXER_SIMD_BLOCK] = {0};
+    memcpy(padded, data + s_blocks * GOC_LEXER_SIMD_BLOCK, s_tail);
+    s_blocks += classify_blocks(padded, 1, masks, s_blocks);
+  }
+  return s_blocks;
+}
+
+LexerSimdIsa goc_lexer_simd_resolve_isa(LexerSimdIsa isa) {
+#if GOC_LEXER_SIMD_X86
+  bool avx2 = __builtin_cpu_supports("avx2");
+  if (isa == LEXER_SIMD_AUTO)
+    return avx2 ? LEXER_SIMD_AVX2 : LEXER_SIMD_SSE2;
+  if (isa == LEXER_SIMD_AVX2 && !avx2)
+    return LEXER_SIMD_SSE2;
+  return isa;
+#else
+  return LEXER_SIMD_SCALAR;
+#endif
+}
+
+// ====================================================# PRIVATE #======================================================================
+
+static size_t goc_lexer_simd_classify_scalar(
+  const char *data, size_t s_blocks, uint64_t masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW], size_t index
+) {
+  for (size_t block = 0; block < s_blocks; block++, data += GOC_LEXER_SIMD_BLOCK) {
+    uint64_t wspace = 0,
+             ident  = 0,
+             digit  = 0,
+             quote  = 0,
+             slash  = 0;
+    for (size_t i = 0; i < GOC_LEXER_SIMD_BLOCK; i++) {
+      uint64_t classes = goc_lexer_simd_classes[(unsigned char)data[i]];
+      wspace |= ((classes >> LEXER_SIMD_MASK_WSPACE) & 1) << i;
+      ident  |= ((classes >> LEXER_SIMD_MASK_IDENT) & 1) << i;
+      digit  |= ((classes >> LEXER_SIMD_MASK_DIGIT) & 1) << i;
+      quote  |= ((classes >> LEXER_SIMD_MASK_QUOTE) & 1) << i;
+      slash  |= ((classes >> LEXER_SIMD_MASK_SLASH) & 1) << i;
+    }
+    masks[LEXER_SIMD_MASK_WSPACE][index + block] = wspace;
+    masks[LEXER_SIMD_MASK_IDENT][index + block]  = ident;
+    masks[LEXER_SIMD_MASK_DIGIT][index + block]  = digit;
+    masks[LEXER_SIMD_MASK_QUOTE][index + block]  = quote;
+    masks[LEXER_SIMD_MASK_SLASH][index + block]  = slash;
+  }
+  return s_blocks;
+}
+
+#if GOC_LEXER_SIMD_X86
+
+// SSE2 and AVX2 only compare signed bytes: bytes >= 0x80 are negative and fall out of every range below
+
+__attribute__((target("sse2")))
+static size_t goc_lexer_simd_classify_sse2(
+  const char *data, size_t s_blocks, uint64_t masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW], size_t index
+) {
+  const __m128i space = _mm_set1_epi8(' '),
+                tab   = _mm_set1_epi8('\t'),
+                nline = _mm_set1_epi8('\n'),
+                under = _mm_set1_epi8('_'),
+                quote = _mm_set1_epi8('"'),
+                slash = _mm_set1_epi8('/'),
+                lower = _mm_set1_epi8(0x20),
+                a_lo  = _mm_set1_epi8('a' - 1),
+                z_hi  = _mm_set1_epi8('z' + 1),
+                d_lo  = _mm_set1_epi8('0' - 1),
+                d_hi  = _mm_set1_epi8('9' + 1);
+
+  for (size_t block = 0; block < s_blocks; block++, data += GOC_LEXER_SIMD_BLOCK) {
+    uint64_t block_masks[LEXER_SIMD_MASK_COUNT] = {0};
+    for (size_t i = 0; i < GOC_LEXER_SIMD_BLOCK; i += 16) {
+      __m128i bytes  = _mm_loadu_si128((const __m128i *)(data + i)),
+              folded = _mm_or_si128(bytes, lower),
+              wspace = _mm_or_si128(
+                _mm_cmpeq_epi8(bytes, space), _mm_or_si128(_mm_cmpeq_epi8(bytes, tab), _mm_cmpeq_epi8(bytes, nline))
+              ),
+              alpha  = _mm_and_si128(_mm_cmpgt_epi8(folded, a_lo), _mm_cmplt_epi8(folded, z_hi)),
+              digit  = _mm_and_si128(_mm_cmpgt_epi8(bytes, d_lo), _mm_cmplt_epi8(bytes, d_hi)),
+              ident  = _mm_or_si128(_mm_or_si128(alpha, digit), _mm_cmpeq_epi8(bytes, under));
+
+      block_masks[LEXER_SIMD_MASK_WSPACE] |= (uint64_t)(uint16_t)_mm_movemask_epi8(wspace) << i;
+      block_masks[LEXER_SIMD_MASK_IDENT]  |= (uint64_t)(uint16_t)_mm_movemask_epi8(ident) << i;
+      block_masks[LEXER_SIMD_MASK_DIGIT]  |= (uint64_t)(uint16_t)_mm_movemask_epi8(digit) << i;
+      block_masks[LEXER_SIMD_MASK_QUOTE]  |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)) << i;
+      block_masks[LEXER_SIMD_MASK_SLASH]  |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, slash)) << i;
+    }
+    for (size_t mask = 0; mask < LEXER_SIMD_MASK_COUNT; mask++)
+      masks[mask][index + block] = block_masks[mask];
+  }
+  return s_blocks;
+}
+
+__attribute__((target("avx2")))
+static size_t goc_lexer_simd_classify_avx2(
+  const char *data, size_t s_blocks, uint64_t masks[LEXER_SIMD_MASK_COUNT][GOC_LEXER_SIMD_WINDOW], size_t index
+) {
+  const __m256i space = _mm256_set1_epi8(' '),
+                tab   = _mm256_set1_epi8('\t'),
+                nline = _mm256_set1_epi8('\n'),
+                under = _mm256_set1_epi8('_'),
+                quote = _mm256_set1_epi8('"'),
+                slash = _mm256_set1_epi8('/'),
+                lower = _mm256_set1_epi8(0x20),
+                a_lo  = _mm256_set1_epi8('a' - 1),
+                z_hi  = _mm256_set1_epi8('z' + 1),
+                d_lo  = _mm256_set1_epi8('0' - 1),
+                d_hi  = _mm256_set1_epi8('9' + 1);
+
+  for (size_t block = 0; block < s_blocks; block++, data += GOC_LEXER_SIMD_BLOCK) {
+    uint64_t block_masks[LEXER_SIMD_MASK_COUNT] = {0};
+    for (size_t i = 0; i < GOC_LEXER_SIMD_BLOCK; i += 32) {
+      __m256i bytes  = _mm256_loadu_si256((const __m256i *)(data + i)),
+              folded = _mm256_or_si256(bytes, lower),
+              wspace = _mm256_or_si256(
+                _mm256_cmpeq_epi8(bytes, space),
+                _mm256_or_si256(_mm256_cmpeq_epi8(bytes, tab), _mm256_cmpeq_epi8(bytes, nline))
+              ),
+              alpha  = _mm256_and_si256(_mm256_cmpgt_epi8(folded, a_lo), _mm256_cmpgt_epi8(z_hi, folded)),
+              digit  = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, d_lo), _mm256_cmpgt_epi8(d_hi, bytes)),
+              ident  = _mm256_or_si256(_mm256_or_si256(alpha, digit), _mm256_cmpeq_epi8(bytes, under));
+
+      block_masks[LEXER_SIMD_MASK_WSPACE] |= (uint64_t)(uint32_t)_mm256_movemask_epi8(wspace) << i;
+      block_masks[LEXER_SIMD_MASK_IDENT]  |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ident) << i;
+      block_masks[LEXER_SIMD_MASK_DIGIT]  |= (uint64_t)(uint32_t)_mm256_movemask_epi8(digit) << i;
+      block_masks[LEXER_SIMD_MASK_QUOTE]  |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, quote)) << i;
+      block_masks[LEXER_SIMD_MASK_SLASH]  |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, slash)) << i;
+    }
+    for (size_t mask = 0; mask < LEXER_SIMD_MASK_COUNT; mask++)
+      masks[mask][index + block] = block_masks[mask];
+  }
+  return s_blocks;
+}
+
+#endif // GOC_LEXER_SIMD_X86
@@ -0,0 +1,285 @@
+#include "goc_number.h"
+#include "goc_number_private.h"
+
+// ====================================================# PUBLIC #======================================================================
+
+Number goc_number_parse(const char *text, size_t s_text) {
+  goc_error_assert(goc_error_nullptr, text != NULL || s_text == 0);
+
+  uint32_t base = 10;
+  if (s_text >= 2 && text[0] == NUMBER_CHAR_ZERO) {
+    switch (text[1] | 0x20) {
+      case 'x': base = 16; break;
+      case 'o': base = 8;  break;
+      case 'b': base = 2;  break;
+      default:             break;
+    }
+  }
+
+  // Prefixed integers need one digit at least
+  if (base != 10) {
+    size_t end = goc_number_digits(text, 2, s_text, base, true);
+    if (end == 2 || (end < s_text && goc_number_ident(text[end])))
+      return goc_number_invalid(text, end, s_text);
+    return goc_number_integer(text, 2, end, base);
+  }
+
+  // Decimal: integer part, then a fraction and / or an exponent make it a real
+  size_t end = goc_number_digits(text, 0, s_text, base, false),
+         exp_start = 0;
+  bool real = false;
+  if (end < s_text && text[end] == NUMBER_CHAR_PERIOD) {
+    size_t s_integer = end;
+    end = goc_number_digits(text, end + 1, s_text, base, false);
+    if (s_integer == 0 && end == 1)
+      return goc_number_invalid(text, end, s_text);
+    real = true;
+  }
+  if (end > 0 && end < s_text && (text[end] | 0x20) == 'e') {
+    size_t pos = end + 1;
+    if (pos < s_text && (text[pos] == NUMBER_CHAR_PLUS || text[pos] == NUMBER_CHAR_MINUS))
+      pos++;
+    size_t exp_end = goc_number_digits(text, pos, s_text, base, false);
+    if (exp_end == pos)
+      return goc_number_invalid(text, exp_end, s_text);
+    exp_start = end + 1;
+    end = exp_end;
+    real = true;
+  }
+
+  if (end == 0 || (end < s_text && goc_number_ident(text[end])))
+    return goc_number_invalid(text, end, s_text);
+  if (real)
+    return goc_number_real(text, end, exp_start);
+
+  // A leading zero makes the integer a legacy octal one (0755), an 8 or 9 in it an invalid literal
+  if (end > 1 && text[0] == NUMBER_CHAR_ZERO) {
+    if (goc_number_digits(text, 1, end, 8, true) != end)
+      return goc_number_invalid(text, end, s_text);
+    return goc_number_integer(text, 1, end, 8);
+  }
+  return goc_number_integer(text, 0, end, base);
+}
+
+// ====================================================# PRIVATE #======================================================================
+
+// End of the run of base digits from pos, a '_' is allowed between two digits or, when prefixed, first
+static size_t goc_number_digits(const char *text, size_t pos, size_t s_text, uint32_t base, bool prefixed) {
+  bool separable = prefixed;
+  while (pos < s_text) {
+#if GOC_NUMBER_SWAR
+    if (base == 10 && pos + 8 <= s_text && goc_number_eight_digits(text + pos)) {
+      pos += 8;
+      separable = true;
+      continue;
+    }
+#endif
+    char ch = text[pos];
+    if (goc_number_digit(ch, base))
+      separable = true;
+    else if (ch == NUMBER_CHAR_UNDER && separable && pos + 1 < s_text && goc_number_digit(text[pos + 1], base))
+      separable = false;
+    else
+      break;
+    pos++;
+  }
+  return pos;
+}
+
+static bool goc_number_digit(char ch, uint32_t base) {
+  if (base == 16)
+    return (ch >= '0' && ch <= '9') || ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'f');
+  return ch >= '0' && ch < (char)('0' + base);
+}
+
+static bool goc_number_ident(char ch) {
+  return (ch >= '0' && ch <= '9') || ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'z') || ch == NUMBER_CHAR_UNDER;
+}
+
+// The invalid literal spans up to the end of the identifier characters it runs into
+static Number goc_number_invalid(const char *text, size_t end, size_t s_text) {
+  for (; end < s_text && (goc_number_ident(text[end]) || text[end] == NUMBER_CHAR_PERIOD); end++);
+  return (Number){ NUMBER_INVALID, end, { 0 } };
+}
+
+// Value of the digits text[start, end), '_' skipped, decimal 8 digits at a time
+static Number goc_number_integer(const char *text, size_t start, size_t end, uint32_t base) {
+  uint64_t value = 0;
+  bool overflow = false;
+  uint32_t shift = base == 16 ? 4 : (base == 8 ? 3 : 1);
+
+  for (size_t pos = start; pos < end; ) {
+#if GOC_NUMBER_SWAR
+    if (base == 10 && pos + 8 <= end && goc_number_eight_digits(text + pos)) {
+      overflow |= __builtin_mul_overflow(value, (uint64_t)100000000, &value);
+      overflow |= __builtin_add_overflow(value, (uint64_t)goc_number_eight_digits_value(text + pos), &value);
+      pos += 8;
+      continue;
+    }
+#endif
+    char ch = text[pos++];
+    if (ch == NUMBER_CHAR_UNDER)
+      continue;
+    uint64_t digit = ch <= '9' ? (uint64_t)(ch - '0') : (uint64_t)((ch | 0x20) - 'a' + 10);
+    if (base == 10) {
+      overflow |= __builtin_mul_overflow(value, (uint64_t)10, &value);
+      overflow |= __builtin_add_overflow(value, digit, &value);
+    } else {
+      overflow |= (value >> (64 - shift)) != 0;
+      value = (value << shift) | digit;
+    }
+  }
+  overflow |= value > (uint64_t)INT64_MAX;
+  return (Number){ overflow ? NUMBER_OVERFLOW : NUMBER_INT, end, { .integer = value } };
+}
+
+// Decimal real text[0, end), exponent digits from exp_start (0 without exponent). The significant digits are
+// gathered in a 64-bit mantissa, then converted by the exact fast path, Eisel-Lemire, or strtod as a last resort.
+static Number goc_number_real(const char *text, size_t end, size_t exp_start) {
+  uint64_t mantissa = 0;
+  int64_t  exp10 = 0;
+  size_t   s_digits = 0;
+  bool     fraction = false,
+           truncated = false;
+
+  for (size_t pos = 0; pos < (exp_start ? exp_start - 1 : end); pos++) {
+    char ch = text[pos];
+    if (ch == NUMBER_CHAR_UNDER)
+      continue;
+    if (ch == NUMBER_CHAR_PERIOD) {
+      fraction = true;
+      continue;
+    }
+    uint64_t digit = (uint64_t)(ch - '0');
+    if (mantissa == 0 && digit == 0) {
+      exp10 -= fraction;
+    } else if (s_digits < NUMBER_MANTISSA_DIGITS) {
+      mantissa = mantissa * 10 + digit;
+      s_digits++;
+      exp10 -= fraction;
+    } else {
+      truncated |= digit != 0;
+      exp10 += !fraction;
+    }
+  }
+
+  if (exp_start) {
+    size_t pos = exp_start;
+    bool negative = text[pos] == NUMBER_CHAR_MINUS;
+    if (text[pos] == NUMBER_CHAR_PLUS || text[pos] == NUMBER_CHAR_MINUS)
+      pos++;
+    int64_t exp = 0;
+    for (; pos < end; pos++)
+      if (text[pos] != NUMBER_CHAR_UNDER && exp < NUMBER_EXP_MAX)
+        exp = exp * 10 + (text[pos] - '0');
+    exp10 += negative ? -exp : exp;
+  }
+
+  double value = 0;
+  if (mantissa == 0)
+    value = 0;
+  else if (!truncated && mantissa <= (1ull << 53) && exp10 >= -22 && exp10 <= 22)
+    value = exp10 < 0 ? (double)mantissa / goc_number_exact_powers[-exp10] : (double)mantissa * goc_number_exact_powers[exp10];
+  else if (truncated || !goc_number_eisel_lemire(mantissa, exp10, &value))
+    value = goc_number_strtod(text, end);
+  return (Number){ isinf(value) ? NUMBER_OVERFLOW : NUMBER_REAL, end, { .real = value } };
+}
+
+// High 64 bits of a * b, the low ones in *lo
+static uint64_t goc_number_mul64(uint64_t a, uint64_t b, uint64_t *lo) {
+  uint64_t a_lo = (uint32_t)a, a_hi = a >> 32,
+           b_lo = (uint32_t)b, b_hi = b >> 32,
+           p0 = a_lo * b_lo, p1 = a_lo * b_hi,
+           p2 = a_hi * b_lo, p3 = a_hi * b_hi,
+           mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+  *lo = (mid << 32) | (uint32_t)p0;
+  return p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+}
+
+// mantissa * 10^exp10 rounded to nearest even with one 64x128-bit product, false when that product cannot
+// decide the rounding (or the result is subnormal, infinite) and a slower conversion has to
+static bool goc_number_eisel_lemire(uint64_t mantissa, int64_t exp10, double *value) {
+  if (exp10 < NUMBER_POW10_MIN || exp10 > NUMBER_POW10_MAX)
+    return false;
+
+  int clz = __builtin_clzll(mantissa);
+  mantissa <<= clz;
+  // floor(log2(10) * exp10) via 217706 / 2^16 ~ log2(10)
+  uint64_t exp2 = (uint64_t)(((217706 * exp10) >> 16) + 64 + 1023) - (uint64_t)clz;
+
+  const uint64_t *power = goc_number_powers_of_ten[exp10 - NUMBER_POW10_MIN];
+  uint64_t x_lo,
+           x_hi = goc_number_mul64(mantissa, power[1], &x_lo);
+  if ((x_hi & 0x1FF) == 0x1FF && x_lo + mantissa < mantissa) {
+    uint64_t y_lo,
+             y_hi = goc_number_mul64(mantissa, power[0], &y_lo),
+             merged_hi = x_hi,
+             merged_lo = x_lo + y_hi;
+    if (merged_lo < x_lo)
+      merged_hi++;
+    if ((merged_hi & 0x1FF) == 0x1FF && merged_lo + 1 == 0 && y_lo + mantissa < mantissa)
+      return false;
+    x_hi = merged_hi;
+    x_lo = merged_lo;
+  }
+
+  uint64_t msb = x_hi >> 63,
+           bits = x_hi >> (msb + 9);
+  exp2 -= 1 ^ msb;
+  if (x_lo == 0 && (x_hi & 0x1FF) == 0 && (bits & 3) == 1)
+    return false;
+
+  bits += bits & 1;
+  bits >>= 1;
+  if (bits >> 53 > 0) {
+    bits >>= 1;
+    exp2++;
+  }
+  if (exp2 - 1 >= 0x7FF - 1)
+    return false;
+
+  bits = (exp2 << 52) | (bits & 0x000FFFFFFFFFFFFFull);
+  memcpy(value, &bits, sizeof(*value));
+  return true;
+}
+
+// Correctly rounded by the C library, '_' removed first. The lexer never calls setlocale, so the decimal
+// point is '.'.
+static double goc_number_strtod(const char *text, size_t s_text) {
+  char local[NUMBER_TEXT_SIZE],
+       *copy = s_text < NUMBER_TEXT_SIZE ? local : (char *)malloc(s_text + 1);
+  goc_error_assert(goc_error_mem_error, copy != NULL);
+
+  size_t s_copy = 0;
+  for (size_t pos = 0; pos < s_text; pos++)
+    if (text[pos] != NUMBER_CHAR_UNDER)
+      copy[s_copy++] = text[pos];
+  copy[s_copy] = '\0';
+
+  double value = strtod(copy, NULL);
+  if (copy != local)
+    free(copy);
+  return value;
+}
+
+#if GOC_NUMBER_SWAR
+
+static inline bool goc_number_eight_digits(const char *text) {
+  uint64_t chunk;
+  memcpy(&chunk, text, sizeof(chunk));
+  return (((chunk & 0xF0F0F0F0F0F0F0F0ull) | (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+    == 0x3333333333333333ull);
+}
+
+// Value of 8 ASCII digits in 3 multiplies: pairs, then quads, then the two quads
+static inline uint32_t goc_number_eight_digits_value(const char *text) {
+  uint64_t chunk;
+  memcpy(&chunk, text, sizeof(chunk));
+  chunk -= 0x3030303030303030ull;
+  chunk = (chunk * 10) + (chunk >> 8);
+  chunk = (((chunk & 0x000000FF000000FFull) * 0x000F424000000064ull)
+        + (((chunk >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+  return (uint32_t)chunk;
+}
+
+#endif // GOC_NUMBER_SWAR
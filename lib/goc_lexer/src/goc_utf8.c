@@ -0,0 +1,152 @@
+#include "goc_utf8.h"
+#include "goc_utf8_private.h"
+
+// ====================================================# PUBLIC #======================================================================
+
+uint32_t goc_utf8_decode(const char *data, size_t s_data, size_t *s_sequence) {
+  goc_error_assert(goc_error_nullptr, data != NULL || s_data == 0);
+  goc_error_assert(goc_error_nullptr, s_sequence != NULL);
+
+  *s_sequence = 0;
+  if (s_data == 0)
+    return 0;
+  const unsigned char *bytes = (const unsigned char *)data;
+  if (bytes[0] < 0x80) {
+    *s_sequence = 1;
+    return bytes[0];
+  }
+
+  size_t s_size = goc_utf8_sequence_size(data[0]);
+  if (s_size < 2 || s_size > s_data)
+    return 0;
+  uint32_t code_point = bytes[0] & (0x7f >> s_size);
+  for (size_t byte = 1; byte < s_size; byte++) {
+    if ((bytes[byte] & 0xc0) != 0x80)
+      return 0;
+    code_point = (code_point << 6) | (bytes[byte] & 0x3f);
+  }
+  if (code_point < goc_utf8_size_min[s_size] || code_point > GOC_UTF8_CODE_MAX || (code_point >= 0xd800 && code_point <= 0xdfff))
+    return 0;
+  *s_sequence = s_size;
+  return code_point;
+}
+
+size_t goc_utf8_encode(uint32_t code_point, char *out) {
+  goc_error_assert(goc_error_nullptr, out != NULL);
+  if (code_point < 0x80) {
+    out[0] = (char)code_point;
+    return 1;
+  }
+  if (code_point < 0x800) {
+    out[0] = (char)(0xc0 | (code_point >> 6));
+    out[1] = (char)(0x80 | (code_point & 0x3f));
+    return 2;
+  }
+  if (code_point < 0x10000) {
+    out[0] = (char)(0xe0 | (code_point >> 12));
+    out[1] = (char)(0x80 | ((code_point >> 6) & 0x3f));
+    out[2] = (char)(0x80 | (code_point & 0x3f));
+    return 3;
+  }
+  out[0] = (char)(0xf0 | (code_point >> 18));
+  out[1] = (char)(0x80 | ((code_point >> 12) & 0x3f));
+  out[2] = (char)(0x80 | ((code_point >> 6) & 0x3f));
+  out[3] = (char)(0x80 | (code_point & 0x3f));
+  return 4;
+}
+
+size_t goc_utf8_sequence_size(char lead) {
+  unsigned char byte = (unsigned char)lead;
+  if (byte >= 0xc0 && byte < 0xe0)
+    return 2;
+  if (byte >= 0xe0 && byte < 0xf0)
+    return 3;
+  if (byte >= 0xf0 && byte < 0xf8)
+    return 4;
+  return 1;
+}
+
+bool goc_utf8_letter(uint32_t code_point) {
+  return goc_utf8_in(goc_utf8_letters, sizeof(goc_utf8_letters) / sizeof(goc_utf8_letters[0]), code_point);
+}
+
+bool goc_utf8_digit(uint32_t code_point) {
+  return goc_utf8_in(goc_utf8_digits, sizeof(goc_utf8_digits) / sizeof(goc_utf8_digits[0]), code_point);
+}
+
+size_t goc_utf8_validate(const char *data, size_t s_data) {
+  goc_error_assert(goc_error_nullptr, data != NULL || s_data == 0);
+
+  for (size_t pos = 0, s_sequence; (pos = goc_utf8_ascii_end(data, s_data, pos)) < s_data; pos += s_sequence) {
+    (void)goc_utf8_decode(data + pos, s_data - pos, &s_sequence);
+    if (s_sequence == 0)
+      return pos;
+  }
+  return s_data;
+}
+
+// ====================================================# PRIVATE #======================================================================
+
+// Binary search for the last range starting at or before code_point
+static bool goc_utf8_in(const uint32_t ranges[][2], size_t s_ranges, uint32_t code_point) {
+  size_t lo = 0,
+         hi = s_ranges;
+  if (code_point < ranges[0][0])
+    return false;
+  while (hi - lo > 1) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (ranges[mid][0] <= code_point)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return code_point <= ranges[lo][1];
+}
+
+// First byte >= 0x80 of data[pos, s_data), s_data if there is none
+static size_t goc_utf8_ascii_end(const char *data, size_t s_data, size_t pos) {
+#if GOC_UTF8_X86
+  if (s_data - pos >= 32 && __builtin_cpu_supports("avx2"))
+    return goc_utf8_ascii_end_avx2(data, s_data, pos);
+  return goc_utf8_ascii_end_sse2(data, s_data, pos);
+#else
+  return goc_utf8_ascii_end_scalar(data, s_data, pos);
+#endif
+}
+
+// Eight bytes per step, the high bit of each byte tells it apart from ASCII
+static size_t goc_utf8_ascii_end_scalar(const char *data, size_t s_data, size_t pos) {
+  for (uint64_t word; pos + sizeof(word) <= s_data; pos += sizeof(word)) {
+    memcpy(&word, data + pos, sizeof(word));
+    if (word & UTF8_ASCII_MASK)
+      break;
+  }
+  for (; pos < s_data && (unsigned char)data[pos] < 0x80; pos++);
+  return pos;
+}
+
+#if GOC_UTF8_X86
+
+// movemask gathers the high bit of every byte, the first set one is the first non-ASCII byte
+
+__attribute__((target("sse2")))
+static size_t goc_utf8_ascii_end_sse2(const char *data, size_t s_data, size_t pos) {
+  for (; pos + 16 <= s_data; pos += 16) {
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(data + pos)));
+    if (mask != 0)
+      return pos + (size_t)__builtin_ctz(mask);
+  }
+  return goc_utf8_ascii_end_scalar(data, s_data, pos);
+}
+
+__attribute__((target("avx2")))
+static size_t goc_utf8_ascii_end_avx2(const char *data, size_t s_data, size_t pos) {
+  for (; pos + 32 <= s_data; pos += 32) {
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)(data + pos)));
+    if (mask != 0)
+      return pos + (size_t)__builtin_ctz(mask);
+  }
+  return goc_utf8_ascii_end_sse2(data, s_data, pos);
+}
+
+#endif // GOC_UTF8_X86
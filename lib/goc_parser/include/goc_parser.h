@@ -3,8 +3,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 #include "goc_error.h"
+#include "goc_diagnostic.h"
+#include "goc_arena.h"
 #include "goc_lexer.h"
 
 // =========# AST Nodes #============
@@ -15,11 +19,11 @@ typedef struct ast_node_package         *AST_NodePackage;
 typedef struct ast_node_file            *AST_NodeFile;
 
 // AST Node Objects
+typedef struct ast_node_import       *AST_NodeImport;
 typedef struct ast_node_struct       *AST_NodeStruct;
 typedef struct ast_node_method       *AST_NodeMethod;
 typedef struct ast_node_enum         *AST_NodeEnum;
 typedef struct ast_node_union        *AST_NodeUnion;
-typedef struct ast_node_slice        *AST_NodeSlice;
 typedef struct ast_node_interface    *AST_NodeInterface;
 typedef struct ast_node_func         *AST_NodeFunc;
 typedef struct ast_node_func_declare *AST_NodeFuncDeclare;
@@ -30,7 +34,6 @@ typedef struct ast_node_type_ident   *AST_NodeTypeIdent;
 typedef struct ast_node_stmt_block   *AST_NodeStmtBlock;
 typedef struct ast_node_stmt         *AST_NodeStmt;
 typedef struct ast_node_stmt_for     *AST_NodeStmtFor;
-typedef union  ast_node_stmt_init    *AST_NodeStmtInit;
 typedef struct ast_node_stmt_while   *AST_NodeStmtWhile;
 typedef struct ast_node_stmt_if      *AST_NodeStmtIf;
 typedef struct ast_node_stmt_return  *AST_NodeStmtReturn;
@@ -40,13 +43,334 @@ typedef struct ast_node_stmt_assign  *AST_NodeStmtAssign;
 typedef struct ast_node_expr         *AST_NodeExpr;
 typedef struct ast_node_expr_bin     *AST_NodeExprBin;
 typedef struct ast_node_expr_unary   *AST_NodeExprUnary;
+typedef struct ast_node_expr_call    *AST_NodeExprCall;
+typedef struct ast_node_expr_index   *AST_NodeExprIndex;
 typedef struct ast_node_expr_member  *AST_NodeExprMember;
 
 // AST Node Single
 typedef struct ast_node_literal      *AST_NodeLiteral;
+typedef struct ast_node_error        *AST_NodeError;
 
 #define KEYWORD_MAIN "main"
 
-AST_NodeProgram goc_parser(FILE *file, TokenArray array);
+// Go (Modified) Type, TG_UNKNOW being a named type left to resolve from its token
+typedef enum type_go {
+  TG_UNKNOW = 0,
+  TG_VOID, TG_BOOL,
+  TG_INT8, TG_INT16, TG_INT32, TG_INT64,
+  TG_UINT8, TG_UINT16, TG_UINT32, TG_UINT64,
+  TG_FLOAT, TG_DOUBLE,
+  TG_CHAR, TG_STRING,
+  TG_POINTER, TG_SLICE, TG_STRUCT,
+  TG_ENUM, TG_UNION, TG_FUNCTION, TG_INTERFACE,
+} TypeGo;
+
+// AST Node Type
+typedef enum ast_node_type {
+  ast_undefined = 0, ast_node_error,
+  ast_token, ast_node_literal,
+  ast_node_expr_member, ast_node_expr_index, ast_node_expr_call, ast_node_expr_unary, ast_node_expr_bin, ast_node_expr,
+  ast_node_stmt_expr, ast_node_stmt_assign, ast_node_stmt_return, ast_node_stmt_if, ast_node_stmt_while, ast_node_stmt_for,
+  ast_node_stmt, ast_node_stmt_block,
+  ast_node_type_ident, ast_node_var, ast_node_func_declare, ast_node_func, ast_node_method,
+  ast_node_import, ast_node_union, ast_node_enum, ast_node_struct, ast_node_interface,
+  ast_node_file, ast_node_package, ast_node_program
+} AST_NodeType;
+
+typedef enum ast_operator_unary {
+  UNOP_UNDEFINED = 0,
+  UNOP_PLUS,    UNOP_MINUS,
+  UNOP_LOG_NOT, UNOP_BIT_NOT,
+  UNOP_DEREF,   UNOP_REF,
+  UNOP_INCR,    UNOP_DECR
+} AST_OperatorUnary;
+
+typedef enum ast_operator_bin {
+  BINOP_UNDEFINED = 0,
+  // ARITHMETIC
+  BINOP_ARIT_PLUS, BINOP_ARIT_MINUS, BINOP_ARIT_MUL, BINOP_ARIT_DIV, BINOP_ARIT_MOD,
+  // COMPARISON
+  BINOP_COMP_EQ, BINOP_COMP_NEQ,
+  BINOP_COMP_LTHAN, BINOP_COMP_GTHAN, BINOP_COMP_LTHAN_EQ, BINOP_COMP_GTHAN_EQ,
+  // LOGICAL
+  BINOP_LOG_AND, BINOP_LOG_OR,
+  // BITWISE ARITHMETIC
+  BINOP_BIT_AND, BINOP_BIT_OR, BINOP_BIT_XOR, BINOP_BIT_LSHIFT, BINOP_BIT_RSHIFT,
+  // ASSIGNMENT
+  BINOP_ASSIGN,
+  BINOP_ARIT_PLUS_EQ, BINOP_ARIT_MINUS_EQ, BINOP_ARIT_MUL_EQ, BINOP_ARIT_DIV_EQ, BINOP_ARIT_MOD_EQ,
+  BINOP_BIT_AND_EQ, BINOP_BIT_OR_EQ, BINOP_BIT_XOR_EQ, BINOP_BIT_LSHIFT_EQ, BINOP_BIT_RSHIFT_EQ
+} AST_OperatorBin;
+
+// Every node keeps the token it starts at (or its operator's), so later passes can report at it. Lists are arrays
+// of s_<list> nodes, optional children are NULL when absent.
+
+struct ast_node_type_ident {
+  TypeGo            type_go;
+  Token             token;
+  AST_NodeTypeIdent elem; // pointed type of TG_POINTER, element type of TG_SLICE
+};
+
+struct ast_node_literal {
+  TypeGo type_go;
+  Token  token;
+  union {
+    int64_t  val_int64;
+    double   val_double;
+    bool     val_bool;
+    SymbolId val_string; // interned, char literals keep their text in the token
+  } literal;
+};
+
+struct ast_node_expr_member {
+  AST_NodeExpr object;
+  Token        member;
+};
+
+struct ast_node_expr_index {
+  Token        token;
+  AST_NodeExpr object,
+               index;
+};
+
+struct ast_node_expr_call {
+  Token         token;
+  AST_NodeExpr  callee;
+  uint32_t      s_args;
+  AST_NodeExpr *args;
+};
+
+struct ast_node_expr_unary {
+  AST_OperatorUnary unary_operator;
+  Token             token;
+  AST_NodeExpr      operand;
+};
+
+struct ast_node_expr_bin {
+  AST_OperatorBin expr_operator;
+  Token           token;
+  AST_NodeExpr    expr_left,
+                  expr_right;
+};
+
+// A statement or declaration that did not parse, the parser resumed after its tokens [token, token + s_tokens)
+struct ast_node_error {
+  Token    token;
+  uint32_t s_tokens;
+};
+
+// ast_token is a lone identifier, _ or iota, parentheses leave no node
+struct ast_node_expr {
+  AST_NodeType type_expr;
+  union {
+    Token                       token;
+    struct ast_node_literal     literal;
+    struct ast_node_expr_member expr_member;
+    struct ast_node_expr_index  expr_index;
+    struct ast_node_expr_call   expr_call;
+    struct ast_node_expr_unary  expr_unary;
+    struct ast_node_expr_bin    expr_bin;
+  } expr;
+};
+
+// var and const declarations, and := (without type_var)
+struct ast_node_var {
+  Token             token;
+  bool              constant;
+  AST_NodeTypeIdent type_var;
+  AST_NodeExpr      value;
+};
+
+// = and the compound assignments
+struct ast_node_stmt_assign {
+  AST_OperatorBin assign_operator;
+  Token           token;
+  AST_NodeExpr    target,
+                  expr;
+};
+
+struct ast_node_stmt_return {
+  Token         token;
+  uint32_t      s_exprs;
+  AST_NodeExpr *exprs;
+};
+
+struct ast_node_stmt_if {
+  Token             token;
+  AST_NodeStmt      init;
+  AST_NodeExpr      condition;
+  AST_NodeStmtBlock if_block;
+  AST_NodeStmtIf    elseif;
+  AST_NodeStmtBlock else_block;
+};
+
+struct ast_node_stmt_while {
+  Token             token;
+  bool              do_while;
+  AST_NodeExpr      condition;
+  AST_NodeStmtBlock block;
+};
+
+// for {}, for condition {}, for init; condition; update {} and for [key[, value] [:=]] range expr {}
+struct ast_node_stmt_for {
+  Token             token;
+  AST_NodeStmt      init,
+                    update;
+  AST_NodeExpr      condition;
+  bool              declare;
+  uint32_t          s_iterators;
+  Token             iterators[2];
+  AST_NodeExpr      range;
+  AST_NodeStmtBlock block;
+};
+
+struct ast_node_stmt_block {
+  Token        token;
+  uint32_t     s_stmts;
+  AST_NodeStmt stmts;
+};
+
+struct ast_node_stmt {
+  AST_NodeType type_stmt;
+  union {
+    AST_NodeExpr                expr;
+    struct ast_node_var         var;
+    struct ast_node_stmt_assign stmt_assign;
+    struct ast_node_stmt_return stmt_return;
+    AST_NodeStmtIf              stmt_if;
+    struct ast_node_stmt_while  stmt_while;
+    struct ast_node_stmt_for    stmt_for;
+    AST_NodeStmtBlock           stmt_block;
+    struct ast_node_error       error;
+  } stmt;
+};
+
+struct ast_node_func_declare {
+  Token                       func;
+  uint32_t                    s_args,
+                              s_return;
+  AST_NodeVar                 args;
+  struct ast_node_type_ident *type_return;
+};
+
+// block is NULL until parsed when the program is lazy, read it through goc_parser_func_block
+struct ast_node_func {
+  AST_NodeFuncDeclare declare;
+  AST_NodeStmtBlock   block;
+  Token               body; // its '{'
+};
+
+struct ast_node_method {
+  struct ast_node_var receiver;
+  AST_NodeFunc        func;
+};
+
+struct ast_node_interface {
+  Token                         token;
+  uint32_t                      s_methods;
+  struct ast_node_func_declare *methods;
+};
+
+struct ast_node_union {
+  Token       token;
+  uint32_t    s_fields;
+  AST_NodeVar fields;
+};
+
+struct ast_node_struct {
+  Token       token;
+  uint32_t    s_fields;
+  AST_NodeVar fields;
+};
+
+// assign[i] is the explicit value of values[i], NULL when it has none
+struct ast_node_enum {
+  Token         token;
+  uint32_t      s_values;
+  Token        *values;
+  AST_NodeExpr *assign;
+};
+
+struct ast_node_import {
+  Token    token;
+  uint32_t s_imports;
+  Token   *imports;
+};
+
+union ast_node_file_block {
+  AST_NodeImport      import;
+  AST_NodeEnum        node_enum;
+  AST_NodeUnion       node_union;
+  AST_NodeStruct      node_struct;
+  AST_NodeInterface   interface;
+  AST_NodeMethod      method;
+  AST_NodeVar         var;
+  AST_NodeFunc        func;
+  AST_NodeFuncDeclare func_declare;
+  AST_NodeError       error;
+};
+
+// file_blocks[i] is the top-level declaration of type type_file_blocks[i], in source order
+struct ast_node_file {
+  TokenArray                 tokens;
+  uint32_t                   s_file_blocks;
+  AST_NodeType              *type_file_blocks;
+  union ast_node_file_block *file_blocks;
+};
+
+struct ast_node_package {
+  Token        package;
+  uint32_t     s_files;
+  AST_NodeFile files;
+};
+
+// Nodes and bytes an AST took from its arena, per kind. Expressions count under their own kind (ast_token,
+// ast_node_expr_bin, ...), statements under their type_stmt, of which s_stmts are (local vars and errors included),
+// and lists of nodes stored by value as nodes of their element kind. The slot of an if or a block statement only adds
+// its bytes, the node is its struct ast_node_stmt_if or ast_node_stmt_block. Lists of pointers or tokens, and the
+// parallel lists of a file or an enum, are s_lists lists of s_list_bytes.
+typedef struct ast_stats {
+  size_t s_nodes[ast_node_program + 1],
+         s_bytes[ast_node_program + 1],
+         s_stmts,
+         s_lists,
+         s_list_bytes;
+} ASTStats;
+
+// Every node of a program, the program itself included, lives in its arena. diagnostics holds its syntax errors.
+struct ast_node_program {
+  uint32_t        s_packages;
+  AST_NodePackage packages;
+  AST_NodeFunc    main;
+  Arena           arena;
+  ASTStats        stats;
+  Diagnostics     diagnostics;
+};
+
+// Parses the tokens of a `package main` file, which must outlive the AST (nodes hold Tokens into it).
+// A syntax error is collected in the program's diagnostics, the statement or declaration it is in becomes an
+// ast_node_error and parsing resumes at the next one, so one run finds them all. Only the first error of a line is
+// kept, and parsing stops at the tenth.
+AST_NodeProgram goc_parser(TokenArray array);
+// Same AST and errors, the top-level declarations parsed by s_threads threads (0: one per online core), for
+// sources of a few hundred thousand tokens and up
+AST_NodeProgram goc_parser_parallel(TokenArray array, uint32_t s_threads);
+// Declarations and signatures only, function bodies are skipped by brace matching and parsed on first access, for
+// consumers that do not need most of them. A syntax error in a body is only added to the diagnostics once it is parsed.
+AST_NodeProgram goc_parser_lazy(TokenArray array);
+// Body of func, parsed into program's arena on first access (not thread-safe)
+AST_NodeStmtBlock goc_parser_func_block(AST_NodeProgram program, AST_NodeFunc func);
+// Parses every body a lazy program has left
+void            goc_parser_expand(AST_NodeProgram program);
+// Releases the whole AST at once, with its arena and diagnostics
+void            goc_parser_free(AST_NodeProgram program);
+
+// Syntax errors, owned by the program, in source order (a lazy program adds those of a body when it is parsed)
+Diagnostics     goc_parser_get_diagnostics(AST_NodeProgram program);
+
+// Indented tree, one node per line, the bodies of a lazy program parsed
+void            goc_parser_dump(FILE *out, AST_NodeProgram program);
+// One line per node kind in use, one for the lists, then the arena's total and reserved bytes
+void            goc_parser_print_stats(FILE *out, AST_NodeProgram program);
 
 #endif // !GOC_PARSER_H
@@ -0,0 +1,119 @@
+#ifndef GOC_PARSER_FLAT_H
+#define GOC_PARSER_FLAT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "goc_error.h"
+#include "goc_lexer.h"
+#include "goc_parser.h"
+
+// Flat form of an AST, for the passes that walk it. Nodes are 16 byte records in one contiguous pool per category
+// (expressions, statements, types, declarations), children are 32-bit indices into the pool their field names
+// below, tokens are indices into the TokenArray. Lists live in the extra array: a list is the offset of its count,
+// followed by its items. Each node is emitted before its children, so a pool is in pre-order and a linear scan of
+// it visits the nodes in source order.
+//
+// pool  kind                   token          op                  lhs                       rhs
+// EXPR  ast_token              identifier
+//       ast_node_literal       literal        TypeGo              literals index
+//       ast_node_expr_member   member                             object expr
+//       ast_node_expr_index    [                                  object expr               index expr
+//       ast_node_expr_call     (                                  callee expr               list of arg exprs
+//       ast_node_expr_unary    operator       AST_OperatorUnary   operand expr
+//       ast_node_expr_bin      operator       AST_OperatorBin     left expr                 right expr
+// STMT  ast_node_stmt_expr                                        expr
+//       ast_node_var           name           constant            type                      value expr
+//       ast_node_stmt_assign   operator       AST_OperatorBin     target expr               value expr
+//       ast_node_stmt_return   return                             list of exprs
+//       ast_node_stmt_if       if                                 condition expr            extra offset of init stmt,
+//                                                                                           block, else if, else block
+//       ast_node_stmt_while    while / do     do_while            condition expr            block stmt
+//       ast_node_stmt_for      for            declare             extra offset of init stmt, update stmt, condition
+//                                                                 expr, range expr, block, s_iterators, 2 tokens
+//       ast_node_stmt_block    {                                  list of stmts
+//       ast_node_error         first token                        s_tokens (a count)
+// TYPE  ast_node_type_ident    type           TypeGo              elem type
+// DECL  ast_node_var           as in STMT, for fields, args, receivers and top-level var and const
+//       ast_node_func_declare  name                               list of arg decls         list of return types
+//       ast_node_func          name                               func_declare decl         block stmt
+//       ast_node_method        name                               receiver decl             func decl
+//       ast_node_import        import                             list of path tokens
+//       ast_node_union         name                               list of field decls
+//       ast_node_struct        name                               list of field decls
+//       ast_node_enum          name                               list of value tokens      list of value exprs
+//       ast_node_interface     name                               list of func_declare decls
+//       ast_node_error         as in STMT
+//
+// Absent children, empty fields and the tokens of nodes without one are AST_FLAT_NONE.
+
+typedef struct ast_flat *AST_Flat;
+typedef uint32_t         AST_FlatIndex;
+
+#define AST_FLAT_NONE UINT32_MAX
+
+typedef enum ast_flat_pool {
+  AST_FLAT_EXPR = 0,
+  AST_FLAT_STMT,
+  AST_FLAT_TYPE,
+  AST_FLAT_DECL,
+  AST_FLAT_POOLS
+} AST_FlatPool;
+
+struct ast_flat_node {
+  uint8_t       kind; // AST_NodeType
+  uint8_t       op;
+  uint32_t      token;
+  AST_FlatIndex lhs,
+                rhs;
+};
+
+union ast_flat_literal {
+  int64_t  val_int64;
+  double   val_double;
+  bool     val_bool;
+  SymbolId val_string;
+};
+
+struct ast_flat {
+  TokenArray              tokens;
+  struct ast_flat_node   *pools[AST_FLAT_POOLS];
+  uint32_t                s_pools[AST_FLAT_POOLS];
+  AST_FlatIndex          *extra;
+  uint32_t                s_extra;
+  union ast_flat_literal *literals;
+  uint32_t                s_literals;
+  uint32_t                package;     // token of the package name
+  AST_FlatIndex           file_blocks, // list of the top-level decls, in source order
+                          main;        // decl of func main
+};
+
+// Built from a parsed program, a lazy one expanded first, which can be freed afterwards (the TokenArray cannot)
+AST_Flat goc_parser_flatten(AST_NodeProgram program);
+void     goc_parser_flat_free(AST_Flat flat);
+
+// Bytes of the pools, extra and literals arrays
+size_t   goc_parser_flat_get_size(AST_Flat flat);
+
+// Same text as goc_parser_dump of the program it was built from
+void     goc_parser_flat_dump(FILE *out, AST_Flat flat);
+
+static inline const struct ast_flat_node *goc_parser_flat_node(AST_Flat flat, AST_FlatPool pool, AST_FlatIndex index) {
+  goc_error_check(goc_error_inval_arg, index < flat->s_pools[pool]);
+  return &(flat->pools[pool][index]);
+}
+
+// Items of the list at offset list in extra
+static inline const AST_FlatIndex *goc_parser_flat_list(AST_Flat flat, AST_FlatIndex list, uint32_t *s_items) {
+  goc_error_check(goc_error_inval_arg, list < flat->s_extra);
+  *s_items = flat->extra[list];
+  return &(flat->extra[list + 1]);
+}
+
+static inline Token goc_parser_flat_token(AST_Flat flat, AST_FlatIndex token) {
+  return (Token){ flat->tokens, token };
+}
+
+#endif // !GOC_PARSER_FLAT_H
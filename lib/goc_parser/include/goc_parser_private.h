@@ -3,320 +3,316 @@
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <stdboo.h>
+#include <stdbool.h>
 #include <stdint.h>
-#include <ctype.h>
 #include <string.h>
+#include <setjmp.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 #include "goc_error.h"
+#include "goc_diagnostic.h"
+#include "goc_source.h"
+#include "goc_arena.h"
 #include "goc_lexer.h"
+#include "goc_lexer_inline.h"
 #include "goc_parser.h"
 
 // Terminology: AST <=> Abstract Syntax Tree
 
-// Go (Modified) Type
-typedef enum type_go {
-  TG_UNKNOW = 0,
-  TG_VOID, TG_BOOL,
-  TG_INT8, TG_INT16, TG_INT32, TG_INT64,
-  TG_UINT8, TG_UINT16, TG_UINT32, TG_UINT64,
-  TG_FLOAT, TG_DOUBLE,
-  TG_CHAR, TG_STRING,
-  TG_POINTER, TG_SLICE, TG_STRUCT,
-  TG_ENUM, TG_FUNCTION, TG_INTERFACE,
-} TypeGo;
-
-// AST Node Type
-typedef enum ast_node_type {
-  ast_undefined = 0,
-  ast_token, ast_node_literal,
-  ast_node_expr_member, ast_node_expr_unary, ast_node_expr_bin, ast_node_expr,
-  ast_node_stmt_assign, ast_node_stmt_return, ast_node_stmt_if, ast_node_stmt_while, ast_node_stmt_for, ast_node_stmt, ast_node_stmt_block,
-  ast_node_var, ast_node_func_declare, ast_node_func, ast_node_method,
-  ast_node_slice, ast_node_union, ast_node_enum, ast_node_struct, ast_node_interface,
-  ast_node_file, ast_node_package, ast_node_program
-} AST_NodeType;
-
-struct ast_node_literal {
-  TypeGo type_go;
-  union {
-    int8_t  val_int8;  int16_t  val_int16;  int32_t  val_int32;  int64_t  val_int64;
-    uint8_t val_uint8; uint16_t val_uint16; uint32_t val_uint32; uint64_t val_uint64;
-    float   val_float; double   val_double;
-    char    val_ch;    char    *val_string;
-    bool    val_bool;
-  } literal;
+// Single pass over the tokens: every decision is taken on the current token and a bounded lookahead, nothing is
+// ever re-parsed. Statements are recursive descent, expressions precedence climbing over goc_parser_binops.
+// source and base (the SourceLoc of its first byte) let the parser look at the text between two tokens.
+// Nodes are bump allocated from arena and counted in stats. A list is first pushed on the scratch stack, and copied
+// into the arena once its size is known: an item is complete, its own lists included, before it is pushed, so the
+// lists being built are always nested and each one is a contiguous run at the top of the stack.
+// When lazy, function bodies are skipped by brace matching, for goc_parser_func_block to parse them on first access.
+// A syntax error is added to diagnostics, unless one already was on its line, and recover is jumped to: the file and
+// each block set it, and resume at the next declaration or statement (panic mode). error_line is the line of the
+// last error added. depth counts the blocks and operands being parsed, past PARSER_DEPTH_MAX it is an error, so that
+// valid but deeply nested input cannot overflow the stack; a recovery point restores its own depth.
+struct parser_state {
+  TokenCursor          cursor;
+  SymbolId             main;
+  const char          *source;
+  SourceLoc            base;
+
+  Arena                arena;
+  ASTStats            *stats;
+  uint8_t             *scratch;
+  size_t               s_scratch,
+                       s_scratch_capacity;
+
+  bool                 lazy;
+  jmp_buf             *recover;
+  uint32_t             depth;
+  Diagnostics          diagnostics;
+  size_t               error_line;
 };
 
-struct ast_node_expr_member {
-  AST_NodeType type_ds;
-  uint64_t offset;
-  union {
-    AST_NodeSlice  slice;
-    AST_NodeStruct struct;
-  } data_structure;
+// One run [start, end) of top-level declarations for the parallel parser, start at a declaration keyword outside
+// braces and parentheses and end at the next chunk's or at TT_EOF. Parsed by its own parser into its own arena and
+// file, then stitched into the program's file. reached is where its parser stopped, end for any input the skim
+// split right.
+struct parser_chunk {
+  size_t               start,
+                       end,
+                       reached;
+  ASTStats             stats;
+  struct ast_node_file file;
+  struct parser_state  parser;
 };
 
-struct ast_node_expr_unary {
-  AST_NodeType type_operand;
-  enum {
-    UNOP_PLUS,    UNOP_MINUS,
-    UNOP_LOG_NOT, UNOP_BIT_NOT,
-    UNOP_DEREF,   UNOP_REF,
-    UNOP_INCR,    UNOP_DECR
-  } unary_operator;
-  union {
-    AST_NodeExpr       expr;
-    AST_NodeStmtAssign stmt_assign;
-  } operand;
+// Work shared by the parallel parser's threads, each takes the next chunk until none is left
+struct parser_pool {
+  TokenArray           array;
+  struct parser_chunk *chunks;
+  size_t               s_chunks;
+  atomic_size_t        next;
+  SymbolId             main;
+  const char          *source;
+  SourceLoc            base;
 };
 
-struct ast_node_expr_bin {
-  AST_NodeType type_expr_left,
-               type_expr_right;
-  enum {
-    // ARITHMETIC
-    BINOP_ARIT_PLUS, BINOP_ARIT_MINUS, BINOP_ARIT_MUL, BINOP_ARIT_DIV, BINOP_ARIT_MOD,
-    BINOP_ARIT_PLUS_EQ, BINOP_ARIT_MINUS_EQ, BINOP_ARIT_MUL_EQ, BINOP_ARIT_DIV_EQ, BINOP_ARIT_MOD_EQ,
-    // COMPARISON
-    BINOP_COMP_EQ, BINOP_COMP_NEQ,
-    BINOP_COMP_LTHAN, BINOP_COMP_GTHAN, BINOP_COMP_LTHAN_EQ, BINOP_COMP_GTHAN_EQ,
-    // LOGICAL
-    BINOP_LOG_AND, BINOP_LOG_OR,
-    // BITWISE ARITHMETIC
-    BINOP_BIT_AND, BINOP_BIT_OR, BINOP_BIT_XOR, BINOP_BIT_LSHIFT, BINOP_BIT_RSHIFT
-    BINOP_BIT_AND_EQ, BINOP_BIT_OR_EQ, BINOP_BIT_XOR_EQ, BINOP_BIT_LSHIFT_EQ, BINOP_BIT_RSHIFT_EQ
-  } expr_operator;
-  union {
-    AST_NodeExpr       expr;
-    AST_NodeStmtAssign stmt_assign;
-  } expr_left;
-  union {
-    AST_NodeExpr       expr;
-    AST_NodeStmtAssign stmt_assign;
-  } expr_right;
-};
-
-struct ast_node_expr {
-  AST_NodeType type_expr;
-  union {
-    AST_NodeLiteral    literal;
-    AST_NodeVar        var;
-    AST_NodeSlice      slice;
-    AST_NodeExprMember expr_member;
-    AST_NodeExprUnary  expr_unary;
-    AST_NodeExprBin    expr_bin;
-  }
-};
-
-struct ast_node_stmt_assign {
-  AST_NodeVar  var;
-  AST_NodeExpr expr;
-};
-
-struct ast_node_stmt_return {
-  AST_NodeType type_stmt;
-  union {
-    AST_NodeExpr       expr;
-    AST_NodeStmtAssign stmt_assign;
-  } return;
-};
-
-struct ast_node_stmt_if {
-  bool has_else;
-  uint32_t s_elseif;
-  AST_NodeVar       init;
-  AST_NodeExpr      condition;
-  AST_NodeStmtBlock if_block;
-  AST_NodeStmtIf    elseif;
-  AST_NodeStmtBlock else_block;
-};
-
-struct ast_node_stmt_loop_while {
-  bool loop_while;
-  AST_NodeExpr      condition;
-  AST_NodeStmtBlock block;
-};
+static const size_t parser_chunk_tokens_min = 64 * 1024;
+static const size_t parser_chunks_per_thread = 4;
 
-struct ast_node_stmt_loop_for {
-  uint32_t s_init,
-           s_update;
-  AST_NodeVar        init;
-  AST_NodeExpr       condition;
-  AST_NodeStmtAssign update;
-  AST_NodeStmtBlock  block;
-};
+#define PARSER_ERRORS_MAX 10
+#define PARSER_DEPTH_MAX  1000
 
-struct ast_node_stmt {
-  AST_NodeStmtType type_stmt;
-  union {
-    struct ast_node_expr          expr;
-    struct ast_node_stmt_assign   stmt_assign;
-    struct ast_node_stmt_return   stmt_return;
-    struct ast_node_stmt_if       stmt_if;
-    struct ast_stmt_loop_while    stmt_loop_while;
-    struct ast_node_stmt_loop_for stmt_loop_for;
-    struct ast_node_stmt_block    stmt_block;
-  } stmt;
+// Scratch records of the lists the AST splits in two parallel arrays
+struct parser_file_block {
+  AST_NodeType              type;
+  union ast_node_file_block block;
 };
 
-struct ast_node_stmt_block {
-  uint32_t s_stmts;
-  AST_NodeStmt stmts;
+struct parser_enum_value {
+  Token        value;
+  AST_NodeExpr assign;
 };
 
-union ast_node_type_ident {
-  TypeGo type_go;
-  Token  type_custom;
+// First arena chunk, sized so that a whole AST fits in it (the generated bench source takes 34 bytes per token)
+#define PARSER_ARENA_BYTES_PER_TOKEN 40
+#define PARSER_SCRATCH_SIZE_INIT     (4 * 1024)
+
+// Typed allocation from the parser's arena, kind naming both the AST_NodeType and its struct. Nodes are aligned to
+// their own type, not to max_align_t as malloc's are, and lists are sized exactly.
+#define goc_parser_ast_new(parser, kind) \
+  ((struct kind *)_goc_parser_ast_node_create((parser), (kind), sizeof(struct kind), _Alignof(struct kind), 1))
+// List of s_items nodes of struct kind, pushed on the scratch stack since start
+#define goc_parser_ast_list(parser, kind, start, s_items) \
+  ((struct kind *)_goc_parser_ast_list((parser), (kind), (start), (s_items), sizeof(struct kind), _Alignof(struct kind)))
+// List of s_items pointers or tokens of type, counted as a list
+#define goc_parser_ast_list_of(parser, type, start, s_items) \
+  ((type *)_goc_parser_ast_list((parser), ast_undefined, (start), (s_items), sizeof(type), _Alignof(type)))
+#define goc_parser_scratch_push(parser, item) _goc_parser_scratch_push((parser), &(item), sizeof(item))
+
+#define goc_parser_check(condition) goc_error_check(goc_error_parser_ast_undefined, condition)
+
+// Binding power of the binary operators (0 for any other token), Go's five levels
+#define PARSER_POWER_NONE 0
+#define PARSER_POWER_OR   1
+#define PARSER_POWER_AND  2
+#define PARSER_POWER_COMP 3
+#define PARSER_POWER_ADD  4
+#define PARSER_POWER_MUL  5
+
+static const struct {
+  uint8_t         power;
+  AST_OperatorBin binop;
+} goc_parser_binops[TT_EOF + 1] = {
+  [TT_BINOP_LOG_OR]        = { PARSER_POWER_OR,   BINOP_LOG_OR },
+  [TT_BINOP_LOG_AND]       = { PARSER_POWER_AND,  BINOP_LOG_AND },
+  [TT_BINOP_COMP_EQ]       = { PARSER_POWER_COMP, BINOP_COMP_EQ },
+  [TT_BINOP_COMP_NEQ]      = { PARSER_POWER_COMP, BINOP_COMP_NEQ },
+  [TT_BINOP_COMP_LTHAN]    = { PARSER_POWER_COMP, BINOP_COMP_LTHAN },
+  [TT_BINOP_COMP_GTHAN]    = { PARSER_POWER_COMP, BINOP_COMP_GTHAN },
+  [TT_BINOP_COMP_LTHAN_EQ] = { PARSER_POWER_COMP, BINOP_COMP_LTHAN_EQ },
+  [TT_BINOP_COMP_GTHAN_EQ] = { PARSER_POWER_COMP, BINOP_COMP_GTHAN_EQ },
+  [TT_PLUS]                = { PARSER_POWER_ADD,  BINOP_ARIT_PLUS },
+  [TT_MINUS]               = { PARSER_POWER_ADD,  BINOP_ARIT_MINUS },
+  [TT_BINOP_BIT_OR]        = { PARSER_POWER_ADD,  BINOP_BIT_OR },
+  [TT_BINOP_BIT_XOR]       = { PARSER_POWER_ADD,  BINOP_BIT_XOR },
+  [TT_STAR]                = { PARSER_POWER_MUL,  BINOP_ARIT_MUL },
+  [TT_BINOP_ARIT_DIV]      = { PARSER_POWER_MUL,  BINOP_ARIT_DIV },
+  [TT_BINOP_ARIT_MOD]      = { PARSER_POWER_MUL,  BINOP_ARIT_MOD },
+  [TT_AMPER]               = { PARSER_POWER_MUL,  BINOP_BIT_AND },
+  [TT_BINOP_BIT_AND]       = { PARSER_POWER_MUL,  BINOP_BIT_AND },
+  [TT_BINOP_BIT_LSHIFT]    = { PARSER_POWER_MUL,  BINOP_BIT_LSHIFT },
+  [TT_BINOP_BIT_RSHIFT]    = { PARSER_POWER_MUL,  BINOP_BIT_RSHIFT },
 };
 
-struct ast_node_var {
-  Token  token;
-  bool   is_type_go; 
-  AST_NodeTypeIdent type_var;
-  AST_NodeExpr      value;
+static const AST_OperatorBin goc_parser_assign_ops[TT_EOF + 1] = {
+  [TT_ASSIGN]              = BINOP_ASSIGN,
+  [TT_BINOP_ARIT_PLUS_EQ]  = BINOP_ARIT_PLUS_EQ,
+  [TT_BINOP_ARIT_MINUS_EQ] = BINOP_ARIT_MINUS_EQ,
+  [TT_BINOP_ARIT_MUL_EQ]   = BINOP_ARIT_MUL_EQ,
+  [TT_BINOP_ARIT_DIV_EQ]   = BINOP_ARIT_DIV_EQ,
+  [TT_BINOP_ARIT_MOD_EQ]   = BINOP_ARIT_MOD_EQ,
+  [TT_BINOP_BIT_AND_EQ]    = BINOP_BIT_AND_EQ,
+  [TT_BINOP_BIT_OR_EQ]     = BINOP_BIT_OR_EQ,
+  [TT_BINOP_BIT_XOR_EQ]    = BINOP_BIT_XOR_EQ,
+  [TT_BINOP_BIT_LSHIFT_EQ] = BINOP_BIT_LSHIFT_EQ,
+  [TT_BINOP_BIT_RSHIFT_EQ] = BINOP_BIT_RSHIFT_EQ,
 };
 
-struct ast_node_func_declare {
-  Token    func;
-  uint32_t s_args,
-           s_return; 
-  bool    *is_type_go;
-  AST_NodeVar       args;
-  AST_NodeTypeIdent type_return;
+static const AST_OperatorUnary goc_parser_unops[TT_EOF + 1] = {
+  [TT_PLUS]          = UNOP_PLUS,
+  [TT_MINUS]         = UNOP_MINUS,
+  [TT_UNOP_LOG_NOT]  = UNOP_LOG_NOT,
+  [TT_UNOP_BIT_NOT]  = UNOP_BIT_NOT,
+  [TT_BINOP_BIT_XOR] = UNOP_BIT_NOT,
+  [TT_STAR]          = UNOP_DEREF,
+  [TT_AMPER]         = UNOP_REF,
+  [TT_BINOP_BIT_AND] = UNOP_REF,
 };
 
-struct ast_node_func {
-  AST_NodeFuncDeclare declare;
-  AST_NodeStmtBlock   block;
-  AST_NodeStmtReturn  return;
+// Builtin type keywords, TG_UNKNOW for any other token
+static const TypeGo goc_parser_types_go[TT_EOF + 1] = {
+  [TT_INT8]   = TG_INT8,   [TT_INT16]  = TG_INT16,  [TT_INT32]  = TG_INT32,  [TT_INT64]  = TG_INT64,
+  [TT_UINT8]  = TG_UINT8,  [TT_UINT16] = TG_UINT16, [TT_UINT32] = TG_UINT32, [TT_UINT64] = TG_UINT64,
+  [TT_FLOAT]  = TG_FLOAT,  [TT_DOUBLE] = TG_DOUBLE,
+  [TT_CHAR]   = TG_CHAR,   [TT_STRING] = TG_STRING,
+  [TT_BOOL]   = TG_BOOL,
 };
 
-struct ast_node_slice {
-  uint64_t s_slice;
-  AST_NodeVar var;
+// Keywords a statement can resume at after a syntax error: those that start one, and the declaration keywords that
+// end its block
+static const bool goc_parser_sync_stmt[TT_EOF + 1] = {
+  [TT_VAR]       = true, [TT_CONST] = true, [TT_IF]     = true, [TT_FOR]    = true,
+  [TT_WHILE]     = true, [TT_DO]    = true, [TT_RETURN] = true, [TT_FUNC]   = true,
+  [TT_IMPORT]    = true, [TT_ENUM]  = true, [TT_UNION]  = true, [TT_STRUCT] = true,
+  [TT_INTERFACE] = true,
 };
 
-struct ast_node_interface {
-  TypeGo   type_go;
-  Token    interface;
-  uint32_t s_methods;
-  AST_NodeFuncDeclare methods;
+// Keywords that start a top-level declaration
+static const bool goc_parser_declarations[TT_EOF + 1] = {
+  [TT_IMPORT]    = true, [TT_ENUM] = true, [TT_UNION] = true, [TT_STRUCT] = true,
+  [TT_INTERFACE] = true, [TT_VAR]  = true, [TT_CONST] = true, [TT_FUNC]   = true,
 };
 
-struct ast_node_union {
-  Token union;
-  uint32_t s_types;
-  AST_NodeTypeIdent types;
-  TokenArray        values;
-};
+// Depth change of a token when a lazy parse skips a body, PARSER_SKIP_END where the body's '}' must be missing:
+// TT_EOF, and the declaration keywords goc_parser_block_missing_end is true for
+#define PARSER_SKIP_END INT8_MAX
 
-struct ast_node_enum {
-  Token    enum;
-  bool     iota;
-  uint32_t s_values,
-           s_assign;
-  TokenArray values;
-  TokenArray assign;
+static const int8_t goc_parser_skip[TT_EOF + 1] = {
+  [TT_LBRACE] = 1,               [TT_RBRACE]    = -1,
+  [TT_IMPORT] = PARSER_SKIP_END, [TT_ENUM]      = PARSER_SKIP_END, [TT_UNION] = PARSER_SKIP_END,
+  [TT_STRUCT] = PARSER_SKIP_END, [TT_INTERFACE] = PARSER_SKIP_END, [TT_FUNC]  = PARSER_SKIP_END,
+  [TT_EOF]    = PARSER_SKIP_END,
 };
 
-struct ast_node_method {
-  AST_NodeStruct struct;
-  AST_NodeFunc   func;
+// Spelling of the tokens the parser expects, for its error messages
+static const char *goc_parser_token_text[TT_EOF + 1] = {
+  [TT_IDENT]      = "an identifier",
+  [TT_LBRACE]     = "'{'", [TT_RBRACE]   = "'}'",
+  [TT_LPAREN]     = "'('", [TT_RPAREN]   = "')'",
+  [TT_LSQPAREN]   = "'['", [TT_RSQPAREN] = "']'",
+  [TT_SEMICOLON]  = "';'", [TT_COLON]    = "':'",
+  [TT_COMMA]      = "','", [TT_RANGE]    = "'range'",
+  [TT_WHILE]      = "'while'",  [TT_FUNC]     = "'func'",
+  [TT_PACKAGE]    = "'package'",
+  [TT_STRING_LIT] = "a string literal",
 };
 
-struct ast_node_struct {
-  Token struct;
-  uint32_t s_types;
-  AST_NodeTypeIdent types;
+// Row labels of goc_parser_print_stats
+static const char *goc_parser_node_names[ast_node_program + 1] = {
+  [ast_node_error]        = "error",
+  [ast_token]             = "ident",       [ast_node_literal]     = "literal",
+  [ast_node_expr_member]  = "member",      [ast_node_expr_index]  = "index",
+  [ast_node_expr_call]    = "call",        [ast_node_expr_unary]  = "unary",
+  [ast_node_expr_bin]     = "binary",      [ast_node_stmt_expr]   = "expr stmt",
+  [ast_node_stmt_assign]  = "assign",      [ast_node_stmt_return] = "return",
+  [ast_node_stmt_if]      = "if",          [ast_node_stmt_while]  = "while",
+  [ast_node_stmt_for]     = "for",         [ast_node_stmt]        = "stmt",
+  [ast_node_stmt_block]   = "block",       [ast_node_type_ident]  = "type",
+  [ast_node_var]          = "var",         [ast_node_func_declare] = "func declare",
+  [ast_node_func]         = "func",        [ast_node_method]      = "method",
+  [ast_node_import]       = "import",      [ast_node_union]       = "union",
+  [ast_node_enum]         = "enum",        [ast_node_struct]      = "struct",
+  [ast_node_interface]    = "interface",   [ast_node_file]        = "file",
+  [ast_node_package]      = "package",     [ast_node_program]     = "program",
 };
 
-struct ast_node_import {
-  uint32_t s_imports;
-  const char *imports;
-};
+#define PARSER_NO_TOKEN      ((Token){ NULL, 0 })
+#define PARSER_EXPECTED_EXPR "an expression"
+#define PARSER_EXPECTED_TYPE "a type"
 
-struct ast_node_file {
-  uint32_t s_file_blocks;
-  AST_NodeType *type_file_blocks;
-  union {
-    AST_NodeImport      import; 
-    AST_NodeEnum        enum;
-    AST_NodeUnion       union;
-    AST_NodeStruct      struct;
-    AST_NodeMethod      method;
-    AST_NodeVar         var;
-    AST_NodeFunc        func;
-    AST_NodeFuncDeclare func_declare;
-  } *file_blocks;
-};
+static struct parser_state goc_parser_state_create(TokenArray array, Arena arena, ASTStats *stats, Diagnostics diagnostics);
+static AST_NodeProgram     goc_parser_sequential(TokenArray array, bool lazy);
+static AST_NodeProgram     goc_parser_program_create(TokenArray array, struct parser_state *parser, size_t s_arena);
+static void                goc_parser_program_finish(struct parser_state *parser, AST_NodeProgram program, AST_NodeFile file);
+static void                goc_parser_parse_file(struct parser_state *parser, AST_NodeFile file, size_t end);
 
-struct ast_node_package {
-  Token    package;
-  uint32_t s_files; 
-  AST_NodeFile files;
-};
-
-struct ast_node_program {
-  uint32_t s_packages;
-  AST_NodePackage packages;
-  AST_NodeFunc    main;
-};
-
-static void goc_parser_parse_file(AST_NodeProgram program, TokenArray array, uint64_t *word_ptr, bool main_file);
-
-static void _goc_parser_find_package_dependencies();
+// Parallel parsing
+static size_t              goc_parser_parallel_split(TokenArray array, size_t start, struct parser_chunk *chunks, size_t s_chunks);
+static void                goc_parser_parallel_run(struct parser_pool *pool, uint32_t s_threads);
+static void               *goc_parser_parallel_parse(void *arg);
 
 // AST Node Objects
-static AST_NodeImport      _goc_parser_ast_node_import_create(uint32_t s_imports, const char *imports);
-static AST_NodeEnum        _goc_parser_ast_node_enum_create(
-  Token enum, bool iota, uint32_t s_values, uint32_t s_assign, TokenArray values, TokenArray assign
-);
-static AST_NodeUnion       _goc_parser_ast_node_union_create(Token union, uint32_t s_types, AST_NodeTypeIdent types, TokenArray values);
-static AST_NodeStruct      _goc_parser_ast_node_struct_create(Token struct, AST_NodeTypeIdent types, uint32_t s_types); 
-static AST_NodeMethod      _goc_parser_ast_node_method_create(AST_NodeStruct struct, AST_NodeFunc func);
-static AST_NodeVar         _goc_parser_ast_node_var_create(Token token, bool is_type_go, AST_NodeTypeIdent type_var, AST_NodeExpr value);
-static AST_NodeFunc        _goc_parser_ast_node_func_create(
-  AST_NodeFuncDeclare declare, AST_NodeStmtBlock block, AST_NodeStmtReturn return
-);
-static AST_NodeFuncDeclare _goc_parser_ast_node_func_declare_create(
-  Token func, uint32_t s_args, uint32_t s_return, bool *is_type_go, AST_NodeVar args, AST_NodeTypeIdent type_return
-);
+static AST_NodeImport      goc_parser_parse_import(struct parser_state *parser);
+static AST_NodeEnum        goc_parser_parse_enum(struct parser_state *parser);
+static AST_NodeUnion       goc_parser_parse_union(struct parser_state *parser);
+static AST_NodeStruct      goc_parser_parse_struct(struct parser_state *parser);
+static AST_NodeInterface   goc_parser_parse_interface(struct parser_state *parser);
+static AST_NodeVar         goc_parser_parse_fields(struct parser_state *parser, uint32_t *s_fields);
+static void                goc_parser_parse_var(struct parser_state *parser, AST_NodeVar var);
+static void                goc_parser_parse_arg(struct parser_state *parser, AST_NodeVar arg);
+static void                goc_parser_parse_func_declare(struct parser_state *parser, AST_NodeFuncDeclare declare);
+static AST_NodeTypeIdent   goc_parser_parse_type(struct parser_state *parser);
+static void                goc_parser_parse_type_into(struct parser_state *parser, AST_NodeTypeIdent type);
 
 // AST Node Statements
-static AST_NodeStmtBlock   _goc_parser_ast_node_stmt_block_create(AST_NodeType *type_stmts, void *stmts, uint64_t s_stmts);
-static AST_NodeStmt        _goc_parser_ast_node_stmt_create(AST_NodeType type_stmt, void *stmt);
-static AST_NodeStmtFor     _goc_parser_ast_node_stmt_loop_for_create(
-  uint32_t s_init, uint64_t s_update, AST_NodeVar init, AST_NodeExpr condition, AST_NodeStmtAssign update, AST_NodeStmtBlock block
-);
-static AST_NodeStmtWhile   _goc_parser_ast_node_stmt_loop_while_create(
-  bool loop_while, struct ast_node_expr *condition, struct ast_node_stmt_block *block
-);
-static AST_NodeStmtIf      _goc_parser_ast_node_stmt_if_create(
-  bool has_else, uint32_t s_elseif, AST_NodeType type_init, union ast_node_init *init, struct ast_node_expr *condition,
-  struct ast_node_stmt_block *if_block, struct ast_node_stmt_if *elseif, struct ast_node_stmt_block *else_block
-);
-static AST_NodeStmtReturn  _goc_parser_ast_node_stmt_return_create(AST_NodeType type_stmt, void *return);
-static AST_NodeStmtAssign  _goc_parser_ast_node_stmt_assign_create(struct ast_node_var *var, struct ast_node_stmt_expr *assign);
+static AST_NodeStmtBlock   goc_parser_parse_block(struct parser_state *parser);
+static void                goc_parser_skip_block(struct parser_state *parser);
+static void                goc_parser_parse_stmt(struct parser_state *parser, AST_NodeStmt stmt);
+static void                goc_parser_parse_stmt_simple(struct parser_state *parser, AST_NodeStmt stmt);
+static AST_NodeStmtIf      goc_parser_parse_stmt_if(struct parser_state *parser);
+static void                goc_parser_parse_stmt_for(struct parser_state *parser, AST_NodeStmtFor stmt_for);
+static bool                goc_parser_for_range(const struct parser_state *parser);
+static bool                goc_parser_iterator(TokenType type);
 
 // AST Node Expression
-static AST_NodeExpr        _goc_parser_ast_node_expr_create(AST_NodeType type_node, void *expr);
-static AST_NodeExprBin     _goc_parser_ast_node_expr_bin_create(
-  AST_NodeType type_expr_left, AST_NodeType type_expr_right, Token bin_op, void *expr_left, void *expr_right
-);
-static AST_NodeExprUnary   _goc_parser_ast_node_expr_unary_create(AST_NodeType type_expr, Token unary_op, void *operand);
-static AST_NodeExprMember  _goc_parser_ast_node_expr_member_create(AST_NodeType type_ds, uint64_t offset, void *data_structure);
-
-// AST Node Literal
-static AST_NodeLiteral     _goc_parser_ast_node_literal(TypeGo type_go, void *literal);
+static AST_NodeExpr        goc_parser_parse_expr(struct parser_state *parser, uint8_t power);
+static AST_NodeExpr        goc_parser_parse_expr_unary(struct parser_state *parser);
+static AST_NodeExpr        goc_parser_parse_expr_primary(struct parser_state *parser);
+static AST_NodeExpr        goc_parser_parse_expr_postfix(struct parser_state *parser, AST_NodeExpr expr);
+static bool                goc_parser_assignable(AST_NodeExpr expr);
+
+// Token stream
+static inline TokenType    goc_parser_type(const struct parser_state *parser);
+static inline Token        goc_parser_advance(struct parser_state *parser);
+static inline bool         goc_parser_accept(struct parser_state *parser, TokenType type);
+static inline void         goc_parser_separator(struct parser_state *parser);
+static bool                goc_parser_newline(const struct parser_state *parser);
+static inline bool         goc_parser_block_missing_end(TokenType type);
+static Token               goc_parser_expect(struct parser_state *parser, TokenType type);
+
+// Syntax errors
+static void                goc_parser_error_expected(struct parser_state *parser, Token token, const char *expected);
+static inline void         goc_parser_enter(struct parser_state *parser, Token token);
+static void                goc_parser_error(struct parser_state *parser, GOC_Error error, const char *message, Token token);
+static void                goc_parser_sync(struct parser_state *parser, size_t from, bool block);
 
 // AST Node Memory Allocation
-static void  *_goc_parser_ast_node_create(AST_NodeType type, uint64_t s_nodes);
-static uint64_t _goc_parser_ast_node_size(AST_NodeType type);
-
-static void goc_parser_print_error(
-  void goc_error_func(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word),
-  Token token
-);
+static inline void        *_goc_parser_ast_node_create(struct parser_state *parser, AST_NodeType kind, size_t size, size_t align, uint32_t s_nodes);
+static inline AST_NodeExpr _goc_parser_ast_expr_create(struct parser_state *parser, AST_NodeType type_expr);
+static inline void        *_goc_parser_ast_list_create(struct parser_state *parser, size_t size, size_t align);
+static void               *_goc_parser_ast_list(struct parser_state *parser, AST_NodeType kind, size_t start, uint32_t s_items, size_t s_item, size_t align);
+static inline void         _goc_parser_ast_stmt_count(struct parser_state *parser, const struct ast_node_stmt *stmt);
+static AST_NodeStmt        _goc_parser_ast_stmt_new(struct parser_state *parser, const struct ast_node_stmt *stmt);
+static inline void         _goc_parser_scratch_push(struct parser_state *parser, const void *item, size_t s_item);
+static void                _goc_parser_scratch_grow(struct parser_state *parser, size_t s_item);
+
+// AST dump
+static void  _goc_parser_dump_line(FILE *out, uint32_t depth, const char *label, Token token);
+static void  _goc_parser_dump_type(FILE *out, uint32_t depth, const char *label, AST_NodeTypeIdent type);
+static void  _goc_parser_dump_var(FILE *out, uint32_t depth, const char *label, AST_NodeVar var);
+static void  _goc_parser_dump_func_declare(FILE *out, uint32_t depth, AST_NodeFuncDeclare declare);
+static void  _goc_parser_dump_block(FILE *out, uint32_t depth, AST_NodeStmtBlock block);
+static void  _goc_parser_dump_stmt(FILE *out, uint32_t depth, AST_NodeStmt stmt);
+static void  _goc_parser_dump_stmt_if(FILE *out, uint32_t depth, AST_NodeStmtIf stmt_if);
+static void  _goc_parser_dump_expr(FILE *out, uint32_t depth, AST_NodeExpr expr);
 
 #endif // !GOC_PARSER_PRIVATE_H
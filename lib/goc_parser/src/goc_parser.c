@@ -3,169 +3,1414 @@
 
 // =======================================================# PUBLIC #==================================================================
 
-AST_NodeProgram goc_parser(FILE *file, TokenArray array) {
+AST_NodeProgram goc_parser(TokenArray array) {
+  return goc_parser_sequential(array, false);
+}
+
+AST_NodeProgram goc_parser_lazy(TokenArray array) {
+  return goc_parser_sequential(array, true);
+}
+
+// Splits the top-level declarations into chunks parsed by a pool of threads, each into its own arena. The chunks'
+// declarations are then copied into the file in chunk order and their arenas handed to the program's. On a syntax
+// error, or should the skim have split inside a declaration (only on invalid input), the source is parsed again
+// sequentially, so that both give the same AST and diagnostics as goc_parser.
+AST_NodeProgram goc_parser_parallel(TokenArray array, uint32_t s_threads) {
   if (array == NULL)
     return NULL;
 
-  size_t word_ptr = 0;
+  if (s_threads == 0) {
+    long s_cores = sysconf(_SC_NPROCESSORS_ONLN);
+    s_threads = s_cores > 0 ? (uint32_t)s_cores : 1;
+  }
+  size_t s_chunks = goc_lexer_inline_size(array) / parser_chunk_tokens_min;
+  if (s_chunks > (size_t)s_threads * parser_chunks_per_thread)
+    s_chunks = (size_t)s_threads * parser_chunks_per_thread;
+  if (s_threads == 1 || s_chunks <= 1)
+    return goc_parser(array);
+
+  struct parser_state parser;
+  AST_NodeProgram program = goc_parser_program_create(array, &parser, 0);
+  struct parser_chunk *chunks = (struct parser_chunk *)calloc(s_chunks, sizeof(struct parser_chunk));
+  goc_error_assert(goc_error_mem_error, chunks != NULL);
+  struct parser_pool pool = {
+    .array = array, .chunks = chunks, .s_chunks = goc_parser_parallel_split(array, parser.cursor.index, chunks, s_chunks),
+    .main = parser.main, .source = parser.source, .base = parser.base
+  };
+  goc_parser_parallel_run(&pool, s_threads);
+
+  AST_NodeFile file = goc_parser_ast_new(&parser, ast_node_file);
+  *file = (struct ast_node_file){ array, 0, NULL, NULL };
+  bool clean = goc_diagnostics_get_count(program->diagnostics) == 0;
+  for (size_t index = 0; index < pool.s_chunks; index++) {
+    struct parser_chunk *chunk = &(chunks[index]);
+    clean = clean && chunk->reached == chunk->end && goc_diagnostics_get_count(chunk->parser.diagnostics) == 0;
+    goc_diagnostics_free(chunk->parser.diagnostics);
+    file->s_file_blocks += chunk->file.s_file_blocks;
+  }
+  if (!clean) {
+    for (size_t index = 0; index < pool.s_chunks; index++)
+      goc_arena_free(chunks[index].parser.arena);
+    free(chunks);
+    free(parser.scratch);
+    goc_parser_free(program);
+    return goc_parser(array);
+  }
+
+  // The chunks' stats already count the bytes of their own lists
+  if (file->s_file_blocks > 0) {
+    file->type_file_blocks = goc_arena_new_n(program->arena, AST_NodeType, file->s_file_blocks);
+    file->file_blocks = goc_arena_new_n(program->arena, union ast_node_file_block, file->s_file_blocks);
+    goc_error_assert(goc_error_mem_error, file->type_file_blocks != NULL && file->file_blocks != NULL);
+  }
+  for (size_t index = 0, s_blocks = 0; index < pool.s_chunks; index++) {
+    struct parser_chunk *chunk = &(chunks[index]);
+    if (chunk->file.s_file_blocks > 0) {
+      memcpy(&(file->type_file_blocks[s_blocks]), chunk->file.type_file_blocks, chunk->file.s_file_blocks * sizeof(AST_NodeType));
+      memcpy(&(file->file_blocks[s_blocks]), chunk->file.file_blocks, chunk->file.s_file_blocks * sizeof(union ast_node_file_block));
+    }
+    s_blocks += chunk->file.s_file_blocks;
+    for (AST_NodeType kind = ast_undefined; kind <= ast_node_program; kind++) {
+      program->stats.s_nodes[kind] += chunk->stats.s_nodes[kind];
+      program->stats.s_bytes[kind] += chunk->stats.s_bytes[kind];
+    }
+    program->stats.s_stmts += chunk->stats.s_stmts;
+    program->stats.s_lists += chunk->stats.s_lists;
+    program->stats.s_list_bytes += chunk->stats.s_list_bytes;
+    goc_arena_absorb(program->arena, chunk->parser.arena);
+  }
+  free(chunks);
+  goc_parser_program_finish(&parser, program, file);
+  return program;
+}
+
+AST_NodeStmtBlock goc_parser_func_block(AST_NodeProgram program, AST_NodeFunc func) {
+  goc_error_assert(goc_error_nullptr, program != NULL && func != NULL);
+  if (func->block != NULL)
+    return func->block;
+
+  struct parser_state parser = goc_parser_state_create(func->body.array, program->arena, &(program->stats), program->diagnostics);
+  goc_lexer_cursor_seek(&(parser.cursor), func->body.index);
+  func->block = goc_parser_parse_block(&parser);
+  free(parser.scratch);
+  return func->block;
+}
 
-  AST_NodeProgram program = (AST_NodeProgram)_goc_parser_ast_node_create(ast_node_program, 1);
+void goc_parser_expand(AST_NodeProgram program) {
   goc_error_assert(goc_error_nullptr, program != NULL);
 
-  TokenType tt_package = goc_lexer_token_get_type(goc_lexer_token_array_at(array, word_ptr)),
-            tt_ident   = goc_lexer_token_get_type(goc_lexer_token_array_at(array, word_ptr + 1));
-  bool tt_main = tt_ident == TT_IDENT ? 
-       (strcmp(goc_lexer_token_get_value_text(goc_lexer_token_array_at(array, word_ptr + 1)), KEYWORD_MAIN) == 0) : false;
-  if (tt_package != TT_PACKAGE || !tt_main) {
-    Token not_main = goc_lexer_token_array_at(array, word_ptr + 1);
-    goc_parser_print_error(goc_error_parser_print_package_main_not_found, not_main);
+  for (uint32_t package = 0; package < program->s_packages; package++) {
+    for (uint32_t f = 0; f < program->packages[package].s_files; f++) {
+      AST_NodeFile file = &(program->packages[package].files[f]);
+      for (uint32_t block = 0; block < file->s_file_blocks; block++) {
+        if (file->type_file_blocks[block] == ast_node_func)
+          goc_parser_func_block(program, file->file_blocks[block].func);
+        else if (file->type_file_blocks[block] == ast_node_method)
+          goc_parser_func_block(program, file->file_blocks[block].method->func);
+      }
+    }
   }
+}
 
-  goc_parser_parse_file(program, array, &word_ptr, true);
+Diagnostics goc_parser_get_diagnostics(AST_NodeProgram program) {
+  return program ? program->diagnostics : NULL;
+}
 
-  return program;
+void goc_parser_free(AST_NodeProgram program) {
+  if (program == NULL)
+    return;
+  // The program is in its own arena
+  goc_diagnostics_free(program->diagnostics);
+  goc_arena_free(program->arena);
+}
+
+void goc_parser_dump(FILE *out, AST_NodeProgram program) {
+  goc_error_assert(goc_error_nullptr, out != NULL && program != NULL);
+
+  for (uint32_t package = 0; package < program->s_packages; package++) {
+    _goc_parser_dump_line(out, 0, "package", program->packages[package].package);
+    for (uint32_t f = 0; f < program->packages[package].s_files; f++) {
+      AST_NodeFile file = &(program->packages[package].files[f]);
+      _goc_parser_dump_line(out, 1, "file", PARSER_NO_TOKEN);
+
+      for (uint32_t block = 0; block < file->s_file_blocks; block++) {
+        union ast_node_file_block node = file->file_blocks[block];
+        switch (file->type_file_blocks[block]) {
+          case ast_node_import:
+            _goc_parser_dump_line(out, 2, "import", PARSER_NO_TOKEN);
+            for (uint32_t import = 0; import < node.import->s_imports; import++)
+              _goc_parser_dump_line(out, 3, "path", node.import->imports[import]);
+            break;
+
+          case ast_node_enum:
+            _goc_parser_dump_line(out, 2, "enum", node.node_enum->token);
+            for (uint32_t value = 0; value < node.node_enum->s_values; value++) {
+              _goc_parser_dump_line(out, 3, "value", node.node_enum->values[value]);
+              _goc_parser_dump_expr(out, 4, node.node_enum->assign[value]);
+            }
+            break;
+
+          case ast_node_union:
+            _goc_parser_dump_line(out, 2, "union", node.node_union->token);
+            for (uint32_t field = 0; field < node.node_union->s_fields; field++)
+              _goc_parser_dump_var(out, 3, "field", &(node.node_union->fields[field]));
+            break;
+
+          case ast_node_struct:
+            _goc_parser_dump_line(out, 2, "struct", node.node_struct->token);
+            for (uint32_t field = 0; field < node.node_struct->s_fields; field++)
+              _goc_parser_dump_var(out, 3, "field", &(node.node_struct->fields[field]));
+            break;
+
+          case ast_node_interface:
+            _goc_parser_dump_line(out, 2, "interface", node.interface->token);
+            for (uint32_t method = 0; method < node.interface->s_methods; method++)
+              _goc_parser_dump_func_declare(out, 3, &(node.interface->methods[method]));
+            break;
+
+          case ast_node_var:
+            _goc_parser_dump_var(out, 2, node.var->constant ? "const" : "var", node.var);
+            break;
+
+          case ast_node_method:
+            _goc_parser_dump_line(out, 2, "method", PARSER_NO_TOKEN);
+            _goc_parser_dump_var(out, 3, "receiver", &(node.method->receiver));
+            _goc_parser_dump_func_declare(out, 3, node.method->func->declare);
+            _goc_parser_dump_block(out, 4, goc_parser_func_block(program, node.method->func));
+            break;
+
+          case ast_node_func:
+            _goc_parser_dump_func_declare(out, 2, node.func->declare);
+            _goc_parser_dump_block(out, 3, goc_parser_func_block(program, node.func));
+            break;
+
+          case ast_node_func_declare:
+            _goc_parser_dump_func_declare(out, 2, node.func_declare);
+            break;
+
+          case ast_node_error:
+            _goc_parser_dump_line(out, 2, "error", node.error->token);
+            break;
+
+          default:
+            goc_parser_check(false);
+        }
+      }
+    }
+  }
+}
+
+void goc_parser_print_stats(FILE *out, AST_NodeProgram program) {
+  goc_error_assert(goc_error_nullptr, out != NULL && program != NULL);
+
+  size_t s_nodes = 0;
+  for (AST_NodeType kind = ast_node_error; kind <= ast_node_program; kind++) {
+    if (program->stats.s_bytes[kind] == 0)
+      continue;
+    fprintf(out, "%-14s %10zu nodes %12zu bytes\n", goc_parser_node_names[kind], program->stats.s_nodes[kind], program->stats.s_bytes[kind]);
+    s_nodes += program->stats.s_nodes[kind];
+  }
+  if (program->stats.s_lists > 0)
+    fprintf(out, "%-14s %10zu lists %12zu bytes\n", "lists", program->stats.s_lists, program->stats.s_list_bytes);
+  fprintf(
+    out, "%-14s %10zu nodes %12zu bytes %12zu reserved\n",
+    "total", s_nodes, goc_arena_get_size(program->arena), goc_arena_get_reserved(program->arena)
+  );
 }
 
 // =======================================================# PRIVATE #==================================================================
 
-static void goc_parser_parse_file(AST_NodeProgram program, TokenArray array, size_t *word_ptr, bool main_file) {
-  
+// Parser over array from its first token
+static struct parser_state goc_parser_state_create(TokenArray array, Arena arena, ASTStats *stats, Diagnostics diagnostics) {
+  SourceId source = goc_source_loc_id(goc_lexer_inline_loc(goc_lexer_inline_at(array, 0)));
+  return (struct parser_state){
+    goc_lexer_cursor_create(array), goc_intern(KEYWORD_MAIN, strlen(KEYWORD_MAIN)),
+    goc_source_get_data(source), goc_source_loc(source, 0),
+    arena, stats, NULL, 0, 0,
+    false, NULL, 0, diagnostics, 0
+  };
 }
 
-static void _goc_parser_find_package_dependencies() {
-  return;
+static AST_NodeProgram goc_parser_sequential(TokenArray array, bool lazy) {
+  if (array == NULL)
+    return NULL;
+
+  struct parser_state parser;
+  AST_NodeProgram program = goc_parser_program_create(array, &parser, goc_lexer_inline_size(array) * PARSER_ARENA_BYTES_PER_TOKEN);
+  parser.lazy = lazy;
+  AST_NodeFile file = goc_parser_ast_new(&parser, ast_node_file);
+  *file = (struct ast_node_file){ array, 0, NULL, NULL };
+  goc_parser_parse_file(&parser, file, SIZE_MAX);
+  goc_parser_program_finish(&parser, program, file);
+  return program;
+}
+
+// Starts parsing array into a new program and its package, past `package main`, with an arena of first chunk s_arena
+static AST_NodeProgram goc_parser_program_create(TokenArray array, struct parser_state *parser, size_t s_arena) {
+  Arena arena = goc_arena_create(s_arena);
+  goc_error_assert(goc_error_mem_error, arena != NULL);
+  AST_NodeProgram program = goc_arena_new(arena, struct ast_node_program);
+  goc_error_assert(goc_error_mem_error, program != NULL);
+  *program = (struct ast_node_program){ 1, NULL, NULL, arena, { { 0 }, { 0 } }, goc_diagnostics_create() };
+  goc_error_assert(goc_error_mem_error, program->diagnostics != NULL);
+  program->stats.s_nodes[ast_node_program] = 1;
+  program->stats.s_bytes[ast_node_program] = sizeof(struct ast_node_program);
+
+  *parser = goc_parser_state_create(array, arena, &(program->stats), program->diagnostics);
+
+  bool has_package = goc_parser_accept(parser, TT_PACKAGE);
+  Token package = goc_lexer_cursor_token(&(parser->cursor));
+  if (!has_package || goc_parser_type(parser) != TT_IDENT || goc_lexer_inline_symbol(package) != parser->main)
+    goc_parser_error(parser, goc_error_parser_missing_token, GOC_ERROR_PARSER_PACKAGE_MAIN_NOT_FOUND, package);
+  if (has_package)
+    goc_parser_advance(parser);
+
+  program->packages = goc_parser_ast_new(parser, ast_node_package);
+  *(program->packages) = (struct ast_node_package){ package, 1, NULL };
+  return program;
+}
+
+// Makes file the package's and finds its main
+static void goc_parser_program_finish(struct parser_state *parser, AST_NodeProgram program, AST_NodeFile file) {
+  free(parser->scratch);
+  parser->scratch = NULL;
+
+  program->packages->files = file;
+  for (uint32_t block = 0; block < file->s_file_blocks && program->main == NULL; block++) {
+    if (file->type_file_blocks[block] != ast_node_func)
+      continue;
+    AST_NodeFunc func = file->file_blocks[block].func;
+    if (goc_lexer_inline_symbol(func->declare->func) == parser->main)
+      program->main = func;
+  }
+}
+
+// Cuts the top-level declarations from start into up to s_chunks runs of about as many tokens each, at declaration
+// keywords outside any braces or parentheses, and returns how many it made. Only invalid input can put such a
+// keyword inside a declaration, the chunk before it then parses past its end.
+static size_t goc_parser_parallel_split(TokenArray array, size_t start, struct parser_chunk *chunks, size_t s_chunks) {
+  size_t s_tokens = goc_lexer_inline_size(array),
+         share    = (s_tokens - start) / s_chunks,
+         chunk    = 0;
+  chunks[0].start = start;
+
+  TokenCursor cursor = goc_lexer_cursor_create(array);
+  goc_lexer_cursor_seek(&cursor, start);
+  for (int64_t depth = 0; chunk + 1 < s_chunks; goc_lexer_cursor_advance(&cursor)) {
+    TokenType type = goc_lexer_cursor_type(&cursor);
+    if (type == TT_EOF)
+      break;
+    if (type == TT_LBRACE || type == TT_LPAREN)
+      depth++;
+    else if (type == TT_RBRACE || type == TT_RPAREN)
+      depth--;
+    else if (depth == 0 && goc_parser_declarations[type] && cursor.index >= start + (chunk + 1) * share) {
+      chunks[chunk].end = cursor.index;
+      chunks[++chunk].start = cursor.index;
+    }
+  }
+  chunks[chunk].end = s_tokens - 1;
+  return chunk + 1;
+}
+
+static void goc_parser_parallel_run(struct parser_pool *pool, uint32_t s_threads) {
+  goc_error_check(goc_error_nullptr, pool != NULL);
+
+  size_t s_workers = s_threads < pool->s_chunks ? s_threads : pool->s_chunks;
+  pthread_t *threads = (pthread_t *)malloc(s_workers * sizeof(pthread_t));
+  goc_error_assert(goc_error_mem_error, threads != NULL);
+
+  // A thread that cannot be started just leaves its chunks to the others
+  size_t s_started = 0;
+  for (; s_started + 1 < s_workers && pthread_create(&(threads[s_started]), NULL, goc_parser_parallel_parse, pool) == 0; s_started++);
+  (void)goc_parser_parallel_parse(pool);
+  for (size_t thread = 0; thread < s_started; thread++)
+    pthread_join(threads[thread], NULL);
+  free(threads);
+}
+
+static void *goc_parser_parallel_parse(void *arg) {
+  struct parser_pool *pool = (struct parser_pool *)arg;
+
+  for (size_t index; (index = atomic_fetch_add(&(pool->next), 1)) < pool->s_chunks; ) {
+    struct parser_chunk *chunk = &(pool->chunks[index]);
+    Arena arena = goc_arena_create((chunk->end - chunk->start) * PARSER_ARENA_BYTES_PER_TOKEN);
+    Diagnostics diagnostics = goc_diagnostics_create();
+    goc_error_assert(goc_error_mem_error, arena != NULL && diagnostics != NULL);
+
+    chunk->file = (struct ast_node_file){ pool->array, 0, NULL, NULL };
+    chunk->parser = (struct parser_state){
+      goc_lexer_cursor_create(pool->array), pool->main, pool->source, pool->base,
+      arena, &(chunk->stats), NULL, 0, 0,
+      false, NULL, 0, diagnostics, 0
+    };
+    goc_lexer_cursor_seek(&(chunk->parser.cursor), chunk->start);
+    goc_parser_parse_file(&(chunk->parser), &(chunk->file), chunk->end);
+    chunk->reached = chunk->parser.cursor.index;
+    free(chunk->parser.scratch);
+    chunk->parser.scratch = NULL;
+  }
+  return NULL;
+}
+
+// The top-level declarations up to the token end (excluded) or TT_EOF. One that does not parse becomes an
+// ast_node_error, from its first token to the next declaration keyword.
+static void goc_parser_parse_file(struct parser_state *parser, AST_NodeFile file, size_t end) {
+  size_t start = parser->s_scratch;
+  uint32_t depth = parser->depth;
+  jmp_buf recover, *outer = parser->recover;
+  volatile size_t from = parser->cursor.index;
+  if (setjmp(recover) != 0) {
+    parser->depth = depth;
+    parser->s_scratch = start + file->s_file_blocks * sizeof(struct parser_file_block);
+    goc_parser_sync(parser, from, false);
+    AST_NodeError error = goc_parser_ast_new(parser, ast_node_error);
+    *error = (struct ast_node_error){ { parser->cursor.array, from }, (uint32_t)(parser->cursor.index - from) };
+    struct parser_file_block file_block = { ast_node_error, { .error = error } };
+    goc_parser_scratch_push(parser, file_block);
+    file->s_file_blocks++;
+  }
+  parser->recover = &recover;
+
+  for (TokenType type; (type = goc_parser_type(parser)) != TT_EOF && parser->cursor.index < end; ) {
+    if (type == TT_SEMICOLON) {
+      goc_parser_advance(parser);
+      continue;
+    }
+    from = parser->cursor.index;
+
+    AST_NodeType type_block = ast_undefined;
+    union ast_node_file_block block = { NULL };
+    switch (type) {
+      case TT_IMPORT:
+        type_block = ast_node_import;
+        block.import = goc_parser_parse_import(parser);
+        break;
+
+      case TT_ENUM:
+        type_block = ast_node_enum;
+        block.node_enum = goc_parser_parse_enum(parser);
+        break;
+
+      case TT_UNION:
+        type_block = ast_node_union;
+        block.node_union = goc_parser_parse_union(parser);
+        break;
+
+      case TT_STRUCT:
+        type_block = ast_node_struct;
+        block.node_struct = goc_parser_parse_struct(parser);
+        break;
+
+      case TT_INTERFACE:
+        type_block = ast_node_interface;
+        block.interface = goc_parser_parse_interface(parser);
+        break;
+
+      case TT_VAR: case TT_CONST:
+        type_block = ast_node_var;
+        block.var = goc_parser_ast_new(parser, ast_node_var);
+        goc_parser_parse_var(parser, block.var);
+        break;
+
+      // func name(...) {...}, func (receiver: T) name(...) {...} or a bodyless func name(...)
+      case TT_FUNC: {
+        goc_parser_advance(parser);
+        struct ast_node_var receiver;
+        bool method = goc_parser_accept(parser, TT_LPAREN);
+        if (method) {
+          goc_parser_parse_arg(parser, &receiver);
+          goc_parser_expect(parser, TT_RPAREN);
+        }
+
+        AST_NodeFuncDeclare declare = goc_parser_ast_new(parser, ast_node_func_declare);
+        goc_parser_parse_func_declare(parser, declare);
+        if (!method && goc_parser_type(parser) != TT_LBRACE) {
+          type_block = ast_node_func_declare;
+          block.func_declare = declare;
+          break;
+        }
+
+        AST_NodeFunc func = goc_parser_ast_new(parser, ast_node_func);
+        *func = (struct ast_node_func){ declare, NULL, goc_lexer_cursor_token(&(parser->cursor)) };
+        if (parser->lazy)
+          goc_parser_skip_block(parser);
+        else
+          func->block = goc_parser_parse_block(parser);
+        if (!method) {
+          type_block = ast_node_func;
+          block.func = func;
+          break;
+        }
+        type_block = ast_node_method;
+        block.method = goc_parser_ast_new(parser, ast_node_method);
+        *block.method = (struct ast_node_method){ receiver, func };
+        break;
+      }
+
+      default:
+        goc_parser_error(parser, goc_error_parser_syntax_error, GOC_ERROR_PARSER_UNEXPECTED_TOKEN, goc_lexer_cursor_token(&parser->cursor));
+    }
+
+    struct parser_file_block file_block = { type_block, block };
+    goc_parser_scratch_push(parser, file_block);
+    file->s_file_blocks++;
+  }
+  parser->recover = outer;
+
+  // Split into the file's two parallel lists
+  if (file->s_file_blocks == 0)
+    return;
+  file->type_file_blocks = (AST_NodeType *)_goc_parser_ast_list_create(
+    parser, file->s_file_blocks * sizeof(AST_NodeType), _Alignof(AST_NodeType)
+  );
+  file->file_blocks = (union ast_node_file_block *)_goc_parser_ast_list_create(
+    parser, file->s_file_blocks * sizeof(union ast_node_file_block), _Alignof(union ast_node_file_block)
+  );
+  for (uint32_t index = 0; index < file->s_file_blocks; index++) {
+    struct parser_file_block file_block;
+    memcpy(&file_block, parser->scratch + start + index * sizeof(file_block), sizeof(file_block));
+    file->type_file_blocks[index] = file_block.type;
+    file->file_blocks[index] = file_block.block;
+  }
+  parser->s_scratch = start;
 }
 
 // AST Node Objects
-static AST_NodeImport _goc_parser_ast_node_import_create(uint32_t s_imports, const char *imports);
-static AST_NodeEnum _goc_parser_ast_node_enum_create(
-  Token enum, bool iota, uint32_t s_values, uint32_t s_assign, TokenArray values, TokenArray assign
-);
-static AST_NodeUnion _goc_parser_ast_node_union_create(Token union, uint32_t s_types, AST_NodeTypeIdent types, TokenArray values);
-static AST_NodeStruct _goc_parser_ast_node_struct_create(Token struct, AST_NodeTypeIdent types, uint32_t s_types); 
-static AST_NodeMethod _goc_parser_ast_node_method_create(AST_NodeStruct struct, AST_NodeFunc func);
-static AST_NodeVar _goc_parser_ast_node_var_create(Token token, bool is_type_go, AST_NodeTypeIdent type_var, AST_NodeExpr value);
-static AST_NodeFunc _goc_parser_ast_node_func_create(
-  AST_NodeFuncDeclare declare, AST_NodeStmtBlock block, AST_NodeStmtReturn return
-);
-static AST_NodeFuncDeclare _goc_parser_ast_node_func_declare_create(
-  Token func, uint32_t s_args, uint32_t s_return, bool *is_type_go, AST_NodeVar args, AST_NodeTypeIdent type_return
-);
+
+// import "path" or import ( "path" ... )
+static AST_NodeImport goc_parser_parse_import(struct parser_state *parser) {
+  AST_NodeImport import = goc_parser_ast_new(parser, ast_node_import);
+  *import = (struct ast_node_import){ goc_parser_advance(parser), 0, NULL };
+
+  size_t start = parser->s_scratch;
+  bool group = goc_parser_accept(parser, TT_LPAREN);
+  while (!group || goc_parser_type(parser) != TT_RPAREN) {
+    Token path = goc_parser_expect(parser, TT_STRING_LIT);
+    goc_parser_scratch_push(parser, path);
+    import->s_imports++;
+    if (!group)
+      break;
+    goc_parser_separator(parser);
+  }
+  if (group)
+    goc_parser_advance(parser);
+  import->imports = goc_parser_ast_list_of(parser, Token, start, import->s_imports);
+  return import;
+}
+
+// enum Name { A [= expr], ... }
+static AST_NodeEnum goc_parser_parse_enum(struct parser_state *parser) {
+  goc_parser_advance(parser);
+  AST_NodeEnum node_enum = goc_parser_ast_new(parser, ast_node_enum);
+  *node_enum = (struct ast_node_enum){ goc_parser_expect(parser, TT_IDENT), 0, NULL, NULL };
+
+  size_t start = parser->s_scratch;
+  goc_parser_expect(parser, TT_LBRACE);
+  while (goc_parser_type(parser) != TT_RBRACE) {
+    struct parser_enum_value value = { goc_parser_expect(parser, TT_IDENT), NULL };
+    if (goc_parser_accept(parser, TT_ASSIGN))
+      value.assign = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+    goc_parser_scratch_push(parser, value);
+    node_enum->s_values++;
+    goc_parser_separator(parser);
+  }
+  goc_parser_advance(parser);
+
+  // Split into the enum's two parallel lists
+  if (node_enum->s_values == 0)
+    return node_enum;
+  node_enum->values = (Token *)_goc_parser_ast_list_create(parser, node_enum->s_values * sizeof(Token), _Alignof(Token));
+  node_enum->assign = (AST_NodeExpr *)_goc_parser_ast_list_create(
+    parser, node_enum->s_values * sizeof(AST_NodeExpr), _Alignof(AST_NodeExpr)
+  );
+  for (uint32_t index = 0; index < node_enum->s_values; index++) {
+    struct parser_enum_value value;
+    memcpy(&value, parser->scratch + start + index * sizeof(value), sizeof(value));
+    node_enum->values[index] = value.value;
+    node_enum->assign[index] = value.assign;
+  }
+  parser->s_scratch = start;
+  return node_enum;
+}
+
+// union Name { var a: T, ... }
+static AST_NodeUnion goc_parser_parse_union(struct parser_state *parser) {
+  goc_parser_advance(parser);
+  AST_NodeUnion node_union = goc_parser_ast_new(parser, ast_node_union);
+  node_union->token = goc_parser_expect(parser, TT_IDENT);
+  node_union->fields = goc_parser_parse_fields(parser, &(node_union->s_fields));
+  return node_union;
+}
+
+// struct Name { var a: T, ... }
+static AST_NodeStruct goc_parser_parse_struct(struct parser_state *parser) {
+  goc_parser_advance(parser);
+  AST_NodeStruct node_struct = goc_parser_ast_new(parser, ast_node_struct);
+  node_struct->token = goc_parser_expect(parser, TT_IDENT);
+  node_struct->fields = goc_parser_parse_fields(parser, &(node_struct->s_fields));
+  return node_struct;
+}
+
+// interface Name { func name(...) [-> T], ... }
+static AST_NodeInterface goc_parser_parse_interface(struct parser_state *parser) {
+  goc_parser_advance(parser);
+  AST_NodeInterface interface = goc_parser_ast_new(parser, ast_node_interface);
+  *interface = (struct ast_node_interface){ goc_parser_expect(parser, TT_IDENT), 0, NULL };
+
+  size_t start = parser->s_scratch;
+  goc_parser_expect(parser, TT_LBRACE);
+  while (goc_parser_type(parser) != TT_RBRACE) {
+    goc_parser_expect(parser, TT_FUNC);
+    struct ast_node_func_declare method;
+    goc_parser_parse_func_declare(parser, &method);
+    goc_parser_scratch_push(parser, method);
+    interface->s_methods++;
+    goc_parser_separator(parser);
+  }
+  goc_parser_advance(parser);
+  interface->methods = goc_parser_ast_list(parser, ast_node_func_declare, start, interface->s_methods);
+  return interface;
+}
+
+// { [var] name: T, ... }, the fields may also be separated by ; or nothing
+static AST_NodeVar goc_parser_parse_fields(struct parser_state *parser, uint32_t *s_fields) {
+  size_t start = parser->s_scratch;
+  *s_fields = 0;
+
+  goc_parser_expect(parser, TT_LBRACE);
+  while (goc_parser_type(parser) != TT_RBRACE) {
+    goc_parser_accept(parser, TT_VAR);
+    struct ast_node_var field;
+    goc_parser_parse_arg(parser, &field);
+    goc_parser_scratch_push(parser, field);
+    (*s_fields)++;
+    goc_parser_separator(parser);
+  }
+  goc_parser_advance(parser);
+  return goc_parser_ast_list(parser, ast_node_var, start, *s_fields);
+}
+
+// var name[: T][= expr], or const, with at least the type or the value
+static void goc_parser_parse_var(struct parser_state *parser, AST_NodeVar var) {
+  bool constant = goc_parser_type(parser) == TT_CONST;
+  goc_parser_advance(parser);
+
+  Token token = goc_parser_expect(parser, TT_IDENT);
+  AST_NodeTypeIdent type_var = goc_parser_accept(parser, TT_COLON) ? goc_parser_parse_type(parser) : NULL;
+  if (type_var == NULL && goc_parser_type(parser) != TT_ASSIGN)
+    goc_parser_error_expected(parser, goc_lexer_cursor_token(&parser->cursor), PARSER_EXPECTED_TYPE);
+  AST_NodeExpr value = goc_parser_accept(parser, TT_ASSIGN) ? goc_parser_parse_expr(parser, PARSER_POWER_NONE) : NULL;
+  *var = (struct ast_node_var){ token, constant, type_var, value };
+}
+
+// name: T
+static void goc_parser_parse_arg(struct parser_state *parser, AST_NodeVar arg) {
+  Token token = goc_parser_expect(parser, TT_IDENT);
+  goc_parser_expect(parser, TT_COLON);
+  *arg = (struct ast_node_var){ token, false, goc_parser_parse_type(parser), NULL };
+}
+
+// name(arg: T, ...) [-> T | -> (T, ...)], after the func keyword and receiver
+static void goc_parser_parse_func_declare(struct parser_state *parser, AST_NodeFuncDeclare declare) {
+  *declare = (struct ast_node_func_declare){ goc_parser_expect(parser, TT_IDENT), 0, 0, NULL, NULL };
+
+  size_t start = parser->s_scratch;
+  goc_parser_expect(parser, TT_LPAREN);
+  while (goc_parser_type(parser) != TT_RPAREN) {
+    if (declare->s_args > 0)
+      goc_parser_expect(parser, TT_COMMA);
+    struct ast_node_var arg;
+    goc_parser_parse_arg(parser, &arg);
+    goc_parser_scratch_push(parser, arg);
+    declare->s_args++;
+  }
+  goc_parser_advance(parser);
+  declare->args = goc_parser_ast_list(parser, ast_node_var, start, declare->s_args);
+
+  if (!goc_parser_accept(parser, TT_ARROW))
+    return;
+  bool group = goc_parser_accept(parser, TT_LPAREN);
+  while (!group || goc_parser_type(parser) != TT_RPAREN) {
+    if (group && declare->s_return > 0)
+      goc_parser_expect(parser, TT_COMMA);
+    struct ast_node_type_ident type;
+    goc_parser_parse_type_into(parser, &type);
+    goc_parser_scratch_push(parser, type);
+    declare->s_return++;
+    if (!group)
+      break;
+  }
+  if (group)
+    goc_parser_advance(parser);
+  declare->type_return = goc_parser_ast_list(parser, ast_node_type_ident, start, declare->s_return);
+}
+
+static AST_NodeTypeIdent goc_parser_parse_type(struct parser_state *parser) {
+  AST_NodeTypeIdent type = goc_parser_ast_new(parser, ast_node_type_ident);
+  goc_parser_parse_type_into(parser, type);
+  return type;
+}
+
+// *T, []T, a builtin type keyword or a named type
+static void goc_parser_parse_type_into(struct parser_state *parser, AST_NodeTypeIdent type) {
+  Token token = goc_lexer_cursor_token(&parser->cursor);
+  TokenType type_token = goc_parser_type(parser);
+  if (type_token == TT_STAR || type_token == TT_LSQPAREN) {
+    goc_parser_enter(parser, token);
+    goc_parser_advance(parser);
+    if (type_token == TT_LSQPAREN)
+      goc_parser_expect(parser, TT_RSQPAREN);
+    *type = (struct ast_node_type_ident){ type_token == TT_STAR ? TG_POINTER : TG_SLICE, token, goc_parser_parse_type(parser) };
+    parser->depth--;
+    return;
+  }
+
+  if (type_token != TT_IDENT && goc_parser_types_go[type_token] == TG_UNKNOW)
+    goc_parser_error_expected(parser, token, PARSER_EXPECTED_TYPE);
+  goc_parser_advance(parser);
+  *type = (struct ast_node_type_ident){ goc_parser_types_go[type_token], token, NULL };
+}
 
 // AST Node Statements
-static AST_NodeStmtBlock _goc_parser_ast_node_stmt_block_create(AST_NodeType *type_stmts, void *stmts, uint64_t s_stmts);
-static AST_NodeStmt _goc_parser_ast_node_stmt_create(AST_NodeType type_stmt, void *stmt);
-static AST_NodeStmtFor _goc_parser_ast_node_stmt_loop_for_create(
-  uint32_t s_init, uint64_t s_update, AST_NodeVar init, AST_NodeExpr condition, AST_NodeStmtAssign update, AST_NodeStmtBlock block
-);
-static AST_NodeStmtWhile _goc_parser_ast_node_stmt_loop_while_create(
-  bool loop_while, struct ast_node_expr *condition, struct ast_node_stmt_block *block
-);
-static AST_NodeStmtIf _goc_parser_ast_node_stmt_if_create(
-  bool has_else, uint32_t s_elseif, AST_NodeType type_init, union ast_node_init *init, struct ast_node_expr *condition,
-  struct ast_node_stmt_block *if_block, struct ast_node_stmt_if *elseif, struct ast_node_stmt_block *else_block
-);
-static AST_NodeStmtReturn _goc_parser_ast_node_stmt_return_create(AST_NodeType type_stmt, void *return);
-static AST_NodeStmtAssign _goc_parser_ast_node_stmt_assign_create(struct ast_node_var *var, struct ast_node_stmt_expr *assign);
+
+// A statement that does not parse becomes an ast_node_error, from its first token to where the block resumes. A
+// block nested too deep is an error at its '{', for the enclosing block to skip it whole.
+static AST_NodeStmtBlock goc_parser_parse_block(struct parser_state *parser) {
+  goc_parser_enter(parser, goc_lexer_cursor_token(&parser->cursor));
+  AST_NodeStmtBlock block = goc_parser_ast_new(parser, ast_node_stmt_block);
+  *block = (struct ast_node_stmt_block){ goc_parser_expect(parser, TT_LBRACE), 0, NULL };
+
+  size_t start = parser->s_scratch;
+  uint32_t depth = parser->depth;
+  jmp_buf recover, *outer = parser->recover;
+  volatile size_t from = parser->cursor.index;
+  if (setjmp(recover) != 0) {
+    parser->depth = depth;
+    parser->s_scratch = start + block->s_stmts * sizeof(struct ast_node_stmt);
+    goc_parser_sync(parser, from, true);
+    struct ast_node_stmt stmt = { ast_node_error, { .error = { { parser->cursor.array, from }, (uint32_t)(parser->cursor.index - from) } } };
+    goc_parser_scratch_push(parser, stmt);
+    _goc_parser_ast_stmt_count(parser, &stmt);
+    block->s_stmts++;
+  }
+  parser->recover = &recover;
+
+  for (TokenType type; (type = goc_parser_type(parser)) != TT_RBRACE && type != TT_EOF && !goc_parser_block_missing_end(type); ) {
+    if (type == TT_SEMICOLON) {
+      goc_parser_advance(parser);
+      continue;
+    }
+    from = parser->cursor.index;
+    struct ast_node_stmt stmt;
+    goc_parser_parse_stmt(parser, &stmt);
+    goc_parser_scratch_push(parser, stmt);
+    _goc_parser_ast_stmt_count(parser, &stmt);
+    block->s_stmts++;
+  }
+  parser->recover = outer;
+  goc_parser_expect(parser, TT_RBRACE);
+  block->stmts = goc_parser_ast_list(parser, ast_node_stmt, start, block->s_stmts);
+  parser->depth--;
+  return block;
+}
+
+// Past the '}' matching the current '{', an unclosed block is reported where goc_parser_parse_block would
+static void goc_parser_skip_block(struct parser_state *parser) {
+  goc_parser_expect(parser, TT_LBRACE);
+  for (int64_t depth = 1; depth > 0; goc_parser_advance(parser)) {
+    int8_t skip = goc_parser_skip[goc_parser_type(parser)];
+    if (skip == PARSER_SKIP_END)
+      goc_parser_expect(parser, TT_RBRACE);
+    depth += skip;
+  }
+}
+
+static void goc_parser_parse_stmt(struct parser_state *parser, AST_NodeStmt stmt) {
+  switch (goc_parser_type(parser)) {
+    case TT_VAR: case TT_CONST:
+      stmt->type_stmt = ast_node_var;
+      goc_parser_parse_var(parser, &(stmt->stmt.var));
+      return;
+
+    // return expr, ..., a bare return is followed by the end of its line, block or statement
+    case TT_RETURN: {
+      struct ast_node_stmt_return stmt_return = { goc_parser_advance(parser), 0, NULL };
+      TokenType type = goc_parser_type(parser);
+      bool bare = type == TT_RBRACE || type == TT_SEMICOLON || type == TT_EOF || goc_parser_newline(parser);
+      size_t start = parser->s_scratch;
+      while (!bare) {
+        AST_NodeExpr expr = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+        goc_parser_scratch_push(parser, expr);
+        stmt_return.s_exprs++;
+        bare = !goc_parser_accept(parser, TT_COMMA);
+      }
+      stmt_return.exprs = goc_parser_ast_list_of(parser, AST_NodeExpr, start, stmt_return.s_exprs);
+      stmt->type_stmt = ast_node_stmt_return;
+      stmt->stmt.stmt_return = stmt_return;
+      return;
+    }
+
+    case TT_IF:
+      stmt->type_stmt = ast_node_stmt_if;
+      stmt->stmt.stmt_if = goc_parser_parse_stmt_if(parser);
+      return;
+
+    case TT_FOR:
+      stmt->type_stmt = ast_node_stmt_for;
+      goc_parser_parse_stmt_for(parser, &(stmt->stmt.stmt_for));
+      return;
+
+    case TT_WHILE: {
+      Token token = goc_parser_advance(parser);
+      AST_NodeExpr condition = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+      stmt->type_stmt = ast_node_stmt_while;
+      stmt->stmt.stmt_while = (struct ast_node_stmt_while){ token, false, condition, goc_parser_parse_block(parser) };
+      return;
+    }
+
+    case TT_DO: {
+      Token token = goc_parser_advance(parser);
+      AST_NodeStmtBlock block = goc_parser_parse_block(parser);
+      goc_parser_expect(parser, TT_WHILE);
+      stmt->type_stmt = ast_node_stmt_while;
+      stmt->stmt.stmt_while = (struct ast_node_stmt_while){ token, true, goc_parser_parse_expr(parser, PARSER_POWER_NONE), block };
+      return;
+    }
+
+    case TT_LBRACE:
+      stmt->type_stmt = ast_node_stmt_block;
+      stmt->stmt.stmt_block = goc_parser_parse_block(parser);
+      return;
+
+    default:
+      goc_parser_parse_stmt_simple(parser, stmt);
+  }
+}
+
+// Expression, assignment, x := expr, x++ or x--. The expression is parsed first and becomes the target once the
+// operator that follows it is seen.
+static void goc_parser_parse_stmt_simple(struct parser_state *parser, AST_NodeStmt stmt) {
+  AST_NodeExpr expr = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+  TokenType type = goc_parser_type(parser);
+
+  if (type == TT_AUTO_ASSIGN) {
+    Token token = goc_parser_advance(parser);
+    if (expr->type_expr != ast_token)
+      goc_parser_error(parser, goc_error_parser_invalid_assignment, GOC_ERROR_PARSER_INVALID_ASSIGN_TARGET, token);
+    // The name's node is left unused in the arena
+    Token name = expr->expr.token;
+    stmt->type_stmt = ast_node_var;
+    stmt->stmt.var = (struct ast_node_var){ name, false, NULL, goc_parser_parse_expr(parser, PARSER_POWER_NONE) };
+    return;
+  }
+
+  if (type == TT_UNOP_INCR || type == TT_UNOP_DECR) {
+    Token token = goc_parser_advance(parser);
+    if (!goc_parser_assignable(expr))
+      goc_parser_error(parser, goc_error_parser_invalid_assignment, GOC_ERROR_PARSER_INVALID_ASSIGN_TARGET, token);
+    AST_NodeExpr unary = _goc_parser_ast_expr_create(parser, ast_node_expr_unary);
+    unary->expr.expr_unary = (struct ast_node_expr_unary){ type == TT_UNOP_INCR ? UNOP_INCR : UNOP_DECR, token, expr };
+    stmt->type_stmt = ast_node_stmt_expr;
+    stmt->stmt.expr = unary;
+    return;
+  }
+
+  AST_OperatorBin assign_operator = goc_parser_assign_ops[type];
+  if (assign_operator != BINOP_UNDEFINED) {
+    Token token = goc_parser_advance(parser);
+    if (!goc_parser_assignable(expr))
+      goc_parser_error(parser, goc_error_parser_invalid_assignment, GOC_ERROR_PARSER_INVALID_ASSIGN_TARGET, token);
+    stmt->type_stmt = ast_node_stmt_assign;
+    stmt->stmt.stmt_assign = (struct ast_node_stmt_assign){
+      assign_operator, token, expr, goc_parser_parse_expr(parser, PARSER_POWER_NONE)
+    };
+    return;
+  }
+
+  stmt->type_stmt = ast_node_stmt_expr;
+  stmt->stmt.expr = expr;
+}
+
+// if [init;] condition {...} [else if ... | else {...}], the else ifs of a chain are parsed in a loop, each linked
+// to the previous one's elseif
+static AST_NodeStmtIf goc_parser_parse_stmt_if(struct parser_state *parser) {
+  AST_NodeStmtIf first = NULL, *link = &first;
+  for (;;) {
+    AST_NodeStmtIf stmt_if = goc_parser_ast_new(parser, ast_node_stmt_if);
+    *stmt_if = (struct ast_node_stmt_if){ goc_parser_advance(parser), NULL, NULL, NULL, NULL, NULL };
+    *link = stmt_if;
+
+    struct ast_node_stmt simple;
+    goc_parser_parse_stmt_simple(parser, &simple);
+    if (goc_parser_accept(parser, TT_SEMICOLON)) {
+      stmt_if->init = _goc_parser_ast_stmt_new(parser, &simple);
+      stmt_if->condition = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+    } else if (simple.type_stmt == ast_node_stmt_expr)
+      stmt_if->condition = simple.stmt.expr;
+    else
+      goc_parser_error_expected(parser, goc_lexer_cursor_token(&parser->cursor), goc_parser_token_text[TT_SEMICOLON]);
+    stmt_if->if_block = goc_parser_parse_block(parser);
+
+    if (!goc_parser_accept(parser, TT_ELSE))
+      return first;
+    if (goc_parser_type(parser) != TT_IF) {
+      stmt_if->else_block = goc_parser_parse_block(parser);
+      return first;
+    }
+    link = &(stmt_if->elseif);
+  }
+}
+
+static void goc_parser_parse_stmt_for(struct parser_state *parser, AST_NodeStmtFor stmt_for) {
+  *stmt_for = (struct ast_node_stmt_for){ goc_parser_advance(parser) };
+
+  if (goc_parser_for_range(parser)) {
+    if (goc_parser_iterator(goc_parser_type(parser))) {
+      stmt_for->iterators[stmt_for->s_iterators++] = goc_parser_advance(parser);
+      if (goc_parser_accept(parser, TT_COMMA))
+        stmt_for->iterators[stmt_for->s_iterators++] = goc_parser_advance(parser);
+    }
+    stmt_for->declare = goc_parser_accept(parser, TT_AUTO_ASSIGN);
+    goc_parser_expect(parser, TT_RANGE);
+    stmt_for->range = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+  } else if (goc_parser_type(parser) != TT_LBRACE) {
+    struct ast_node_stmt init = { ast_undefined };
+    if (goc_parser_type(parser) != TT_SEMICOLON)
+      goc_parser_parse_stmt_simple(parser, &init);
+
+    if (goc_parser_accept(parser, TT_SEMICOLON)) {
+      if (init.type_stmt != ast_undefined)
+        stmt_for->init = _goc_parser_ast_stmt_new(parser, &init);
+      if (goc_parser_type(parser) != TT_SEMICOLON)
+        stmt_for->condition = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+      goc_parser_expect(parser, TT_SEMICOLON);
+      if (goc_parser_type(parser) != TT_LBRACE) {
+        struct ast_node_stmt update;
+        goc_parser_parse_stmt_simple(parser, &update);
+        stmt_for->update = _goc_parser_ast_stmt_new(parser, &update);
+      }
+    } else if (init.type_stmt == ast_node_stmt_expr)
+      stmt_for->condition = init.stmt.expr;
+    else
+      goc_parser_error_expected(parser, goc_lexer_cursor_token(&parser->cursor), goc_parser_token_text[TT_SEMICOLON]);
+  }
+  stmt_for->block = goc_parser_parse_block(parser);
+}
+
+// Whether the for clause is [key[, value] [:=]] range, told from at most four tokens of lookahead
+static bool goc_parser_for_range(const struct parser_state *parser) {
+  size_t k = 0;
+  if (goc_parser_iterator(goc_lexer_cursor_peek(&parser->cursor, 0))) {
+    k = 1;
+    if (goc_lexer_cursor_peek(&parser->cursor, 1) == TT_COMMA && goc_parser_iterator(goc_lexer_cursor_peek(&parser->cursor, 2)))
+      k = 3;
+    if (goc_lexer_cursor_peek(&parser->cursor, k) == TT_AUTO_ASSIGN)
+      k++;
+  }
+  return goc_lexer_cursor_peek(&parser->cursor, k) == TT_RANGE;
+}
+
+static bool goc_parser_iterator(TokenType type) {
+  return type == TT_IDENT || type == TT_NULL_ITERATOR;
+}
 
 // AST Node Expression
-static AST_NodeExpr _goc_parser_ast_node_expr_create(AST_NodeType type_node, void *expr);
-static AST_NodeExprBin _goc_parser_ast_node_expr_bin_create(
-  AST_NodeType type_expr_left, AST_NodeType type_expr_right, Token bin_op, void *expr_left, void *expr_right
-);
-static AST_NodeExprUnary _goc_parser_ast_node_expr_unary_create(AST_NodeType type_expr, Token unary_op, void *operand);
-static AST_NodeExprMember _goc_parser_ast_node_expr_member_create(AST_NodeType type_ds, uint64_t offset, void *data_structure);
-
-// AST Node Literal
-static AST_NodeLiteral _goc_parser_ast_node_literal(TypeGo type_go, void *literal) {
-  goc_error_assert(nullptr, literal != NULL);
-  AST_NodeLiteral literal = (AST_NodeLiteral)_goc_parser_ast_node_create(ast_node_literal, 1);
-  literal->type_go = type_go;
-  switch (type_go) {
-    case TG_BOOL:
-      literal->val_bool  = *literal;
-
-    case TG_INT8:
-      literal->val_int8  = *literal;
-    case TG_INT16:
-      literal->val_int16 = *literal;
-    case TG_INT32: case TG_INT:
-      literal->val_int32 = *literal;
-    case TG_INT64:
-      literal->val_int64 = *literal;
-
-    case TG_UINT8:
-      literal->val_uint8  = *literal;
-    case TG_UINT16:
-      literal->val_uint16 = *literal;
-    case TG_UINT32: case TG_UINT:
-      literal->val_uint32 = *literal;
-    case TG_UINT64:
-      literal->val_uint64 = *literal;
-
-    case TG_FLOAT:
-      literal->val_float  = *literal;
-    case TG_DOUBLE:
-      literal->val_double = *literal;
-
-    case TG_CHAR:
-      literal->val_char   = *literal;
-    case TG_STRING:
-      literal->val_string = (char *)literal;
-  }
-}
-
-static void *_goc_parser_ast_node_create(AST_NodeType type, size_t s_nodes) {
-  return malloc(s_nodes * _goc_parser_ast_node_size(type));
-}
-
-static size_t _goc_parser_ast_node_size(AST_NodeType type) {
+
+// Precedence climbing: operands are unary expressions, a binary operator is taken while it binds tighter than
+// power, and its right operand parsed at its own power, which makes every level left associative. An operator
+// that starts a line begins the next statement (x++ then *p = 1), as after Go's automatic semicolons.
+static AST_NodeExpr goc_parser_parse_expr(struct parser_state *parser, uint8_t power) {
+  AST_NodeExpr left = goc_parser_parse_expr_unary(parser);
+
+  for (TokenType type; goc_parser_binops[(type = goc_parser_type(parser))].power > power && !goc_parser_newline(parser); ) {
+    Token token = goc_parser_advance(parser);
+    AST_NodeExpr right = goc_parser_parse_expr(parser, goc_parser_binops[type].power);
+    AST_NodeExpr bin = _goc_parser_ast_expr_create(parser, ast_node_expr_bin);
+    bin->expr.expr_bin = (struct ast_node_expr_bin){ goc_parser_binops[type].binop, token, left, right };
+    left = bin;
+  }
+  return left;
+}
+
+// Every operand is one level deeper, which bounds unary operators and parentheses nested in one another
+static AST_NodeExpr goc_parser_parse_expr_unary(struct parser_state *parser) {
+  goc_parser_enter(parser, goc_lexer_cursor_token(&parser->cursor));
+  AST_OperatorUnary unary_operator = goc_parser_unops[goc_parser_type(parser)];
+  AST_NodeExpr expr;
+  if (unary_operator == UNOP_UNDEFINED)
+    expr = goc_parser_parse_expr_primary(parser);
+  else {
+    Token token = goc_parser_advance(parser);
+    AST_NodeExpr operand = goc_parser_parse_expr_unary(parser);
+    expr = _goc_parser_ast_expr_create(parser, ast_node_expr_unary);
+    expr->expr.expr_unary = (struct ast_node_expr_unary){ unary_operator, token, operand };
+  }
+  parser->depth--;
+  return expr;
+}
+
+// Literal, identifier, _, iota, builtin type (a conversion once called) or parenthesized expression
+static AST_NodeExpr goc_parser_parse_expr_primary(struct parser_state *parser) {
+  Token token = goc_lexer_cursor_token(&parser->cursor);
+  TokenType type = goc_parser_type(parser);
+  if (type == TT_LPAREN) {
+    goc_parser_advance(parser);
+    AST_NodeExpr expr = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+    goc_parser_expect(parser, TT_RPAREN);
+    return goc_parser_parse_expr_postfix(parser, expr);
+  }
+
+  struct ast_node_literal literal = { TG_UNKNOW, token, { 0 } };
   switch (type) {
-    case ast_node_literal:         return sizeof(struct ast_node_literal);
-    case ast_node_result:          return sizeof(struct ast_node_result);
-
-    case ast_node_expr_member:     return sizeof(struct ast_node_expr_member);
-    case ast_node_expr_array:      return sizeof(struct ast_node_expr_array);
-    case ast_node_expr_call:       return sizeof(struct ast_node_expr_call);
-    case ast_node_expr_unary:      return sizeof(struct ast_node_expr_unary);
-    case ast_node_expr_bin:        return sizeof(struct ast_node_expr_bin);
-
-    case ast_node_stmt_expr:       return sizeof(struct ast_node_stmt_expr);
-    case ast_node_stmt_assign:     return sizeof(struct ast_node_stmt_assign);
-    case ast_node_stmt_return:     return sizeof(struct ast_node_stmt_return);
-    case ast_node_stmt_if:         return sizeof(struct ast_node_stmt_if);
-    case ast_node_stmt_loop_do:    return sizeof(struct ast_node_stmt_loop_do);
-    case ast_node_stmt_loop_while: return sizeof(struct ast_node_stmt_loop_while);
-    case ast_node_stmt_loop_for:   return sizeof(struct ast_node_stmt_loop_for);
-    case ast_node_stmt_block:      return sizeof(struct ast_node_stmt_block);
-
-    case ast_node_var_declare:     return sizeof(struct ast_node_var_declare);
-    case ast_node_func_declare:    return sizeof(struct ast_node_func_declare);
-    case ast_node_var:             return sizeof(struct ast_node_var);
-    case ast_node_func:            return sizeof(struct ast_node_func);
-    case ast_node_method:          return sizeof(struct ast_node_method);
-    case ast_node_union:           return sizeof(struct ast_node_union);
-    case ast_node_enum:            return sizeof(struct ast_node_enum);
-    case ast_node_struct:          return sizeof(struct ast_node_struct);
-    case ast_node_interface:       return sizeof(struct ast_node_interface);
-
-    case ast_node_file:            return sizeof(struct ast_node_file);
-    case ast_node_package:         return sizeof(struct ast_node_package);
-    case ast_node_program:         return sizeof(struct ast_node_program);
-
-    default:                       return 0;
-  }
-}
-
-static void goc_parser_print_error(
-  void goc_error_func(FILE *file, uint32_t pos_abs, uint32_t pos_line, uint32_t pos_rel, uint32_t s_word),
-  Token token
-) {
-  goc_error_func(
-    file,
-    goc_lexer_token_get_pos_rel(not_main),
-    goc_lexer_token_get_pos_line(not_main),
-    goc_lexer_token_get_pos_abs(not_main),
-    goc_lexer_token_get_pos_s_word(not_main)
+    case TT_NUM_LIT:
+      literal.type_go = TG_INT64;
+      literal.literal.val_int64 = goc_lexer_inline_number_literal(token);
+      break;
+    case TT_REAL_LIT:
+      literal.type_go = TG_DOUBLE;
+      literal.literal.val_double = goc_lexer_inline_real_literal(token);
+      break;
+    case TT_STRING_LIT:
+      literal.type_go = TG_STRING;
+      literal.literal.val_string = goc_lexer_inline_symbol(token);
+      break;
+    case TT_CHAR_LIT:
+      literal.type_go = TG_CHAR;
+      break;
+    case TT_TRUE_LIT: case TT_FALSE_LIT:
+      literal.type_go = TG_BOOL;
+      literal.literal.val_bool = type == TT_TRUE_LIT;
+      break;
+    case TT_NIL:
+      literal.type_go = TG_POINTER;
+      break;
+    case TT_IDENT: case TT_NULL_ITERATOR: case TT_IOTA:
+      break;
+    default:
+      if (goc_parser_types_go[type] == TG_UNKNOW)
+        goc_parser_error_expected(parser, token, PARSER_EXPECTED_EXPR);
+  }
+  goc_parser_advance(parser);
+
+  AST_NodeExpr expr = _goc_parser_ast_expr_create(parser, literal.type_go == TG_UNKNOW ? ast_token : ast_node_literal);
+  if (literal.type_go == TG_UNKNOW)
+    expr->expr.token = token;
+  else
+    expr->expr.literal = literal;
+  return goc_parser_parse_expr_postfix(parser, expr);
+}
+
+// Calls, member accesses and indexing, chained left to right on the same line
+static AST_NodeExpr goc_parser_parse_expr_postfix(struct parser_state *parser, AST_NodeExpr expr) {
+  for (
+    TokenType type;
+    ((type = goc_parser_type(parser)) == TT_LPAREN || type == TT_PERIOD || type == TT_LSQPAREN) && !goc_parser_newline(parser);
+  ) {
+    Token token = goc_parser_advance(parser);
+    AST_NodeExpr postfix;
+
+    if (type == TT_PERIOD) {
+      postfix = _goc_parser_ast_expr_create(parser, ast_node_expr_member);
+      postfix->expr.expr_member = (struct ast_node_expr_member){ expr, goc_parser_expect(parser, TT_IDENT) };
+    } else if (type == TT_LSQPAREN) {
+      AST_NodeExpr index = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+      goc_parser_expect(parser, TT_RSQPAREN);
+      postfix = _goc_parser_ast_expr_create(parser, ast_node_expr_index);
+      postfix->expr.expr_index = (struct ast_node_expr_index){ token, expr, index };
+    } else {
+      struct ast_node_expr_call call = { token, expr, 0, NULL };
+      size_t start = parser->s_scratch;
+      while (goc_parser_type(parser) != TT_RPAREN) {
+        if (call.s_args > 0)
+          goc_parser_expect(parser, TT_COMMA);
+        AST_NodeExpr arg = goc_parser_parse_expr(parser, PARSER_POWER_NONE);
+        goc_parser_scratch_push(parser, arg);
+        call.s_args++;
+      }
+      goc_parser_advance(parser);
+      call.args = goc_parser_ast_list_of(parser, AST_NodeExpr, start, call.s_args);
+      postfix = _goc_parser_ast_expr_create(parser, ast_node_expr_call);
+      postfix->expr.expr_call = call;
+    }
+    expr = postfix;
+  }
+  return expr;
+}
+
+static bool goc_parser_assignable(AST_NodeExpr expr) {
+  switch (expr->type_expr) {
+    case ast_token:
+    case ast_node_expr_member:
+    case ast_node_expr_index:
+      return true;
+    case ast_node_expr_unary:
+      return expr->expr.expr_unary.unary_operator == UNOP_DEREF;
+    default:
+      return false;
+  }
+}
+
+// Token stream
+
+static inline TokenType goc_parser_type(const struct parser_state *parser) {
+  return goc_lexer_cursor_type(&(parser->cursor));
+}
+
+static inline Token goc_parser_advance(struct parser_state *parser) {
+  return goc_lexer_cursor_advance(&(parser->cursor));
+}
+
+static inline bool goc_parser_accept(struct parser_state *parser, TokenType type) {
+  return goc_lexer_cursor_expect(&(parser->cursor), type, NULL);
+}
+
+// Optional , or ; between the items of a list
+static inline void goc_parser_separator(struct parser_state *parser) {
+  if (!goc_parser_accept(parser, TT_COMMA))
+    goc_parser_accept(parser, TT_SEMICOLON);
+}
+
+// A declaration keyword other than var and const, which can only be in a block whose '}' is missing
+static inline bool goc_parser_block_missing_end(TokenType type) {
+  return goc_parser_declarations[type] && type != TT_VAR && type != TT_CONST;
+}
+
+// Whether a newline (or a comment spanning one) separates the current token from the previous one
+static bool goc_parser_newline(const struct parser_state *parser) {
+  size_t index = parser->cursor.index;
+  if (index == 0)
+    return false;
+  Token previous = goc_lexer_inline_at(parser->cursor.array, index - 1);
+  size_t start = goc_lexer_inline_loc(previous) - parser->base + goc_lexer_inline_s_word(previous),
+         end   = goc_lexer_inline_loc(goc_lexer_cursor_token(&(parser->cursor))) - parser->base;
+  return end > start && memchr(parser->source + start, '\n', end - start) != NULL;
+}
+
+static Token goc_parser_expect(struct parser_state *parser, TokenType type) {
+  Token token = goc_lexer_cursor_token(&(parser->cursor));
+  if (!goc_lexer_cursor_expect(&(parser->cursor), type, NULL)) {
+    const char *expected = goc_parser_token_text[type];
+    goc_parser_error_expected(parser, token, expected != NULL ? expected : goc_lexer_token_type_to_str(type));
+  }
+  return token;
+}
+
+static void goc_parser_error_expected(struct parser_state *parser, Token token, const char *expected) {
+  if (goc_lexer_inline_type(token) == TT_EOF) {
+    goc_parser_error(parser, goc_error_parser_unexpected_end_of_input, GOC_ERROR_PARSER_END_OF_INPUT, token);
+    return;
+  }
+  // Diagnostics keep the message, it lives as long as the AST
+  char message[128];
+  int s_message = snprintf(message, sizeof(message), GOC_ERROR_PARSER_EXPECTED, expected);
+  size_t s_copy = s_message < 0 ? 0 : (size_t)s_message < sizeof(message) ? (size_t)s_message : sizeof(message) - 1;
+  goc_parser_error(parser, goc_error_parser_missing_token, goc_arena_strndup(parser->arena, message, s_copy), token);
+}
+
+// One more level of nesting at token, an error past PARSER_DEPTH_MAX. The caller leaves it with parser->depth--.
+static inline void goc_parser_enter(struct parser_state *parser, Token token) {
+  if (++parser->depth > PARSER_DEPTH_MAX)
+    goc_parser_error(parser, goc_error_parser_syntax_error, GOC_ERROR_PARSER_TOO_DEEP, token);
+}
+
+// Adds the error at token, unless one was already on its line, then jumps to the innermost recovery point (returns
+// outside of any). The tenth error ends the parse: the cursor is moved to TT_EOF, where every level stops.
+static void goc_parser_error(struct parser_state *parser, GOC_Error error, const char *message, Token token) {
+  goc_error_check(goc_error_nullptr, message != NULL);
+  SourceLoc loc = goc_lexer_token_get_loc(token);
+  SourceId source = goc_source_loc_id(loc);
+  size_t line = goc_source_loc_line(loc);
+  if (line != parser->error_line && goc_diagnostics_get_count(parser->diagnostics) < PARSER_ERRORS_MAX) {
+    size_t s_text;
+    const char *text = goc_source_line_text(source, line, &s_text);
+    uint32_t pos_abs = (uint32_t)goc_source_loc_offset(loc) + 1,
+             pos_rel = (uint32_t)goc_source_loc_rel(loc),
+             s_word  = (uint32_t)goc_lexer_token_get_pos_s_word(token);
+    const char *name = goc_source_get_name(source);
+    goc_diagnostics_add(parser->diagnostics, error, message, name, text, s_text, pos_abs, (uint32_t)line, pos_rel, s_word);
+    if (goc_diagnostics_get_count(parser->diagnostics) == PARSER_ERRORS_MAX)
+      goc_diagnostics_add(
+        parser->diagnostics, goc_error_parser_syntax_error, GOC_ERROR_PARSER_TOO_MANY_ERRORS, name, text, s_text,
+        pos_abs, (uint32_t)line, pos_rel, s_word
+      );
+    parser->error_line = line;
+  }
+  if (goc_diagnostics_get_count(parser->diagnostics) >= PARSER_ERRORS_MAX)
+    goc_lexer_cursor_seek(&(parser->cursor), goc_lexer_inline_size(parser->cursor.array) - 1);
+  if (parser->recover != NULL)
+    longjmp(*(parser->recover), 1);
+}
+
+// Skips to where the statement (block) or declaration begun at from can be resumed after: past a ';', before the
+// '}' closing the block, or before a token that starts a new one (a keyword of goc_parser_sync_stmt or the first
+// of a line, a declaration keyword) once past from. Braces and parentheses opened on the way are skipped whole.
+static void goc_parser_sync(struct parser_state *parser, size_t from, bool block) {
+  for (int64_t depth = 0; ; goc_parser_advance(parser)) {
+    TokenType type = goc_parser_type(parser);
+    if (type == TT_EOF)
+      return;
+    if (depth == 0) {
+      if (type == TT_SEMICOLON) {
+        goc_parser_advance(parser);
+        return;
+      }
+      if (block && type == TT_RBRACE)
+        return;
+      bool next = block ? goc_parser_sync_stmt[type] || goc_parser_newline(parser) : goc_parser_declarations[type];
+      if (parser->cursor.index > from && next)
+        return;
+    }
+    if (type == TT_LBRACE || type == TT_LPAREN)
+      depth++;
+    else if ((type == TT_RBRACE || type == TT_RPAREN) && depth > 0)
+      depth--;
+  }
+}
+
+// AST Node Memory Allocation
+
+static inline void *_goc_parser_ast_node_create(struct parser_state *parser, AST_NodeType kind, size_t size, size_t align, uint32_t s_nodes) {
+  void *node = goc_arena_alloc(parser->arena, size, align);
+  goc_error_assert(goc_error_mem_error, node != NULL);
+  parser->stats->s_nodes[kind] += s_nodes;
+  parser->stats->s_bytes[kind] += size;
+  return node;
+}
+
+// Expressions share struct ast_node_expr, they are counted under their own kind
+static inline AST_NodeExpr _goc_parser_ast_expr_create(struct parser_state *parser, AST_NodeType type_expr) {
+  AST_NodeExpr expr = (AST_NodeExpr)_goc_parser_ast_node_create(
+    parser, type_expr, sizeof(struct ast_node_expr), _Alignof(struct ast_node_expr), 1
   );
+  expr->type_expr = type_expr;
+  return expr;
+}
+
+// Lists that hold no nodes of their own: pointers, tokens or the parallel lists of a file or an enum
+static inline void *_goc_parser_ast_list_create(struct parser_state *parser, size_t size, size_t align) {
+  void *list = goc_arena_alloc(parser->arena, size, align);
+  goc_error_assert(goc_error_mem_error, list != NULL);
+  parser->stats->s_lists++;
+  parser->stats->s_list_bytes += size;
+  return list;
+}
+
+// Moves the s_items items pushed on the scratch stack since start into the arena, NULL for an empty list. Nodes
+// count under kind, pointers or tokens (ast_undefined) as a list, and the statements of a block (ast_node_stmt) were
+// already counted as they were pushed.
+static void *_goc_parser_ast_list(struct parser_state *parser, AST_NodeType kind, size_t start, uint32_t s_items, size_t s_item, size_t align) {
+  goc_parser_check(start + s_items * s_item == parser->s_scratch);
+  parser->s_scratch = start;
+  if (s_items == 0)
+    return NULL;
+  void *items;
+  if (kind == ast_undefined)
+    items = _goc_parser_ast_list_create(parser, s_items * s_item, align);
+  else if (kind == ast_node_stmt) {
+    items = goc_arena_alloc(parser->arena, s_items * s_item, align);
+    goc_error_assert(goc_error_mem_error, items != NULL);
+  } else
+    items = _goc_parser_ast_node_create(parser, kind, s_items * s_item, align, s_items);
+  memcpy(items, parser->scratch + start, s_items * s_item);
+  return items;
+}
+
+// A statement is a node of its own type_stmt, except the slot of an if or a block that only adds its bytes to the
+// node it points to
+static inline void _goc_parser_ast_stmt_count(struct parser_state *parser, const struct ast_node_stmt *stmt) {
+  bool node = stmt->type_stmt != ast_node_stmt_if && stmt->type_stmt != ast_node_stmt_block;
+  parser->stats->s_nodes[stmt->type_stmt] += node;
+  parser->stats->s_bytes[stmt->type_stmt] += sizeof(struct ast_node_stmt);
+  parser->stats->s_stmts += node;
+}
+
+// A statement on its own, the init of an if or a for and the update of a for
+static AST_NodeStmt _goc_parser_ast_stmt_new(struct parser_state *parser, const struct ast_node_stmt *stmt) {
+  AST_NodeStmt node = goc_arena_new(parser->arena, struct ast_node_stmt);
+  goc_error_assert(goc_error_mem_error, node != NULL);
+  *node = *stmt;
+  _goc_parser_ast_stmt_count(parser, stmt);
+  return node;
+}
+
+static inline void _goc_parser_scratch_push(struct parser_state *parser, const void *item, size_t s_item) {
+  if (parser->s_scratch + s_item > parser->s_scratch_capacity)
+    _goc_parser_scratch_grow(parser, s_item);
+  memcpy(parser->scratch + parser->s_scratch, item, s_item);
+  parser->s_scratch += s_item;
 }
+
+// The stack is as deep as the deepest nesting of open lists, it is only grown a few times per parse
+static void _goc_parser_scratch_grow(struct parser_state *parser, size_t s_item) {
+  size_t capacity = parser->s_scratch_capacity ? 2 * parser->s_scratch_capacity : PARSER_SCRATCH_SIZE_INIT;
+  while (capacity < parser->s_scratch + s_item)
+    capacity *= 2;
+  parser->scratch = (uint8_t *)realloc(parser->scratch, capacity);
+  goc_error_assert(goc_error_mem_error, parser->scratch != NULL);
+  parser->s_scratch_capacity = capacity;
+}
+
+// AST dump
+
+static void _goc_parser_dump_line(FILE *out, uint32_t depth, const char *label, Token token) {
+  fprintf(out, "%*s%s", (int)(2 * depth), "", label);
+  if (token.array != NULL) {
+    TokenText text = goc_lexer_token_get_value_text(token);
+    fprintf(out, " %.*s", (int)text.s_text, text.text);
+  }
+  fputc('\n', out);
+}
+
+// label *[]T on one line
+static void _goc_parser_dump_type(FILE *out, uint32_t depth, const char *label, AST_NodeTypeIdent type) {
+  if (type == NULL)
+    return;
+  fprintf(out, "%*s%s ", (int)(2 * depth), "", label);
+  for (; type->elem != NULL; type = type->elem)
+    fputs(type->type_go == TG_POINTER ? "*" : "[]", out);
+  TokenText text = goc_lexer_token_get_value_text(type->token);
+  fprintf(out, "%.*s\n", (int)text.s_text, text.text);
+}
+
+static void _goc_parser_dump_var(FILE *out, uint32_t depth, const char *label, AST_NodeVar var) {
+  _goc_parser_dump_line(out, depth, label, var->token);
+  _goc_parser_dump_type(out, depth + 1, "type", var->type_var);
+  _goc_parser_dump_expr(out, depth + 1, var->value);
+}
+
+static void _goc_parser_dump_func_declare(FILE *out, uint32_t depth, AST_NodeFuncDeclare declare) {
+  _goc_parser_dump_line(out, depth, "func", declare->func);
+  for (uint32_t arg = 0; arg < declare->s_args; arg++)
+    _goc_parser_dump_var(out, depth + 1, "arg", &(declare->args[arg]));
+  for (uint32_t type = 0; type < declare->s_return; type++)
+    _goc_parser_dump_type(out, depth + 1, "return", &(declare->type_return[type]));
+}
+
+static void _goc_parser_dump_block(FILE *out, uint32_t depth, AST_NodeStmtBlock block) {
+  if (block == NULL)
+    return;
+  _goc_parser_dump_line(out, depth, "block", PARSER_NO_TOKEN);
+  for (uint32_t stmt = 0; stmt < block->s_stmts; stmt++)
+    _goc_parser_dump_stmt(out, depth + 1, &(block->stmts[stmt]));
+}
+
+static void _goc_parser_dump_stmt(FILE *out, uint32_t depth, AST_NodeStmt stmt) {
+  switch (stmt->type_stmt) {
+    case ast_node_stmt_expr:
+      _goc_parser_dump_expr(out, depth, stmt->stmt.expr);
+      break;
+
+    case ast_node_var:
+      _goc_parser_dump_var(out, depth, stmt->stmt.var.constant ? "const" : "var", &(stmt->stmt.var));
+      break;
+
+    case ast_node_stmt_assign:
+      _goc_parser_dump_line(out, depth, "assign", stmt->stmt.stmt_assign.token);
+      _goc_parser_dump_expr(out, depth + 1, stmt->stmt.stmt_assign.target);
+      _goc_parser_dump_expr(out, depth + 1, stmt->stmt.stmt_assign.expr);
+      break;
+
+    case ast_node_stmt_return:
+      _goc_parser_dump_line(out, depth, "return", PARSER_NO_TOKEN);
+      for (uint32_t expr = 0; expr < stmt->stmt.stmt_return.s_exprs; expr++)
+        _goc_parser_dump_expr(out, depth + 1, stmt->stmt.stmt_return.exprs[expr]);
+      break;
+
+    case ast_node_stmt_if:
+      _goc_parser_dump_stmt_if(out, depth, stmt->stmt.stmt_if);
+      break;
+
+    case ast_node_stmt_while:
+      _goc_parser_dump_line(out, depth, stmt->stmt.stmt_while.do_while ? "do while" : "while", PARSER_NO_TOKEN);
+      _goc_parser_dump_expr(out, depth + 1, stmt->stmt.stmt_while.condition);
+      _goc_parser_dump_block(out, depth + 1, stmt->stmt.stmt_while.block);
+      break;
+
+    case ast_node_stmt_for: {
+      AST_NodeStmtFor stmt_for = &(stmt->stmt.stmt_for);
+      _goc_parser_dump_line(out, depth, stmt_for->range != NULL ? "for range" : "for", PARSER_NO_TOKEN);
+      for (uint32_t iterator = 0; iterator < stmt_for->s_iterators; iterator++)
+        _goc_parser_dump_line(out, depth + 1, stmt_for->declare ? "declare" : "iterator", stmt_for->iterators[iterator]);
+      _goc_parser_dump_expr(out, depth + 1, stmt_for->range);
+      if (stmt_for->init != NULL) {
+        _goc_parser_dump_line(out, depth + 1, "init", PARSER_NO_TOKEN);
+        _goc_parser_dump_stmt(out, depth + 2, stmt_for->init);
+      }
+      _goc_parser_dump_expr(out, depth + 1, stmt_for->condition);
+      if (stmt_for->update != NULL) {
+        _goc_parser_dump_line(out, depth + 1, "update", PARSER_NO_TOKEN);
+        _goc_parser_dump_stmt(out, depth + 2, stmt_for->update);
+      }
+      _goc_parser_dump_block(out, depth + 1, stmt_for->block);
+      break;
+    }
+
+    case ast_node_stmt_block:
+      _goc_parser_dump_block(out, depth, stmt->stmt.stmt_block);
+      break;
+
+    case ast_node_error:
+      _goc_parser_dump_line(out, depth, "error", stmt->stmt.error.token);
+      break;
+
+    default:
+      goc_parser_check(false);
+  }
+}
+
+static void _goc_parser_dump_stmt_if(FILE *out, uint32_t depth, AST_NodeStmtIf stmt_if) {
+  for (const char *label = "if"; stmt_if != NULL; stmt_if = stmt_if->elseif, label = "else if") {
+    _goc_parser_dump_line(out, depth, label, PARSER_NO_TOKEN);
+    if (stmt_if->init != NULL) {
+      _goc_parser_dump_line(out, depth + 1, "init", PARSER_NO_TOKEN);
+      _goc_parser_dump_stmt(out, depth + 2, stmt_if->init);
+    }
+    _goc_parser_dump_expr(out, depth + 1, stmt_if->condition);
+    _goc_parser_dump_block(out, depth + 1, stmt_if->if_block);
+    if (stmt_if->else_block != NULL) {
+      _goc_parser_dump_line(out, depth, "else", PARSER_NO_TOKEN);
+      _goc_parser_dump_block(out, depth + 1, stmt_if->else_block);
+    }
+  }
+}
+
+static void _goc_parser_dump_expr(FILE *out, uint32_t depth, AST_NodeExpr expr) {
+  if (expr == NULL)
+    return;
+  switch (expr->type_expr) {
+    case ast_token:
+      _goc_parser_dump_line(out, depth, "ident", expr->expr.token);
+      break;
+    case ast_node_literal:
+      _goc_parser_dump_line(out, depth, "literal", expr->expr.literal.token);
+      break;
+    case ast_node_expr_member:
+      _goc_parser_dump_line(out, depth, "member", expr->expr.expr_member.member);
+      _goc_parser_dump_expr(out, depth + 1, expr->expr.expr_member.object);
+      break;
+    case ast_node_expr_index:
+      _goc_parser_dump_line(out, depth, "index", PARSER_NO_TOKEN);
+      _goc_parser_dump_expr(out, depth + 1, expr->expr.expr_index.object);
+      _goc_parser_dump_expr(out, depth + 1, expr->expr.expr_index.index);
+      break;
+    case ast_node_expr_call:
+      _goc_parser_dump_line(out, depth, "call", PARSER_NO_TOKEN);
+      _goc_parser_dump_expr(out, depth + 1, expr->expr.expr_call.callee);
+      for (uint32_t arg = 0; arg < expr->expr.expr_call.s_args; arg++)
+        _goc_parser_dump_expr(out, depth + 1, expr->expr.expr_call.args[arg]);
+      break;
+    case ast_node_expr_unary:
+      _goc_parser_dump_line(out, depth, "unary", expr->expr.expr_unary.token);
+      _goc_parser_dump_expr(out, depth + 1, expr->expr.expr_unary.operand);
+      break;
+    case ast_node_expr_bin:
+      _goc_parser_dump_line(out, depth, "binary", expr->expr.expr_bin.token);
+      _goc_parser_dump_expr(out, depth + 1, expr->expr.expr_bin.expr_left);
+      _goc_parser_dump_expr(out, depth + 1, expr->expr.expr_bin.expr_right);
+      break;
+    default:
+      goc_parser_check(false);
+  }
+}
+
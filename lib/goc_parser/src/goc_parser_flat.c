@@ -0,0 +1,740 @@
+#include <string.h>
+
+#include "goc_parser_flat.h"
+
+// Capacities of the arrays being filled, the AST_Flat only keeps their sizes
+struct parser_flat_builder {
+  AST_Flat flat;
+  uint32_t s_pools_capacity[AST_FLAT_POOLS],
+           s_extra_capacity,
+           s_literals_capacity;
+};
+
+static const uint32_t parser_flat_size_init = 64;
+
+#define goc_parser_flat_check(condition) goc_error_check(goc_error_parser_ast_undefined, condition)
+
+static AST_FlatIndex _goc_parser_flat_decl(struct parser_flat_builder *builder, AST_NodeType type, union ast_node_file_block block);
+static AST_FlatIndex _goc_parser_flat_func(struct parser_flat_builder *builder, AST_NodeFunc func);
+static AST_FlatIndex _goc_parser_flat_func_declare(struct parser_flat_builder *builder, AST_NodeFuncDeclare declare);
+static AST_FlatIndex _goc_parser_flat_var(struct parser_flat_builder *builder, AST_FlatPool pool, AST_NodeVar var);
+static AST_FlatIndex _goc_parser_flat_type(struct parser_flat_builder *builder, AST_NodeTypeIdent type);
+static AST_FlatIndex _goc_parser_flat_block(struct parser_flat_builder *builder, AST_NodeStmtBlock block);
+static AST_FlatIndex _goc_parser_flat_stmt(struct parser_flat_builder *builder, AST_NodeStmt stmt);
+static AST_FlatIndex _goc_parser_flat_stmt_if(struct parser_flat_builder *builder, AST_NodeStmtIf stmt_if);
+static AST_FlatIndex _goc_parser_flat_expr(struct parser_flat_builder *builder, AST_NodeExpr expr);
+static AST_FlatIndex _goc_parser_flat_literal(struct parser_flat_builder *builder, struct ast_node_literal literal);
+
+static AST_FlatIndex _goc_parser_flat_node(struct parser_flat_builder *builder, AST_FlatPool pool, AST_NodeType kind, uint8_t op, Token token);
+static void          _goc_parser_flat_set(struct parser_flat_builder *builder, AST_FlatPool pool, AST_FlatIndex index, AST_FlatIndex lhs, AST_FlatIndex rhs);
+static AST_FlatIndex _goc_parser_flat_extra(struct parser_flat_builder *builder, uint32_t s_slots);
+static AST_FlatIndex _goc_parser_flat_list(struct parser_flat_builder *builder, uint32_t s_items);
+static void         *_goc_parser_flat_grow(void *items, uint32_t *s_capacity, size_t s_item);
+static inline uint32_t _goc_parser_flat_token(Token token);
+
+static void _goc_parser_flat_dump_line(FILE *out, uint32_t depth, const char *label, AST_Flat flat, uint32_t token);
+static void _goc_parser_flat_dump_type(FILE *out, uint32_t depth, const char *label, AST_Flat flat, AST_FlatIndex type);
+static void _goc_parser_flat_dump_var(FILE *out, uint32_t depth, const char *label, AST_Flat flat, AST_FlatPool pool, AST_FlatIndex var);
+static void _goc_parser_flat_dump_func_declare(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex declare);
+static void _goc_parser_flat_dump_block(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex block);
+static void _goc_parser_flat_dump_stmt(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex stmt);
+static void _goc_parser_flat_dump_stmt_if(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex stmt_if);
+static void _goc_parser_flat_dump_expr(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex expr);
+
+// ==========================================================# PUBLIC #================================================================
+
+AST_Flat goc_parser_flatten(AST_NodeProgram program) {
+  if (program == NULL)
+    return NULL;
+  goc_parser_flat_check(program->s_packages == 1 && program->packages->s_files == 1);
+  goc_parser_expand(program);
+  AST_NodeFile file = program->packages->files;
+
+  AST_Flat flat = (AST_Flat)calloc(1, sizeof(struct ast_flat));
+  goc_error_assert(goc_error_mem_error, flat != NULL);
+  flat->tokens = file->tokens;
+  flat->package = _goc_parser_flat_token(program->packages->package);
+  flat->main = AST_FLAT_NONE;
+  struct parser_flat_builder builder = { flat, { 0 }, 0, 0 };
+
+  // The pools are sized from the node counts of the program's arena, as one allocation each. Every statement is a
+  // node of AST_FLAT_STMT, local vars and errors in a block included: those (s_stmts_decl) are taken off the vars
+  // and errors of AST_FLAT_DECL. A method is two nodes there, with its receiver.
+  const size_t *s_nodes = program->stats.s_nodes;
+  size_t s_stmts_decl = program->stats.s_stmts - (
+    s_nodes[ast_node_stmt_expr] + s_nodes[ast_node_stmt_assign] + s_nodes[ast_node_stmt_return]
+    + s_nodes[ast_node_stmt_while] + s_nodes[ast_node_stmt_for]
+  );
+  uint32_t s_hints[AST_FLAT_POOLS] = {
+    [AST_FLAT_EXPR] = (uint32_t)(
+      s_nodes[ast_token] + s_nodes[ast_node_literal] + s_nodes[ast_node_expr_member] + s_nodes[ast_node_expr_index]
+      + s_nodes[ast_node_expr_call] + s_nodes[ast_node_expr_unary] + s_nodes[ast_node_expr_bin]
+    ),
+    [AST_FLAT_STMT] = (uint32_t)(program->stats.s_stmts + s_nodes[ast_node_stmt_block] + s_nodes[ast_node_stmt_if]),
+    [AST_FLAT_TYPE] = (uint32_t)s_nodes[ast_node_type_ident],
+    [AST_FLAT_DECL] = (uint32_t)(
+      s_nodes[ast_node_var] + s_nodes[ast_node_error] - s_stmts_decl + s_nodes[ast_node_func_declare]
+      + s_nodes[ast_node_func] + 2 * s_nodes[ast_node_method] + s_nodes[ast_node_import] + s_nodes[ast_node_union]
+      + s_nodes[ast_node_enum] + s_nodes[ast_node_struct] + s_nodes[ast_node_interface]
+    ),
+  };
+  for (AST_FlatPool pool = AST_FLAT_EXPR; pool < AST_FLAT_POOLS; pool++) {
+    if (s_hints[pool] == 0)
+      continue;
+    flat->pools[pool] = (struct ast_flat_node *)malloc(s_hints[pool] * sizeof(struct ast_flat_node));
+    goc_error_assert(goc_error_mem_error, flat->pools[pool] != NULL);
+    builder.s_pools_capacity[pool] = s_hints[pool];
+  }
+
+  flat->file_blocks = _goc_parser_flat_list(&builder, file->s_file_blocks);
+  for (uint32_t block = 0; block < file->s_file_blocks; block++) {
+    AST_FlatIndex decl = _goc_parser_flat_decl(&builder, file->type_file_blocks[block], file->file_blocks[block]);
+    flat->extra[flat->file_blocks + 1 + block] = decl;
+    if (file->type_file_blocks[block] == ast_node_func && file->file_blocks[block].func == program->main)
+      flat->main = decl;
+  }
+  return flat;
+}
+
+void goc_parser_flat_free(AST_Flat flat) {
+  if (flat == NULL)
+    return;
+  for (AST_FlatPool pool = AST_FLAT_EXPR; pool < AST_FLAT_POOLS; pool++)
+    free(flat->pools[pool]);
+  free(flat->extra);
+  free(flat->literals);
+  free(flat);
+}
+
+size_t goc_parser_flat_get_size(AST_Flat flat) {
+  if (flat == NULL)
+    return 0;
+  size_t size = (size_t)flat->s_extra * sizeof(AST_FlatIndex) + (size_t)flat->s_literals * sizeof(union ast_flat_literal);
+  for (AST_FlatPool pool = AST_FLAT_EXPR; pool < AST_FLAT_POOLS; pool++)
+    size += (size_t)flat->s_pools[pool] * sizeof(struct ast_flat_node);
+  return size;
+}
+
+void goc_parser_flat_dump(FILE *out, AST_Flat flat) {
+  goc_error_assert(goc_error_nullptr, out != NULL && flat != NULL);
+
+  _goc_parser_flat_dump_line(out, 0, "package", flat, flat->package);
+  _goc_parser_flat_dump_line(out, 1, "file", flat, AST_FLAT_NONE);
+
+  uint32_t s_blocks;
+  const AST_FlatIndex *blocks = goc_parser_flat_list(flat, flat->file_blocks, &s_blocks);
+  for (uint32_t block = 0; block < s_blocks; block++) {
+    const struct ast_flat_node *node = goc_parser_flat_node(flat, AST_FLAT_DECL, blocks[block]);
+    uint32_t s_items;
+    const AST_FlatIndex *items;
+    switch ((AST_NodeType)node->kind) {
+      case ast_node_import:
+        _goc_parser_flat_dump_line(out, 2, "import", flat, AST_FLAT_NONE);
+        items = goc_parser_flat_list(flat, node->lhs, &s_items);
+        for (uint32_t import = 0; import < s_items; import++)
+          _goc_parser_flat_dump_line(out, 3, "path", flat, items[import]);
+        break;
+
+      case ast_node_enum: {
+        _goc_parser_flat_dump_line(out, 2, "enum", flat, node->token);
+        items = goc_parser_flat_list(flat, node->lhs, &s_items);
+        const AST_FlatIndex *assign = goc_parser_flat_list(flat, node->rhs, &s_items);
+        for (uint32_t value = 0; value < s_items; value++) {
+          _goc_parser_flat_dump_line(out, 3, "value", flat, items[value]);
+          _goc_parser_flat_dump_expr(out, 4, flat, assign[value]);
+        }
+        break;
+      }
+
+      case ast_node_union: case ast_node_struct:
+        _goc_parser_flat_dump_line(out, 2, node->kind == ast_node_union ? "union" : "struct", flat, node->token);
+        items = goc_parser_flat_list(flat, node->lhs, &s_items);
+        for (uint32_t field = 0; field < s_items; field++)
+          _goc_parser_flat_dump_var(out, 3, "field", flat, AST_FLAT_DECL, items[field]);
+        break;
+
+      case ast_node_interface:
+        _goc_parser_flat_dump_line(out, 2, "interface", flat, node->token);
+        items = goc_parser_flat_list(flat, node->lhs, &s_items);
+        for (uint32_t method = 0; method < s_items; method++)
+          _goc_parser_flat_dump_func_declare(out, 3, flat, items[method]);
+        break;
+
+      case ast_node_var:
+        _goc_parser_flat_dump_var(out, 2, node->op ? "const" : "var", flat, AST_FLAT_DECL, blocks[block]);
+        break;
+
+      case ast_node_method: {
+        const struct ast_flat_node *func = goc_parser_flat_node(flat, AST_FLAT_DECL, node->rhs);
+        _goc_parser_flat_dump_line(out, 2, "method", flat, AST_FLAT_NONE);
+        _goc_parser_flat_dump_var(out, 3, "receiver", flat, AST_FLAT_DECL, node->lhs);
+        _goc_parser_flat_dump_func_declare(out, 3, flat, func->lhs);
+        _goc_parser_flat_dump_block(out, 4, flat, func->rhs);
+        break;
+      }
+
+      case ast_node_func:
+        _goc_parser_flat_dump_func_declare(out, 2, flat, node->lhs);
+        _goc_parser_flat_dump_block(out, 3, flat, node->rhs);
+        break;
+
+      case ast_node_func_declare:
+        _goc_parser_flat_dump_func_declare(out, 2, flat, blocks[block]);
+        break;
+
+      case ast_node_error:
+        _goc_parser_flat_dump_line(out, 2, "error", flat, node->token);
+        break;
+
+      default:
+        goc_parser_flat_check(false);
+    }
+  }
+}
+
+// =========================================================# PRIVATE #================================================================
+
+// Each node is appended before its children are built: the pools can move while they are, so their indices are
+// kept in locals and stored once the children are done
+
+static AST_FlatIndex _goc_parser_flat_decl(struct parser_flat_builder *builder, AST_NodeType type, union ast_node_file_block block) {
+  AST_FlatIndex index, lhs = AST_FLAT_NONE, rhs = AST_FLAT_NONE;
+  switch (type) {
+    case ast_node_import:
+      index = _goc_parser_flat_node(builder, AST_FLAT_DECL, ast_node_import, 0, block.import->token);
+      lhs = _goc_parser_flat_list(builder, block.import->s_imports);
+      for (uint32_t import = 0; import < block.import->s_imports; import++)
+        builder->flat->extra[lhs + 1 + import] = _goc_parser_flat_token(block.import->imports[import]);
+      break;
+
+    case ast_node_enum:
+      index = _goc_parser_flat_node(builder, AST_FLAT_DECL, ast_node_enum, 0, block.node_enum->token);
+      lhs = _goc_parser_flat_list(builder, block.node_enum->s_values);
+      rhs = _goc_parser_flat_list(builder, block.node_enum->s_values);
+      for (uint32_t value = 0; value < block.node_enum->s_values; value++) {
+        builder->flat->extra[lhs + 1 + value] = _goc_parser_flat_token(block.node_enum->values[value]);
+        AST_FlatIndex assign = _goc_parser_flat_expr(builder, block.node_enum->assign[value]);
+        builder->flat->extra[rhs + 1 + value] = assign;
+      }
+      break;
+
+    case ast_node_union: case ast_node_struct: {
+      bool node_union = type == ast_node_union;
+      uint32_t s_fields = node_union ? block.node_union->s_fields : block.node_struct->s_fields;
+      AST_NodeVar fields = node_union ? block.node_union->fields : block.node_struct->fields;
+      index = _goc_parser_flat_node(builder, AST_FLAT_DECL, type, 0, node_union ? block.node_union->token : block.node_struct->token);
+      lhs = _goc_parser_flat_list(builder, s_fields);
+      for (uint32_t field = 0; field < s_fields; field++) {
+        AST_FlatIndex var = _goc_parser_flat_var(builder, AST_FLAT_DECL, &(fields[field]));
+        builder->flat->extra[lhs + 1 + field] = var;
+      }
+      break;
+    }
+
+    case ast_node_interface:
+      index = _goc_parser_flat_node(builder, AST_FLAT_DECL, ast_node_interface, 0, block.interface->token);
+      lhs = _goc_parser_flat_list(builder, block.interface->s_methods);
+      for (uint32_t method = 0; method < block.interface->s_methods; method++) {
+        AST_FlatIndex declare = _goc_parser_flat_func_declare(builder, &(block.interface->methods[method]));
+        builder->flat->extra[lhs + 1 + method] = declare;
+      }
+      break;
+
+    case ast_node_var:
+      return _goc_parser_flat_var(builder, AST_FLAT_DECL, block.var);
+
+    case ast_node_method:
+      index = _goc_parser_flat_node(builder, AST_FLAT_DECL, ast_node_method, 0, block.method->func->declare->func);
+      lhs = _goc_parser_flat_var(builder, AST_FLAT_DECL, &(block.method->receiver));
+      rhs = _goc_parser_flat_func(builder, block.method->func);
+      break;
+
+    case ast_node_func:
+      return _goc_parser_flat_func(builder, block.func);
+
+    case ast_node_func_declare:
+      return _goc_parser_flat_func_declare(builder, block.func_declare);
+
+    case ast_node_error:
+      index = _goc_parser_flat_node(builder, AST_FLAT_DECL, ast_node_error, 0, block.error->token);
+      lhs = block.error->s_tokens;
+      break;
+
+    default:
+      goc_parser_flat_check(false);
+      return AST_FLAT_NONE;
+  }
+  _goc_parser_flat_set(builder, AST_FLAT_DECL, index, lhs, rhs);
+  return index;
+}
+
+static AST_FlatIndex _goc_parser_flat_func(struct parser_flat_builder *builder, AST_NodeFunc func) {
+  AST_FlatIndex index = _goc_parser_flat_node(builder, AST_FLAT_DECL, ast_node_func, 0, func->declare->func);
+  AST_FlatIndex declare = _goc_parser_flat_func_declare(builder, func->declare);
+  _goc_parser_flat_set(builder, AST_FLAT_DECL, index, declare, _goc_parser_flat_block(builder, func->block));
+  return index;
+}
+
+static AST_FlatIndex _goc_parser_flat_func_declare(struct parser_flat_builder *builder, AST_NodeFuncDeclare declare) {
+  AST_FlatIndex index = _goc_parser_flat_node(builder, AST_FLAT_DECL, ast_node_func_declare, 0, declare->func);
+  AST_FlatIndex args = _goc_parser_flat_list(builder, declare->s_args);
+  for (uint32_t arg = 0; arg < declare->s_args; arg++) {
+    AST_FlatIndex var = _goc_parser_flat_var(builder, AST_FLAT_DECL, &(declare->args[arg]));
+    builder->flat->extra[args + 1 + arg] = var;
+  }
+  AST_FlatIndex types = _goc_parser_flat_list(builder, declare->s_return);
+  for (uint32_t type = 0; type < declare->s_return; type++) {
+    AST_FlatIndex type_return = _goc_parser_flat_type(builder, &(declare->type_return[type]));
+    builder->flat->extra[types + 1 + type] = type_return;
+  }
+  _goc_parser_flat_set(builder, AST_FLAT_DECL, index, args, types);
+  return index;
+}
+
+static AST_FlatIndex _goc_parser_flat_var(struct parser_flat_builder *builder, AST_FlatPool pool, AST_NodeVar var) {
+  AST_FlatIndex index = _goc_parser_flat_node(builder, pool, ast_node_var, (uint8_t)var->constant, var->token);
+  AST_FlatIndex type = _goc_parser_flat_type(builder, var->type_var);
+  _goc_parser_flat_set(builder, pool, index, type, _goc_parser_flat_expr(builder, var->value));
+  return index;
+}
+
+static AST_FlatIndex _goc_parser_flat_type(struct parser_flat_builder *builder, AST_NodeTypeIdent type) {
+  if (type == NULL)
+    return AST_FLAT_NONE;
+  AST_FlatIndex index = _goc_parser_flat_node(builder, AST_FLAT_TYPE, ast_node_type_ident, (uint8_t)type->type_go, type->token);
+  _goc_parser_flat_set(builder, AST_FLAT_TYPE, index, _goc_parser_flat_type(builder, type->elem), AST_FLAT_NONE);
+  return index;
+}
+
+static AST_FlatIndex _goc_parser_flat_block(struct parser_flat_builder *builder, AST_NodeStmtBlock block) {
+  if (block == NULL)
+    return AST_FLAT_NONE;
+  AST_FlatIndex index = _goc_parser_flat_node(builder, AST_FLAT_STMT, ast_node_stmt_block, 0, block->token);
+  AST_FlatIndex stmts = _goc_parser_flat_list(builder, block->s_stmts);
+  for (uint32_t stmt = 0; stmt < block->s_stmts; stmt++) {
+    AST_FlatIndex item = _goc_parser_flat_stmt(builder, &(block->stmts[stmt]));
+    builder->flat->extra[stmts + 1 + stmt] = item;
+  }
+  _goc_parser_flat_set(builder, AST_FLAT_STMT, index, stmts, AST_FLAT_NONE);
+  return index;
+}
+
+static AST_FlatIndex _goc_parser_flat_stmt(struct parser_flat_builder *builder, AST_NodeStmt stmt) {
+  if (stmt == NULL)
+    return AST_FLAT_NONE;
+
+  AST_FlatIndex index, lhs = AST_FLAT_NONE, rhs = AST_FLAT_NONE;
+  switch (stmt->type_stmt) {
+    case ast_node_stmt_expr:
+      index = _goc_parser_flat_node(builder, AST_FLAT_STMT, ast_node_stmt_expr, 0, (Token){ NULL, 0 });
+      lhs = _goc_parser_flat_expr(builder, stmt->stmt.expr);
+      break;
+
+    case ast_node_var:
+      return _goc_parser_flat_var(builder, AST_FLAT_STMT, &(stmt->stmt.var));
+
+    case ast_node_stmt_assign: {
+      struct ast_node_stmt_assign *assign = &(stmt->stmt.stmt_assign);
+      index = _goc_parser_flat_node(builder, AST_FLAT_STMT, ast_node_stmt_assign, (uint8_t)assign->assign_operator, assign->token);
+      lhs = _goc_parser_flat_expr(builder, assign->target);
+      rhs = _goc_parser_flat_expr(builder, assign->expr);
+      break;
+    }
+
+    case ast_node_stmt_return: {
+      struct ast_node_stmt_return *stmt_return = &(stmt->stmt.stmt_return);
+      index = _goc_parser_flat_node(builder, AST_FLAT_STMT, ast_node_stmt_return, 0, stmt_return->token);
+      lhs = _goc_parser_flat_list(builder, stmt_return->s_exprs);
+      for (uint32_t expr = 0; expr < stmt_return->s_exprs; expr++) {
+        AST_FlatIndex item = _goc_parser_flat_expr(builder, stmt_return->exprs[expr]);
+        builder->flat->extra[lhs + 1 + expr] = item;
+      }
+      break;
+    }
+
+    case ast_node_stmt_if:
+      return _goc_parser_flat_stmt_if(builder, stmt->stmt.stmt_if);
+
+    case ast_node_stmt_while: {
+      struct ast_node_stmt_while *stmt_while = &(stmt->stmt.stmt_while);
+      index = _goc_parser_flat_node(builder, AST_FLAT_STMT, ast_node_stmt_while, (uint8_t)stmt_while->do_while, stmt_while->token);
+      // do {...} while condition has its block first
+      if (stmt_while->do_while) {
+        rhs = _goc_parser_flat_block(builder, stmt_while->block);
+        lhs = _goc_parser_flat_expr(builder, stmt_while->condition);
+      } else {
+        lhs = _goc_parser_flat_expr(builder, stmt_while->condition);
+        rhs = _goc_parser_flat_block(builder, stmt_while->block);
+      }
+      break;
+    }
+
+    // The extra slots are init, update, condition, range, block, s_iterators and the two iterators, built in
+    // source order
+    case ast_node_stmt_for: {
+      struct ast_node_stmt_for *stmt_for = &(stmt->stmt.stmt_for);
+      index = _goc_parser_flat_node(builder, AST_FLAT_STMT, ast_node_stmt_for, (uint8_t)stmt_for->declare, stmt_for->token);
+      lhs = _goc_parser_flat_extra(builder, 8);
+      AST_FlatIndex init      = _goc_parser_flat_stmt(builder, stmt_for->init),
+                    condition = _goc_parser_flat_expr(builder, stmt_for->condition),
+                    update    = _goc_parser_flat_stmt(builder, stmt_for->update),
+                    range     = _goc_parser_flat_expr(builder, stmt_for->range),
+                    block     = _goc_parser_flat_block(builder, stmt_for->block);
+      AST_FlatIndex *slots = &(builder->flat->extra[lhs]);
+      slots[0] = init;
+      slots[1] = update;
+      slots[2] = condition;
+      slots[3] = range;
+      slots[4] = block;
+      slots[5] = stmt_for->s_iterators;
+      for (uint32_t iterator = 0; iterator < stmt_for->s_iterators; iterator++)
+        slots[6 + iterator] = _goc_parser_flat_token(stmt_for->iterators[iterator]);
+      break;
+    }
+
+    case ast_node_stmt_block:
+      return _goc_parser_flat_block(builder, stmt->stmt.stmt_block);
+
+    case ast_node_error:
+      index = _goc_parser_flat_node(builder, AST_FLAT_STMT, ast_node_error, 0, stmt->stmt.error.token);
+      lhs = stmt->stmt.error.s_tokens;
+      break;
+
+    default:
+      goc_parser_flat_check(false);
+      return AST_FLAT_NONE;
+  }
+  _goc_parser_flat_set(builder, AST_FLAT_STMT, index, lhs, rhs);
+  return index;
+}
+
+// The extra slots are init, block, else if and else block. An else if chain is walked in a loop, each if is linked
+// from the previous one's slot once flattened.
+static AST_FlatIndex _goc_parser_flat_stmt_if(struct parser_flat_builder *builder, AST_NodeStmtIf stmt_if) {
+  AST_FlatIndex first = AST_FLAT_NONE, previous = AST_FLAT_NONE;
+  for (; stmt_if != NULL; stmt_if = stmt_if->elseif) {
+    AST_FlatIndex index = _goc_parser_flat_node(builder, AST_FLAT_STMT, ast_node_stmt_if, 0, stmt_if->token);
+    AST_FlatIndex rhs = _goc_parser_flat_extra(builder, 4);
+    AST_FlatIndex init       = _goc_parser_flat_stmt(builder, stmt_if->init),
+                  condition  = _goc_parser_flat_expr(builder, stmt_if->condition),
+                  if_block   = _goc_parser_flat_block(builder, stmt_if->if_block),
+                  else_block = _goc_parser_flat_block(builder, stmt_if->else_block);
+    AST_FlatIndex *slots = &(builder->flat->extra[rhs]);
+    slots[0] = init;
+    slots[1] = if_block;
+    slots[2] = AST_FLAT_NONE;
+    slots[3] = else_block;
+    _goc_parser_flat_set(builder, AST_FLAT_STMT, index, condition, rhs);
+    if (previous == AST_FLAT_NONE)
+      first = index;
+    else
+      builder->flat->extra[previous + 2] = index;
+    previous = rhs;
+  }
+  return first;
+}
+
+static AST_FlatIndex _goc_parser_flat_expr(struct parser_flat_builder *builder, AST_NodeExpr expr) {
+  if (expr == NULL)
+    return AST_FLAT_NONE;
+
+  AST_FlatIndex index, lhs = AST_FLAT_NONE, rhs = AST_FLAT_NONE;
+  switch (expr->type_expr) {
+    case ast_token:
+      return _goc_parser_flat_node(builder, AST_FLAT_EXPR, ast_token, 0, expr->expr.token);
+
+    case ast_node_literal:
+      index = _goc_parser_flat_node(builder, AST_FLAT_EXPR, ast_node_literal, (uint8_t)expr->expr.literal.type_go, expr->expr.literal.token);
+      lhs = _goc_parser_flat_literal(builder, expr->expr.literal);
+      break;
+
+    case ast_node_expr_member:
+      index = _goc_parser_flat_node(builder, AST_FLAT_EXPR, ast_node_expr_member, 0, expr->expr.expr_member.member);
+      lhs = _goc_parser_flat_expr(builder, expr->expr.expr_member.object);
+      break;
+
+    case ast_node_expr_index:
+      index = _goc_parser_flat_node(builder, AST_FLAT_EXPR, ast_node_expr_index, 0, expr->expr.expr_index.token);
+      lhs = _goc_parser_flat_expr(builder, expr->expr.expr_index.object);
+      rhs = _goc_parser_flat_expr(builder, expr->expr.expr_index.index);
+      break;
+
+    case ast_node_expr_call: {
+      struct ast_node_expr_call *call = &(expr->expr.expr_call);
+      index = _goc_parser_flat_node(builder, AST_FLAT_EXPR, ast_node_expr_call, 0, call->token);
+      lhs = _goc_parser_flat_expr(builder, call->callee);
+      rhs = _goc_parser_flat_list(builder, call->s_args);
+      for (uint32_t arg = 0; arg < call->s_args; arg++) {
+        AST_FlatIndex item = _goc_parser_flat_expr(builder, call->args[arg]);
+        builder->flat->extra[rhs + 1 + arg] = item;
+      }
+      break;
+    }
+
+    case ast_node_expr_unary:
+      index = _goc_parser_flat_node(
+        builder, AST_FLAT_EXPR, ast_node_expr_unary, (uint8_t)expr->expr.expr_unary.unary_operator, expr->expr.expr_unary.token
+      );
+      lhs = _goc_parser_flat_expr(builder, expr->expr.expr_unary.operand);
+      break;
+
+    case ast_node_expr_bin:
+      index = _goc_parser_flat_node(
+        builder, AST_FLAT_EXPR, ast_node_expr_bin, (uint8_t)expr->expr.expr_bin.expr_operator, expr->expr.expr_bin.token
+      );
+      lhs = _goc_parser_flat_expr(builder, expr->expr.expr_bin.expr_left);
+      rhs = _goc_parser_flat_expr(builder, expr->expr.expr_bin.expr_right);
+      break;
+
+    default:
+      goc_parser_flat_check(false);
+      return AST_FLAT_NONE;
+  }
+  _goc_parser_flat_set(builder, AST_FLAT_EXPR, index, lhs, rhs);
+  return index;
+}
+
+static AST_FlatIndex _goc_parser_flat_literal(struct parser_flat_builder *builder, struct ast_node_literal literal) {
+  AST_Flat flat = builder->flat;
+  if (flat->s_literals == builder->s_literals_capacity)
+    flat->literals = _goc_parser_flat_grow(flat->literals, &(builder->s_literals_capacity), sizeof(union ast_flat_literal));
+
+  union ast_flat_literal value = { 0 };
+  switch (literal.type_go) {
+    case TG_INT64:  value.val_int64 = literal.literal.val_int64;   break;
+    case TG_DOUBLE: value.val_double = literal.literal.val_double; break;
+    case TG_BOOL:   value.val_bool = literal.literal.val_bool;     break;
+    case TG_STRING: value.val_string = literal.literal.val_string; break;
+    default:        break;
+  }
+  flat->literals[flat->s_literals] = value;
+  return flat->s_literals++;
+}
+
+// Arrays
+
+static AST_FlatIndex _goc_parser_flat_node(struct parser_flat_builder *builder, AST_FlatPool pool, AST_NodeType kind, uint8_t op, Token token) {
+  AST_Flat flat = builder->flat;
+  if (flat->s_pools[pool] == builder->s_pools_capacity[pool])
+    flat->pools[pool] = _goc_parser_flat_grow(flat->pools[pool], &(builder->s_pools_capacity[pool]), sizeof(struct ast_flat_node));
+  flat->pools[pool][flat->s_pools[pool]] = (struct ast_flat_node){
+    (uint8_t)kind, op, _goc_parser_flat_token(token), AST_FLAT_NONE, AST_FLAT_NONE
+  };
+  return flat->s_pools[pool]++;
+}
+
+static void _goc_parser_flat_set(struct parser_flat_builder *builder, AST_FlatPool pool, AST_FlatIndex index, AST_FlatIndex lhs, AST_FlatIndex rhs) {
+  struct ast_flat_node *node = &(builder->flat->pools[pool][index]);
+  node->lhs = lhs;
+  node->rhs = rhs;
+}
+
+// s_slots slots of extra, set to AST_FLAT_NONE
+static AST_FlatIndex _goc_parser_flat_extra(struct parser_flat_builder *builder, uint32_t s_slots) {
+  AST_Flat flat = builder->flat;
+  while (flat->s_extra + s_slots > builder->s_extra_capacity)
+    flat->extra = _goc_parser_flat_grow(flat->extra, &(builder->s_extra_capacity), sizeof(AST_FlatIndex));
+  AST_FlatIndex offset = flat->s_extra;
+  for (uint32_t slot = 0; slot < s_slots; slot++)
+    flat->extra[offset + slot] = AST_FLAT_NONE;
+  flat->s_extra += s_slots;
+  return offset;
+}
+
+static AST_FlatIndex _goc_parser_flat_list(struct parser_flat_builder *builder, uint32_t s_items) {
+  AST_FlatIndex list = _goc_parser_flat_extra(builder, s_items + 1);
+  builder->flat->extra[list] = s_items;
+  return list;
+}
+
+static void *_goc_parser_flat_grow(void *items, uint32_t *s_capacity, size_t s_item) {
+  *s_capacity = *s_capacity ? 2 * *s_capacity : parser_flat_size_init;
+  items = realloc(items, (size_t)*s_capacity * s_item);
+  goc_error_assert(goc_error_mem_error, items != NULL);
+  return items;
+}
+
+static inline uint32_t _goc_parser_flat_token(Token token) {
+  return token.array != NULL ? (uint32_t)token.index : AST_FLAT_NONE;
+}
+
+// Dump, line for line the one of goc_parser_dump
+
+static void _goc_parser_flat_dump_line(FILE *out, uint32_t depth, const char *label, AST_Flat flat, uint32_t token) {
+  fprintf(out, "%*s%s", (int)(2 * depth), "", label);
+  if (token != AST_FLAT_NONE) {
+    TokenText text = goc_lexer_token_get_value_text(goc_parser_flat_token(flat, token));
+    fprintf(out, " %.*s", (int)text.s_text, text.text);
+  }
+  fputc('\n', out);
+}
+
+static void _goc_parser_flat_dump_type(FILE *out, uint32_t depth, const char *label, AST_Flat flat, AST_FlatIndex type) {
+  if (type == AST_FLAT_NONE)
+    return;
+  fprintf(out, "%*s%s ", (int)(2 * depth), "", label);
+  const struct ast_flat_node *node = goc_parser_flat_node(flat, AST_FLAT_TYPE, type);
+  for (; node->lhs != AST_FLAT_NONE; node = goc_parser_flat_node(flat, AST_FLAT_TYPE, node->lhs))
+    fputs(node->op == TG_POINTER ? "*" : "[]", out);
+  TokenText text = goc_lexer_token_get_value_text(goc_parser_flat_token(flat, node->token));
+  fprintf(out, "%.*s\n", (int)text.s_text, text.text);
+}
+
+static void _goc_parser_flat_dump_var(FILE *out, uint32_t depth, const char *label, AST_Flat flat, AST_FlatPool pool, AST_FlatIndex var) {
+  const struct ast_flat_node *node = goc_parser_flat_node(flat, pool, var);
+  _goc_parser_flat_dump_line(out, depth, label, flat, node->token);
+  _goc_parser_flat_dump_type(out, depth + 1, "type", flat, node->lhs);
+  _goc_parser_flat_dump_expr(out, depth + 1, flat, node->rhs);
+}
+
+static void _goc_parser_flat_dump_func_declare(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex declare) {
+  const struct ast_flat_node *node = goc_parser_flat_node(flat, AST_FLAT_DECL, declare);
+  _goc_parser_flat_dump_line(out, depth, "func", flat, node->token);
+  uint32_t s_items;
+  const AST_FlatIndex *items = goc_parser_flat_list(flat, node->lhs, &s_items);
+  for (uint32_t arg = 0; arg < s_items; arg++)
+    _goc_parser_flat_dump_var(out, depth + 1, "arg", flat, AST_FLAT_DECL, items[arg]);
+  items = goc_parser_flat_list(flat, node->rhs, &s_items);
+  for (uint32_t type = 0; type < s_items; type++)
+    _goc_parser_flat_dump_type(out, depth + 1, "return", flat, items[type]);
+}
+
+static void _goc_parser_flat_dump_block(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex block) {
+  if (block == AST_FLAT_NONE)
+    return;
+  _goc_parser_flat_dump_line(out, depth, "block", flat, AST_FLAT_NONE);
+  uint32_t s_stmts;
+  const AST_FlatIndex *stmts = goc_parser_flat_list(flat, goc_parser_flat_node(flat, AST_FLAT_STMT, block)->lhs, &s_stmts);
+  for (uint32_t stmt = 0; stmt < s_stmts; stmt++)
+    _goc_parser_flat_dump_stmt(out, depth + 1, flat, stmts[stmt]);
+}
+
+static void _goc_parser_flat_dump_stmt(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex stmt) {
+  const struct ast_flat_node *node = goc_parser_flat_node(flat, AST_FLAT_STMT, stmt);
+  switch ((AST_NodeType)node->kind) {
+    case ast_node_stmt_expr:
+      _goc_parser_flat_dump_expr(out, depth, flat, node->lhs);
+      break;
+
+    case ast_node_var:
+      _goc_parser_flat_dump_var(out, depth, node->op ? "const" : "var", flat, AST_FLAT_STMT, stmt);
+      break;
+
+    case ast_node_stmt_assign:
+      _goc_parser_flat_dump_line(out, depth, "assign", flat, node->token);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->lhs);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->rhs);
+      break;
+
+    case ast_node_stmt_return: {
+      _goc_parser_flat_dump_line(out, depth, "return", flat, AST_FLAT_NONE);
+      uint32_t s_exprs;
+      const AST_FlatIndex *exprs = goc_parser_flat_list(flat, node->lhs, &s_exprs);
+      for (uint32_t expr = 0; expr < s_exprs; expr++)
+        _goc_parser_flat_dump_expr(out, depth + 1, flat, exprs[expr]);
+      break;
+    }
+
+    case ast_node_stmt_if:
+      _goc_parser_flat_dump_stmt_if(out, depth, flat, stmt);
+      break;
+
+    case ast_node_stmt_while:
+      _goc_parser_flat_dump_line(out, depth, node->op ? "do while" : "while", flat, AST_FLAT_NONE);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->lhs);
+      _goc_parser_flat_dump_block(out, depth + 1, flat, node->rhs);
+      break;
+
+    case ast_node_stmt_for: {
+      const AST_FlatIndex *slots = &(flat->extra[node->lhs]);
+      _goc_parser_flat_dump_line(out, depth, slots[3] != AST_FLAT_NONE ? "for range" : "for", flat, AST_FLAT_NONE);
+      for (uint32_t iterator = 0; iterator < slots[5]; iterator++)
+        _goc_parser_flat_dump_line(out, depth + 1, node->op ? "declare" : "iterator", flat, slots[6 + iterator]);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, slots[3]);
+      if (slots[0] != AST_FLAT_NONE) {
+        _goc_parser_flat_dump_line(out, depth + 1, "init", flat, AST_FLAT_NONE);
+        _goc_parser_flat_dump_stmt(out, depth + 2, flat, slots[0]);
+      }
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, slots[2]);
+      if (slots[1] != AST_FLAT_NONE) {
+        _goc_parser_flat_dump_line(out, depth + 1, "update", flat, AST_FLAT_NONE);
+        _goc_parser_flat_dump_stmt(out, depth + 2, flat, slots[1]);
+      }
+      _goc_parser_flat_dump_block(out, depth + 1, flat, slots[4]);
+      break;
+    }
+
+    case ast_node_stmt_block:
+      _goc_parser_flat_dump_block(out, depth, flat, stmt);
+      break;
+
+    case ast_node_error:
+      _goc_parser_flat_dump_line(out, depth, "error", flat, node->token);
+      break;
+
+    default:
+      goc_parser_flat_check(false);
+  }
+}
+
+static void _goc_parser_flat_dump_stmt_if(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex stmt_if) {
+  for (const char *label = "if"; stmt_if != AST_FLAT_NONE; label = "else if") {
+    const struct ast_flat_node *node = goc_parser_flat_node(flat, AST_FLAT_STMT, stmt_if);
+    const AST_FlatIndex *slots = &(flat->extra[node->rhs]);
+    _goc_parser_flat_dump_line(out, depth, label, flat, AST_FLAT_NONE);
+    if (slots[0] != AST_FLAT_NONE) {
+      _goc_parser_flat_dump_line(out, depth + 1, "init", flat, AST_FLAT_NONE);
+      _goc_parser_flat_dump_stmt(out, depth + 2, flat, slots[0]);
+    }
+    _goc_parser_flat_dump_expr(out, depth + 1, flat, node->lhs);
+    _goc_parser_flat_dump_block(out, depth + 1, flat, slots[1]);
+    if (slots[3] != AST_FLAT_NONE) {
+      _goc_parser_flat_dump_line(out, depth, "else", flat, AST_FLAT_NONE);
+      _goc_parser_flat_dump_block(out, depth + 1, flat, slots[3]);
+    }
+    stmt_if = slots[2];
+  }
+}
+
+static void _goc_parser_flat_dump_expr(FILE *out, uint32_t depth, AST_Flat flat, AST_FlatIndex expr) {
+  if (expr == AST_FLAT_NONE)
+    return;
+  const struct ast_flat_node *node = goc_parser_flat_node(flat, AST_FLAT_EXPR, expr);
+  switch ((AST_NodeType)node->kind) {
+    case ast_token:
+      _goc_parser_flat_dump_line(out, depth, "ident", flat, node->token);
+      break;
+    case ast_node_literal:
+      _goc_parser_flat_dump_line(out, depth, "literal", flat, node->token);
+      break;
+    case ast_node_expr_member:
+      _goc_parser_flat_dump_line(out, depth, "member", flat, node->token);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->lhs);
+      break;
+    case ast_node_expr_index:
+      _goc_parser_flat_dump_line(out, depth, "index", flat, AST_FLAT_NONE);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->lhs);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->rhs);
+      break;
+    case ast_node_expr_call: {
+      _goc_parser_flat_dump_line(out, depth, "call", flat, AST_FLAT_NONE);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->lhs);
+      uint32_t s_args;
+      const AST_FlatIndex *args = goc_parser_flat_list(flat, node->rhs, &s_args);
+      for (uint32_t arg = 0; arg < s_args; arg++)
+        _goc_parser_flat_dump_expr(out, depth + 1, flat, args[arg]);
+      break;
+    }
+    case ast_node_expr_unary:
+      _goc_parser_flat_dump_line(out, depth, "unary", flat, node->token);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->lhs);
+      break;
+    case ast_node_expr_bin:
+      _goc_parser_flat_dump_line(out, depth, "binary", flat, node->token);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->lhs);
+      _goc_parser_flat_dump_expr(out, depth + 1, flat, node->rhs);
+      break;
+    default:
+      goc_parser_flat_check(false);
+  }
+}
@@ -1,10 +1,24 @@
 #include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "goc_error.h"
+#include "goc_diagnostic_sink.h"
 #include "goc_lexer.h"
-// #include "goc_parser.h"
+#include "goc_lexer_dump.h"
+#include "goc_parser.h"
+#include "goc_parser_flat.h"
 
-#define GOC_GO_FILE ".go"
+#define GOC_GO_FILE     ".go"
+#define GOC_STDIN       "-"
+#define GOC_FORMAT_FLAG      "--format"
+#define GOC_DIAGNOSTICS_FLAG "--diagnostics"
+#define GOC_AST_FLAG         "--ast"
+#define GOC_AST_FLAT_FLAG    "--ast-flat"
+#define GOC_STDIN_PATH       "/dev/stdin"
+
+// usage: repo [--format text|ndjson|binary] [--diagnostics text|jsonl|sarif] [--ast | --ast-flat] [file.go | -]
+// --ast parses the source and prints its AST instead of its tokens, --ast-flat prints the same tree from its flat form
 
 bool goc_go_file(const char *file_name) {
   goc_error_assert(goc_error_nullptr, file_name != NULL);
@@ -14,21 +28,120 @@ bool goc_go_file(const char *file_name) {
   return strcmp(file_name + len - strlen(GOC_GO_FILE), GOC_GO_FILE) == 0;
 }
 
-int main(int argc, char *argv[]) {
-  goc_error_assert(goc_error_inval_arg, argc <= 2);
-  goc_error_assert(goc_error_nullptr, argv[1] != NULL);
+LexerDumpFormat goc_dump_format(const char *name) {
+  goc_error_assert(goc_error_nullptr, name != NULL);
+  if (strcmp(name, "ndjson") == 0)
+    return LEXER_DUMP_NDJSON;
+  if (strcmp(name, "binary") == 0)
+    return LEXER_DUMP_BINARY;
+  goc_error_assert(goc_error_inval_arg, strcmp(name, "text") == 0);
+  return LEXER_DUMP_TEXT;
+}
+
+DiagnosticFormat goc_diagnostic_format(const char *name) {
+  goc_error_assert(goc_error_nullptr, name != NULL);
+  if (strcmp(name, "jsonl") == 0)
+    return DIAGNOSTIC_JSONL;
+  if (strcmp(name, "sarif") == 0)
+    return DIAGNOSTIC_SARIF;
+  goc_error_assert(goc_error_inval_arg, strcmp(name, "text") == 0);
+  return DIAGNOSTIC_TEXT;
+}
 
-  const char *file_name = argv[1];
-  goc_error_assert(goc_error_nullptr, goc_go_file(file_name) == true);
+// Writes every diagnostic to stderr in one batch, returns how many there were
+size_t goc_report(Diagnostics diagnostics, DiagnosticFormat format) {
+  DiagnosticSink sink = goc_diagnostic_sink_create(STDERR_FILENO, format);
+  goc_error_assert(goc_error_nullptr, sink != NULL);
+  goc_diagnostic_sink_emit_all(sink, diagnostics);
+  goc_diagnostic_sink_free(sink);
+  return goc_diagnostics_get_count(diagnostics);
+}
 
-  TokenArray tokens = goc_lexer(file_name);
+// The parser needs the whole TokenArray, lexing errors are reported before it runs and stop there, syntax errors
+// are all reported at once and stop before the dump
+int goc_parse(const char *file_name, DiagnosticFormat diagnostic_format, bool flat) {
+  TokenArray tokens = goc_lexer(strcmp(file_name, GOC_STDIN) == 0 ? GOC_STDIN_PATH : file_name);
   goc_error_assert(goc_error_nullptr, tokens != NULL);
+  if (goc_report(goc_lexer_token_array_get_diagnostics(tokens), diagnostic_format) > 0) {
+    goc_lexer_token_array_free(tokens);
+    return goc_error_lexer_invalid_syntax;
+  }
+
+  AST_NodeProgram program = goc_parser_parallel(tokens, 0);
+  if (goc_report(goc_parser_get_diagnostics(program), diagnostic_format) > 0) {
+    goc_parser_free(program);
+    goc_lexer_token_array_free(tokens);
+    return goc_error_parser_syntax_error;
+  }
+  if (flat) {
+    AST_Flat ast_flat = goc_parser_flatten(program);
+    goc_parser_free(program);
+    goc_parser_flat_dump(stdout, ast_flat);
+    goc_parser_flat_free(ast_flat);
+  } else {
+    goc_parser_dump(stdout, program);
+    goc_parser_free(program);
+  }
+  goc_lexer_token_array_free(tokens);
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  LexerDumpFormat format = LEXER_DUMP_TEXT;
+  DiagnosticFormat diagnostic_format = DIAGNOSTIC_TEXT;
+  const char *file_name = NULL;
+  bool ast = false,
+       ast_flat = false;
+  for (int arg = 1; arg < argc; arg++) {
+    if (strcmp(argv[arg], GOC_FORMAT_FLAG) == 0) {
+      goc_error_assert(goc_error_inval_arg, arg + 1 < argc);
+      format = goc_dump_format(argv[++arg]);
+    } else if (strcmp(argv[arg], GOC_DIAGNOSTICS_FLAG) == 0) {
+      goc_error_assert(goc_error_inval_arg, arg + 1 < argc);
+      diagnostic_format = goc_diagnostic_format(argv[++arg]);
+    } else if (strcmp(argv[arg], GOC_AST_FLAG) == 0) {
+      ast = true;
+    } else if (strcmp(argv[arg], GOC_AST_FLAT_FLAG) == 0) {
+      ast = ast_flat = true;
+    } else {
+      goc_error_assert(goc_error_inval_arg, file_name == NULL);
+      file_name = argv[arg];
+    }
+  }
 
-  fprintf(stdout, "File %s:\n", file_name);
+  // No file, or "-", reads the source from stdin
+  if (file_name == NULL)
+    file_name = GOC_STDIN;
+  if (strcmp(file_name, GOC_STDIN) != 0)
+    goc_error_assert(goc_error_nullptr, goc_go_file(file_name) == true);
+  if (ast)
+    return goc_parse(file_name, diagnostic_format, ast_flat);
 
-  size_t s_tokens = goc_lexer_token_array_get_size(tokens);
-  for (size_t i = 0; i < s_tokens; i++)
-    fprintf(stdout, "%s\n", goc_lexer_token_to_str(goc_lexer_token_array_at(tokens, i)));
+  int fd = STDIN_FILENO;
+  if (strcmp(file_name, GOC_STDIN) != 0) {
+    fd = open(file_name, O_RDONLY);
+    if (fd == -1)
+      goc_error_lexer_print_input_file(file_name);
+  }
 
-  return 0;
+  // Tokens are dumped as they are lexed, memory does not grow with the input
+  LexerStream stream = goc_lexer_open(fd, file_name);
+  LexerDump dump = goc_lexer_dump_create(STDOUT_FILENO, format);
+  goc_error_assert(goc_error_nullptr, stream != NULL && dump != NULL);
+
+  for (TokenType type = TT_BEGIN; type != TT_EOF; ) {
+    Token token = goc_lexer_next(stream);
+    type = goc_lexer_token_get_token_type(token);
+    goc_lexer_dump_token(dump, token);
+  }
+
+  goc_lexer_dump_free(dump);
+
+  // Every lexing error is reported once the whole input has been read, in one write
+  size_t s_errors = goc_report(goc_lexer_stream_get_diagnostics(stream), diagnostic_format);
+
+  goc_lexer_close(stream);
+  if (fd != STDIN_FILENO)
+    close(fd);
+  return s_errors > 0 ? goc_error_lexer_invalid_syntax : 0;
 }
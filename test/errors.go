@@ -0,0 +1,52 @@
+package main
+
+// Malformed on purpose, for the parser's error recovery. goc --ast test/errors.go reports these in one run, the
+// first error of a line only, and stops at the tenth (after_cap is not reached). goc_parser_parallel falls back to
+// goc_parser on errors and reports the same, goc_parser_lazy adds those of a body when it is expanded.
+//
+//   20 Expected ')'            unclosed_paren, the if block still parses
+//   30 Expected '}'            unclosed_block, the next func ends it
+//   31 Expected an expression  bad_expr
+//   32 Expected an expression
+//   38 Expected ':'            point, the struct goes on with the next field
+//   42 Expected an expression  many
+//   43 Expected an expression
+//   44 Expected an expression
+//   45 Expected an identifier
+//   46 Expected an expression
+//   46 Too many errors, parsing stopped
+
+func unclosed_paren(a: int) -> int {
+  if (a > 0 {
+    return a
+  }
+  return 0
+}
+
+func unclosed_block(a: int) {
+  for _, x range a {
+    a += x
+
+func bad_expr() -> int {
+  y := (1 + / 2)
+  z := y[3 + ]
+  return y
+}
+
+struct point {
+  var x: int,
+  var y int
+}
+
+func many() {
+  a := )
+  b := ]
+  c := ,
+  var = 1
+  d := a +* / b
+  e := sum(a, , b)
+}
+
+func after_cap() {
+  f := )
+}